@@ -0,0 +1,325 @@
+#ifndef SLANG_REFLECTION_BINARY_H
+#define SLANG_REFLECTION_BINARY_H
+
+/** \file slang-reflection-binary.h
+
+Layout of the binary reflection format written by `slangc -reflection-binary <path>`, together
+with a small header-only reader for it.
+
+The format is designed to be memory mapped and used in place, without any parsing step:
+
+* All data is stored in flat arrays ("sections") of plain 4 byte aligned structures.
+* Types, type layouts, variables and variable layouts are interned, so each one is stored once
+  no matter how often it is referenced. References between items are indices into the
+  corresponding section (or `kNullIndex`).
+* Variable length lists (fields, parameters, bindings, etc.) are stored as a `(begin, count)`
+  range into a shared section.
+* Strings are byte offsets into a pool of zero terminated UTF-8 strings.
+
+Values are stored in little endian byte order.
+*/
+
+#include "slang.h"
+
+#include <string.h>
+
+namespace slang
+{
+namespace reflection_binary
+{
+
+typedef uint32_t Index;
+typedef uint32_t StringOffset;
+
+static const Index kNullIndex = 0xffffffff;
+
+/// Value stored for sizes and counts that are unbounded (i.e. `SLANG_UNBOUNDED_SIZE`)
+static const uint32_t kUnboundedSize = 0xffffffff;
+
+static const uint32_t kMagic = 0x42465253; // 'SRFB'
+static const uint32_t kVersion = 1;
+
+enum class SectionKind : uint32_t
+{
+    Strings,          ///< char
+    Types,            ///< Type
+    TypeLayouts,      ///< TypeLayout
+    Variables,        ///< Variable
+    VariableLayouts,  ///< VariableLayout
+    EntryPoints,      ///< EntryPoint
+    Bindings,         ///< Binding, ranges referenced from VariableLayout
+    CategorySizes,    ///< CategorySize, ranges referenced from TypeLayout
+    Indices,          ///< Index, ranges referenced from all other items
+    CountOf,
+};
+
+struct Section
+{
+    uint32_t offset; ///< Offset in bytes from the start of the data
+    uint32_t count;  ///< Number of elements
+};
+
+/// A range of elements in a section
+struct Range
+{
+    uint32_t begin;
+    uint32_t count;
+};
+
+struct Header
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t totalSize;
+    Section sections[uint32_t(SectionKind::CountOf)];
+
+    /// Global shader parameters, a range in `Indices` of `VariableLayout` indices
+    Range globalParams;
+    /// The `VariableLayout` for the global scope, or kNullIndex
+    Index globalParamsVarLayout;
+};
+
+struct Type
+{
+    uint32_t kind; ///< slang::TypeReflection::Kind
+    StringOffset name;
+    uint32_t scalarType; ///< slang::TypeReflection::ScalarType
+    uint32_t rowCount;
+    uint32_t columnCount;
+    uint32_t elementCount;   ///< For arrays and vectors, may be kUnboundedSize
+    Index elementType;       ///< Type
+    uint32_t resourceShape;  ///< SlangResourceShape
+    uint32_t resourceAccess; ///< SlangResourceAccess
+    Index resourceResultType; ///< Type
+    Range fields;            ///< Range in `Indices` of `Variable` indices
+};
+
+/// The size of a type layout in one parameter category
+struct CategorySize
+{
+    uint32_t category; ///< slang::ParameterCategory
+    uint32_t size;     ///< May be kUnboundedSize
+};
+
+struct TypeLayout
+{
+    Index type; ///< Type
+    uint32_t kind; ///< slang::TypeReflection::Kind of the layout
+    uint32_t parameterCategory; ///< slang::ParameterCategory
+    uint32_t uniformAlignment;
+    uint32_t uniformStride;
+    Range sizes;               ///< Range in `CategorySizes`
+    Index elementTypeLayout;   ///< TypeLayout
+    Index elementVarLayout;    ///< VariableLayout, for parameter groups
+    Index containerVarLayout;  ///< VariableLayout, for parameter groups
+    Range fields;              ///< Range in `Indices` of `VariableLayout` indices
+};
+
+struct Variable
+{
+    StringOffset name;
+    Index type; ///< Type
+};
+
+/// The offset of a variable layout in one parameter category
+struct Binding
+{
+    uint32_t category; ///< slang::ParameterCategory
+    uint32_t offset;
+    uint32_t space;
+    uint32_t reserved;
+};
+
+struct VariableLayout
+{
+    Index variable;   ///< Variable
+    Index typeLayout; ///< TypeLayout
+    uint32_t stage;   ///< SlangStage
+    StringOffset semanticName;
+    uint32_t semanticIndex;
+    Range bindings; ///< Range in `Bindings`
+};
+
+struct EntryPoint
+{
+    StringOffset name;
+    uint32_t stage; ///< SlangStage
+    uint32_t threadGroupSize[3];
+    Range params;           ///< Range in `Indices` of `VariableLayout` indices
+    Index resultVarLayout;  ///< VariableLayout
+    Index varLayout;        ///< VariableLayout
+};
+
+/// Provides typed, bounds checked access to binary reflection data in memory.
+///
+/// The reader doesn't copy or own the data, which must stay valid (e.g. mapped) for as long as
+/// the reader, or anything returned from it, is used.
+class Reader
+{
+public:
+    /// Initialize from data, which must be aligned for `Header`. Validates the header and that
+    /// all sections are in range and aligned for their elements.
+    SlangResult init(const void* data, size_t size)
+    {
+        m_data = (const char*)data;
+        m_header = nullptr;
+
+        if (size < sizeof(Header) || uintptr_t(data) % alignof(Header) != 0)
+            return SLANG_E_INVALID_ARG;
+
+        const Header* header = (const Header*)data;
+        if (header->magic != kMagic)
+            return SLANG_E_INVALID_ARG;
+        if (header->version != kVersion)
+            return SLANG_E_NOT_AVAILABLE;
+        if (header->totalSize > size)
+            return SLANG_E_INVALID_ARG;
+
+        static const size_t kElementSizes[] = {
+            sizeof(char),
+            sizeof(Type),
+            sizeof(TypeLayout),
+            sizeof(Variable),
+            sizeof(VariableLayout),
+            sizeof(EntryPoint),
+            sizeof(Binding),
+            sizeof(CategorySize),
+            sizeof(Index),
+        };
+        static const size_t kElementAlignments[] = {
+            alignof(char),
+            alignof(Type),
+            alignof(TypeLayout),
+            alignof(Variable),
+            alignof(VariableLayout),
+            alignof(EntryPoint),
+            alignof(Binding),
+            alignof(CategorySize),
+            alignof(Index),
+        };
+        for (uint32_t i = 0; i < uint32_t(SectionKind::CountOf); ++i)
+        {
+            const Section& section = header->sections[i];
+            if (uint64_t(section.offset) + uint64_t(section.count) * kElementSizes[i] >
+                header->totalSize)
+                return SLANG_E_INVALID_ARG;
+            // Sections are read in place as arrays of their element type
+            if (section.offset % kElementAlignments[i] != 0)
+                return SLANG_E_INVALID_ARG;
+        }
+        // The string pool must be zero terminated, so strings can't run off the end.
+        const Section& strings = header->sections[uint32_t(SectionKind::Strings)];
+        if (strings.count == 0 || m_data[strings.offset + strings.count - 1] != 0)
+            return SLANG_E_INVALID_ARG;
+
+        m_header = header;
+        return SLANG_OK;
+    }
+
+    const Header* getHeader() const { return m_header; }
+
+    uint32_t getCount(SectionKind kind) const
+    {
+        return m_header->sections[uint32_t(kind)].count;
+    }
+
+    const char* getString(StringOffset offset) const
+    {
+        if (offset == kNullIndex || offset >= getCount(SectionKind::Strings))
+            return nullptr;
+        return _getSection<char>(SectionKind::Strings) + offset;
+    }
+
+    const Type* getType(Index index) const { return _get<Type>(SectionKind::Types, index); }
+    const TypeLayout* getTypeLayout(Index index) const
+    {
+        return _get<TypeLayout>(SectionKind::TypeLayouts, index);
+    }
+    const Variable* getVariable(Index index) const
+    {
+        return _get<Variable>(SectionKind::Variables, index);
+    }
+    const VariableLayout* getVariableLayout(Index index) const
+    {
+        return _get<VariableLayout>(SectionKind::VariableLayouts, index);
+    }
+    const EntryPoint* getEntryPoint(Index index) const
+    {
+        return _get<EntryPoint>(SectionKind::EntryPoints, index);
+    }
+
+    /// Get the index at `i` in a range of `Indices`
+    Index getIndex(const Range& range, uint32_t i) const
+    {
+        const Index* index = _getInRange<Index>(SectionKind::Indices, range, i);
+        return index ? *index : kNullIndex;
+    }
+    const Binding* getBinding(const Range& range, uint32_t i) const
+    {
+        return _getInRange<Binding>(SectionKind::Bindings, range, i);
+    }
+    const CategorySize* getCategorySize(const Range& range, uint32_t i) const
+    {
+        return _getInRange<CategorySize>(SectionKind::CategorySizes, range, i);
+    }
+
+    /// Get the size of a type layout for `category`, or 0 if it uses none of that category.
+    uint32_t getSize(const TypeLayout* typeLayout, slang::ParameterCategory category) const
+    {
+        for (uint32_t i = 0; i < typeLayout->sizes.count; ++i)
+        {
+            const CategorySize* size = getCategorySize(typeLayout->sizes, i);
+            if (size && size->category == uint32_t(category))
+                return size->size;
+        }
+        return 0;
+    }
+
+    /// Find a global parameter by name. Returns kNullIndex if not found.
+    Index findGlobalParam(const char* name) const
+    {
+        for (uint32_t i = 0; i < m_header->globalParams.count; ++i)
+        {
+            const Index varLayoutIndex = getIndex(m_header->globalParams, i);
+            const VariableLayout* varLayout = getVariableLayout(varLayoutIndex);
+            const Variable* var = varLayout ? getVariable(varLayout->variable) : nullptr;
+            const char* varName = var ? getString(var->name) : nullptr;
+            if (varName && strcmp(varName, name) == 0)
+                return varLayoutIndex;
+        }
+        return kNullIndex;
+    }
+
+private:
+    template<typename T>
+    const T* _getSection(SectionKind kind) const
+    {
+        return (const T*)(m_data + m_header->sections[uint32_t(kind)].offset);
+    }
+
+    template<typename T>
+    const T* _get(SectionKind kind, uint64_t index) const
+    {
+        if (index >= getCount(kind))
+            return nullptr;
+        return _getSection<T>(kind) + index;
+    }
+
+    /// Get element `i` of `range`. The index is computed in 64 bits, so a corrupt range can't
+    /// wrap around to an element outside of it.
+    template<typename T>
+    const T* _getInRange(SectionKind kind, const Range& range, uint32_t i) const
+    {
+        if (i >= range.count)
+            return nullptr;
+        return _get<T>(kind, uint64_t(range.begin) + i);
+    }
+
+    const char* m_data = nullptr;
+    const Header* m_header = nullptr;
+};
+
+} // namespace reflection_binary
+} // namespace slang
+
+#endif
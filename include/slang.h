@@ -1004,6 +1004,7 @@ typedef uint32_t SlangSizeT;
                          // "Impl:IFoo=3" or "Impl:IFoo".
         EnableExperimentalDynamicDispatch, // bool, experimental
         EmitReflectionJSON,                // bool
+        EmitReflectionBinary,              // string: path to write binary reflection to
 
         CountOfParsableOptions,
 
@@ -1026,6 +1027,22 @@ typedef uint32_t SlangSizeT;
         DumpModule,
 
         EmitSeparateDebug, // bool
+
+        EnableConcurrentSessionAccess, // bool, experimental. Set on a session to allow it to
+                                       // be used from multiple threads. Calls are serialized
+                                       // by a lock, so this does not speed up compiling.
+        PrecompileForwardDerivatives, // bool, experimental. Generate forward derivatives of
+                                      // module functions in `precompileForTarget`.
+        ShareLinkedIR, // bool, experimental. Link the IR once for all entry points of a program,
+                       // and link each entry point from that result.
+        LazyIRLowering, // bool, experimental. Only lower functions to IR when they are reachable
+                        // from an entry point of the module.
+        LazyImportedBodyChecking, // bool, experimental. Only check the bodies of imported
+                                  // functions that the code being compiled can reach.
+        MemoryLimit, // int, experimental. Abort a compile with an error once the AST, IR and
+                     // container memory it takes exceeds this many megabytes. 0 means no limit.
+        PrefetchImports, // bool, experimental. Read the files of imported modules ahead of
+                         // checking on worker threads. Only used with the OS file system.
         CountOf,
     };
 
@@ -1737,6 +1754,31 @@ public:                                                              \
     };
 #define SLANG_UUID_ISlangProfiler ISlangProfiler::getTypeGuid()
 
+    /** Allocates the large blocks of memory that the AST and IR of a session are built from.
+
+    Set on a session with slang::SessionDesc::allocator. The memory allocated through it is what
+    counts against the -memory-limit option, along with the memory of containers.
+    */
+    struct ISlangAllocator : public ISlangUnknown
+    {
+        SLANG_COM_INTERFACE(
+            0x4a4a89b1,
+            0xd21d,
+            0x4a11,
+            {0x94, 0x17, 0xef, 0x64, 0xcd, 0x80, 0x14, 0xe7})
+
+        /** Allocate memory.
+        @param sizeInBytes The size to allocate
+        @returns The memory, aligned at least as malloc would align it, or nullptr on failure */
+        virtual SLANG_NO_THROW void* SLANG_MCALL allocate(size_t sizeInBytes) = 0;
+
+        /** Free memory previously returned by allocate.
+        @param ptr The memory to free
+        @param sizeInBytes The size that was passed to allocate */
+        virtual SLANG_NO_THROW void SLANG_MCALL deallocate(void* ptr, size_t sizeInBytes) = 0;
+    };
+#define SLANG_UUID_ISlangAllocator ISlangAllocator::getTypeGuid()
+
     namespace slang
     {
     struct IGlobalSession;
@@ -3914,6 +3956,11 @@ struct SessionDesc
     /** Whether to skip SPIRV validation.
      */
     bool skipSPIRVValidation = false;
+
+    /** Allocator for the memory of the AST and IR of the session. If null, the memory is
+    allocated from the heap. The allocator may be called on any thread the session is used on.
+     */
+    ISlangAllocator* allocator = nullptr;
 };
 
 enum class ContainerType
@@ -4652,6 +4699,26 @@ SLANG_EXTERN_C SLANG_API SlangResult slang_createGlobalSessionWithoutCoreModule(
     SlangInt apiVersion,
     slang::IGlobalSession** outGlobalSession);
 
+/* Freeze a fully initialized global session.
+
+Completes any lazy initialization of the session's builtin state (the builtin modules, the shared
+AST builder and the name pool), and makes that state immutable from then on. Sessions can still
+be created from a frozen global session as usual.
+
+This is intended for worker pools: a process can create and freeze a global session once, and
+then `fork()` workers that use it with no further initialization, with the memory holding the
+builtin state staying shared between them.
+
+After freezing, loading or compiling builtin modules fails, and sessions no longer contribute
+to the global session's type checking cache. Configuration of the global session (preludes,
+downstream compilers etc.) should be done before freezing.
+
+@param globalSession The global session to freeze. Must have the core module loaded.
+
+NOTE! API is experimental and not ready for production code
+*/
+SLANG_EXTERN_C SLANG_API SlangResult slang_freezeGlobalSession(slang::IGlobalSession* globalSession);
+
 /* Returns a blob that contains the serialized core module.
 Returns nullptr if there isn't an embedded core module.
 
@@ -4733,6 +4800,21 @@ struct ByteCodeRunnerDesc
     /** The size of this structure, in bytes.
      */
     size_t structSize = sizeof(ByteCodeRunnerDesc);
+
+    /** Count the executions and clock ticks of each instruction, opcode and function.
+        The profile can be read back with `IByteCodeRunner::getProfile`. Execution is
+        considerably slower with profiling enabled.
+     */
+    bool enableProfiling = false;
+};
+
+/// The output format of `IByteCodeRunner::getProfile`.
+enum class ByteCodeProfileFormat
+{
+    /// Counters per opcode, per function and per instruction, as JSON.
+    JSON,
+    /// One line per call stack followed by its self ticks, as read by flame graph tools.
+    CollapsedStacks,
 };
 
 /// Represents a byte code runner that can execute Slang byte code.
@@ -4777,6 +4859,14 @@ public:
     /// Set a callback function to print messages from the byte code runner.
     virtual SLANG_NO_THROW SlangResult SLANG_MCALL
     setPrintCallback(VMPrintFunc callback, void* userData) = 0;
+
+    /// Write out the profile collected since the module was loaded or the profile was reset.
+    /// Returns SLANG_E_NOT_AVAILABLE if the runner wasn't created with profiling enabled.
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL
+    getProfile(ByteCodeProfileFormat format, IBlob** outBlob) = 0;
+
+    /// Clear the collected profile.
+    virtual SLANG_NO_THROW void SLANG_MCALL resetProfile() = 0;
 };
 
 } // namespace slang
@@ -0,0 +1,641 @@
+#include "slang-json-native-decoder.h"
+
+#include "../core/slang-rtti-util.h"
+#include "../core/slang-short-list.h"
+#include "../core/slang-string-escape-util.h"
+#include "../core/slang-string-util.h"
+#include "slang-json-diagnostics.h"
+
+namespace Slang
+{
+
+namespace
+{ // anonymous
+
+/// A field of a struct, along with the type it is defined on
+struct FlatField
+{
+    const StructRttiInfo* owner;
+    const StructRttiInfo::Field* field;
+};
+
+typedef ShortList<FlatField, 16> FlatFields;
+
+/// Get all the fields of the struct, in the order of the base class to the final type
+static void _getFlatFields(const StructRttiInfo* structRttiInfo, FlatFields& outFields)
+{
+    if (structRttiInfo->m_super)
+    {
+        _getFlatFields(structRttiInfo->m_super, outFields);
+    }
+    const Index count = structRttiInfo->m_fieldCount;
+    for (Index i = 0; i < count; ++i)
+    {
+        outFields.add(FlatField{structRttiInfo, &structRttiInfo->m_fields[i]});
+    }
+}
+
+} // namespace
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!! Tokens !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+SlangResult JSONToNativeDecoder::_advance()
+{
+    return (m_lexer.advance() == JSONTokenType::Invalid) ? SLANG_FAIL : SLANG_OK;
+}
+
+SlangResult JSONToNativeDecoder::_unexpected()
+{
+    // If the token is invalid the lexer has already reported why
+    if (m_lexer.peekType() != JSONTokenType::Invalid)
+    {
+        m_sink->diagnose(
+            m_lexer.peekLoc(),
+            JSONDiagnostics::unexpectedToken,
+            getJSONTokenAsText(m_lexer.peekType()));
+    }
+    return SLANG_FAIL;
+}
+
+SlangResult JSONToNativeDecoder::_expect(JSONTokenType type)
+{
+    if (m_lexer.peekType() != type)
+    {
+        return _unexpected();
+    }
+    return _advance();
+}
+
+SlangResult JSONToNativeDecoder::_begin(SourceView* sourceView)
+{
+    SLANG_RETURN_ON_FAIL(m_lexer.init(sourceView, m_sink));
+    return (m_lexer.peekType() == JSONTokenType::Invalid) ? SLANG_FAIL : SLANG_OK;
+}
+
+SlangResult JSONToNativeDecoder::_end()
+{
+    // Only whitespace and comments can follow the value
+    if (m_lexer.peekType() != JSONTokenType::EndOfFile)
+    {
+        return _unexpected();
+    }
+    return SLANG_OK;
+}
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!! Values !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+UnownedStringSlice JSONToNativeDecoder::_getTransientString()
+{
+    if (m_lexer.peekType() != JSONTokenType::StringLiteral)
+    {
+        return UnownedStringSlice();
+    }
+
+    // The lexeme includes the quotes
+    const UnownedStringSlice lexeme = m_lexer.peekLexeme();
+    if (lexeme.indexOf('\\') < 0)
+    {
+        return UnownedStringSlice(lexeme.begin() + 1, lexeme.end() - 1);
+    }
+
+    StringEscapeHandler* handler = StringEscapeUtil::getHandler(StringEscapeUtil::Style::JSON);
+    m_buf.clear();
+    StringEscapeUtil::appendUnquoted(handler, lexeme, m_buf);
+    return m_buf.getUnownedSlice();
+}
+
+int64_t JSONToNativeDecoder::_getInteger()
+{
+    switch (m_lexer.peekType())
+    {
+    case JSONTokenType::IntegerLiteral:
+        {
+            int64_t intValue;
+            if (SLANG_SUCCEEDED(StringUtil::parseInt64(m_lexer.peekLexeme(), intValue)))
+            {
+                return intValue;
+            }
+            SLANG_ASSERT(!"Couldn't convert int");
+            return 0;
+        }
+    case JSONTokenType::FloatLiteral:
+        return int64_t(_getFloat());
+    case JSONTokenType::True:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+double JSONToNativeDecoder::_getFloat()
+{
+    switch (m_lexer.peekType())
+    {
+    case JSONTokenType::IntegerLiteral:
+        return double(_getInteger());
+    case JSONTokenType::FloatLiteral:
+        {
+            double floatValue;
+            if (SLANG_SUCCEEDED(StringUtil::parseDouble(m_lexer.peekLexeme(), floatValue)))
+            {
+                return floatValue;
+            }
+            SLANG_ASSERT(!"Couldn't convert double");
+            return 0.0;
+        }
+    case JSONTokenType::True:
+        return 1.0;
+    default:
+        return 0.0;
+    }
+}
+
+SlangResult JSONToNativeDecoder::_skipValue()
+{
+    switch (m_lexer.peekType())
+    {
+    case JSONTokenType::LBrace:
+        {
+            SLANG_RETURN_ON_FAIL(_advance());
+            if (m_lexer.peekType() != JSONTokenType::RBrace)
+            {
+                for (;;)
+                {
+                    SLANG_RETURN_ON_FAIL(_expect(JSONTokenType::StringLiteral));
+                    SLANG_RETURN_ON_FAIL(_expect(JSONTokenType::Colon));
+                    SLANG_RETURN_ON_FAIL(_skipValue());
+
+                    if (m_lexer.peekType() != JSONTokenType::Comma)
+                    {
+                        break;
+                    }
+                    SLANG_RETURN_ON_FAIL(_advance());
+                }
+            }
+            return _expect(JSONTokenType::RBrace);
+        }
+    case JSONTokenType::LBracket:
+        {
+            SLANG_RETURN_ON_FAIL(_advance());
+            if (m_lexer.peekType() != JSONTokenType::RBracket)
+            {
+                for (;;)
+                {
+                    SLANG_RETURN_ON_FAIL(_skipValue());
+
+                    if (m_lexer.peekType() != JSONTokenType::Comma)
+                    {
+                        break;
+                    }
+                    SLANG_RETURN_ON_FAIL(_advance());
+                }
+            }
+            return _expect(JSONTokenType::RBracket);
+        }
+    case JSONTokenType::StringLiteral:
+    case JSONTokenType::IntegerLiteral:
+    case JSONTokenType::FloatLiteral:
+    case JSONTokenType::True:
+    case JSONTokenType::False:
+    case JSONTokenType::Null:
+        return _advance();
+    default:
+        return _unexpected();
+    }
+}
+
+SlangResult JSONToNativeDecoder::_readValue(JSONValue& outValue)
+{
+    const JSONToken token = m_lexer.peekToken();
+    switch (token.type)
+    {
+    case JSONTokenType::LBrace:
+        {
+            List<JSONKeyValue> pairs;
+
+            SLANG_RETURN_ON_FAIL(_advance());
+            if (m_lexer.peekType() != JSONTokenType::RBrace)
+            {
+                for (;;)
+                {
+                    if (m_lexer.peekType() != JSONTokenType::StringLiteral)
+                    {
+                        return _unexpected();
+                    }
+                    const SourceLoc keyLoc = m_lexer.peekLoc();
+                    const JSONKey key = m_container->getKey(_getTransientString());
+
+                    SLANG_RETURN_ON_FAIL(_advance());
+                    SLANG_RETURN_ON_FAIL(_expect(JSONTokenType::Colon));
+
+                    JSONValue value;
+                    SLANG_RETURN_ON_FAIL(_readValue(value));
+                    pairs.add(JSONKeyValue::make(key, value, keyLoc));
+
+                    if (m_lexer.peekType() != JSONTokenType::Comma)
+                    {
+                        break;
+                    }
+                    SLANG_RETURN_ON_FAIL(_advance());
+                }
+            }
+            SLANG_RETURN_ON_FAIL(_expect(JSONTokenType::RBrace));
+
+            outValue = m_container->createObject(pairs.getBuffer(), pairs.getCount(), token.loc);
+            return SLANG_OK;
+        }
+    case JSONTokenType::LBracket:
+        {
+            List<JSONValue> values;
+
+            SLANG_RETURN_ON_FAIL(_advance());
+            if (m_lexer.peekType() != JSONTokenType::RBracket)
+            {
+                for (;;)
+                {
+                    JSONValue value;
+                    SLANG_RETURN_ON_FAIL(_readValue(value));
+                    values.add(value);
+
+                    if (m_lexer.peekType() != JSONTokenType::Comma)
+                    {
+                        break;
+                    }
+                    SLANG_RETURN_ON_FAIL(_advance());
+                }
+            }
+            SLANG_RETURN_ON_FAIL(_expect(JSONTokenType::RBracket));
+
+            outValue = m_container->createArray(values.getBuffer(), values.getCount(), token.loc);
+            return SLANG_OK;
+        }
+    // As JSONBuilder does, literals are held as lexemes that refer to the source text
+    case JSONTokenType::StringLiteral:
+        outValue = JSONValue::makeLexeme(JSONValue::Type::StringLexeme, token.loc, token.length);
+        break;
+    case JSONTokenType::IntegerLiteral:
+        outValue = JSONValue::makeLexeme(JSONValue::Type::IntegerLexeme, token.loc, token.length);
+        break;
+    case JSONTokenType::FloatLiteral:
+        outValue = JSONValue::makeLexeme(JSONValue::Type::FloatLexeme, token.loc, token.length);
+        break;
+    case JSONTokenType::True:
+    case JSONTokenType::False:
+        outValue = JSONValue::makeBool(token.type == JSONTokenType::True, token.loc);
+        break;
+    case JSONTokenType::Null:
+        outValue = JSONValue::makeNull(token.loc);
+        break;
+    default:
+        return _unexpected();
+    }
+    return _advance();
+}
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!! Decoding !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+SlangResult JSONToNativeDecoder::_decodeStruct(const StructRttiInfo* structRttiInfo, void* out)
+{
+    Byte* dst = (Byte*)out;
+
+    FlatFields fields;
+    _getFlatFields(structRttiInfo, fields);
+
+    const Index fieldCount = fields.getCount();
+
+    ShortList<bool, 16> found;
+    found.setCount(fieldCount);
+    for (Index i = 0; i < fieldCount; ++i)
+    {
+        found[i] = false;
+    }
+
+    bool hasUnknownFields = false;
+
+    const SourceLoc structLoc = m_lexer.peekLoc();
+    SLANG_RETURN_ON_FAIL(_expect(JSONTokenType::LBrace));
+    if (m_lexer.peekType() != JSONTokenType::RBrace)
+    {
+        for (;;)
+        {
+            if (m_lexer.peekType() != JSONTokenType::StringLiteral)
+            {
+                return _unexpected();
+            }
+
+            const SourceLoc fieldLoc = m_lexer.peekLoc();
+            const UnownedStringSlice fieldName = _getTransientString();
+            const Index index = fields.findFirstIndex(
+                [fieldName](const FlatField& flatField) -> bool
+                { return fieldName == flatField.field->m_name; });
+
+            if (index < 0 && !structRttiInfo->m_ignoreUnknownFieldsInJson)
+            {
+                m_sink->diagnose(
+                    fieldLoc,
+                    JSONDiagnostics::fieldNotDefinedOnType,
+                    fieldName,
+                    structRttiInfo->m_name);
+                hasUnknownFields = true;
+            }
+
+            SLANG_RETURN_ON_FAIL(_advance());
+            SLANG_RETURN_ON_FAIL(_expect(JSONTokenType::Colon));
+
+            if (index >= 0)
+            {
+                const auto field = fields[index].field;
+                SLANG_RETURN_ON_FAIL(_decode(field->m_type, dst + field->m_offset));
+                found[index] = true;
+            }
+            else
+            {
+                SLANG_RETURN_ON_FAIL(_skipValue());
+            }
+
+            if (m_lexer.peekType() != JSONTokenType::Comma)
+            {
+                break;
+            }
+            SLANG_RETURN_ON_FAIL(_advance());
+        }
+    }
+    SLANG_RETURN_ON_FAIL(_expect(JSONTokenType::RBrace));
+
+    for (Index i = 0; i < fieldCount; ++i)
+    {
+        const auto& flatField = fields[i];
+        if (found[i] || (flatField.field->m_flags & StructRttiInfo::Flag::Optional))
+        {
+            continue;
+        }
+
+        m_sink->diagnose(
+            structLoc,
+            JSONDiagnostics::fieldRequiredOnType,
+            flatField.field->m_name,
+            flatField.owner->m_name);
+        return SLANG_FAIL;
+    }
+
+    return hasUnknownFields ? SLANG_FAIL : SLANG_OK;
+}
+
+SlangResult JSONToNativeDecoder::_decodeList(const RttiInfo* rttiInfo, void* out)
+{
+    const ListRttiInfo* listRttiInfo = static_cast<const ListRttiInfo*>(rttiInfo);
+    const auto elementType = listRttiInfo->m_elementType;
+    const Index elementSize = Index(elementType->m_size);
+
+    List<Byte>& list = *(List<Byte>*)out;
+
+    // Clearing first means the elements are all freshly constructed as the list grows
+    SLANG_RETURN_ON_FAIL(RttiUtil::setListCount(m_typeMap, elementType, out, 0));
+
+    Index count = 0;
+
+    SLANG_RETURN_ON_FAIL(_expect(JSONTokenType::LBracket));
+    if (m_lexer.peekType() != JSONTokenType::RBracket)
+    {
+        for (;;)
+        {
+            // The element count isn't known until the closing ']', so the list grows by doubling.
+            // The elements past count are constructed, and dropped when the count is set below.
+            if (count >= list.getCount())
+            {
+                const Index newCount = (count < 4) ? 4 : count * 2;
+                SLANG_RETURN_ON_FAIL(RttiUtil::setListCount(m_typeMap, elementType, out, newCount));
+            }
+            SLANG_RETURN_ON_FAIL(_decode(elementType, list.getBuffer() + count * elementSize));
+            ++count;
+
+            if (m_lexer.peekType() != JSONTokenType::Comma)
+            {
+                break;
+            }
+            SLANG_RETURN_ON_FAIL(_advance());
+        }
+    }
+    SLANG_RETURN_ON_FAIL(_expect(JSONTokenType::RBracket));
+
+    return RttiUtil::setListCount(m_typeMap, elementType, out, count);
+}
+
+SlangResult JSONToNativeDecoder::_decodeFixedArray(const RttiInfo* rttiInfo, void* out)
+{
+    const FixedArrayRttiInfo* fixedArrayRttiInfo =
+        static_cast<const FixedArrayRttiInfo*>(rttiInfo);
+    const auto elementType = fixedArrayRttiInfo->m_elementType;
+    const Index elementCount = Index(fixedArrayRttiInfo->m_elementCount);
+    const Index elementSize = Index(elementType->m_size);
+
+    Byte* dstEles = (Byte*)out;
+    Index count = 0;
+
+    const SourceLoc arrayLoc = m_lexer.peekLoc();
+    SLANG_RETURN_ON_FAIL(_expect(JSONTokenType::LBracket));
+    if (m_lexer.peekType() != JSONTokenType::RBracket)
+    {
+        for (;;)
+        {
+            // Elements past the end are only counted, so the diagnostic can report how many
+            // there are
+            if (count < elementCount)
+            {
+                SLANG_RETURN_ON_FAIL(_decode(elementType, dstEles + count * elementSize));
+            }
+            else
+            {
+                SLANG_RETURN_ON_FAIL(_skipValue());
+            }
+            ++count;
+
+            if (m_lexer.peekType() != JSONTokenType::Comma)
+            {
+                break;
+            }
+            SLANG_RETURN_ON_FAIL(_advance());
+        }
+    }
+    SLANG_RETURN_ON_FAIL(_expect(JSONTokenType::RBracket));
+
+    if (count > elementCount)
+    {
+        m_sink->diagnose(
+            arrayLoc,
+            JSONDiagnostics::tooManyElementsForArray,
+            count,
+            elementCount);
+        return SLANG_FAIL;
+    }
+    return SLANG_OK;
+}
+
+SlangResult JSONToNativeDecoder::_decode(const RttiInfo* rttiInfo, void* out)
+{
+    const JSONTokenType tokenType = m_lexer.peekType();
+
+    if (rttiInfo->isIntegral() || rttiInfo->isFloat() || rttiInfo->m_kind == RttiInfo::Kind::Bool)
+    {
+        switch (tokenType)
+        {
+        case JSONTokenType::IntegerLiteral:
+        case JSONTokenType::FloatLiteral:
+        case JSONTokenType::True:
+        case JSONTokenType::False:
+        case JSONTokenType::Null:
+            break;
+        default:
+            return _unexpected();
+        }
+
+        if (rttiInfo->isIntegral())
+        {
+            SLANG_RETURN_ON_FAIL(RttiUtil::setInt(_getInteger(), rttiInfo, out));
+        }
+        else if (rttiInfo->isFloat())
+        {
+            SLANG_RETURN_ON_FAIL(RttiUtil::setFromDouble(_getFloat(), rttiInfo, out));
+        }
+        else
+        {
+            *(bool*)out = (tokenType == JSONTokenType::FloatLiteral) ? (_getFloat() != 0.0)
+                                                                    : (_getInteger() != 0);
+        }
+        return _advance();
+    }
+
+    switch (rttiInfo->m_kind)
+    {
+    case RttiInfo::Kind::Struct:
+        {
+            if (tokenType != JSONTokenType::LBrace)
+            {
+                return SLANG_FAIL;
+            }
+            return _decodeStruct(static_cast<const StructRttiInfo*>(rttiInfo), out);
+        }
+    case RttiInfo::Kind::Enum:
+        {
+            return SLANG_E_NOT_IMPLEMENTED;
+        }
+    case RttiInfo::Kind::String:
+        {
+            if (tokenType != JSONTokenType::StringLiteral && tokenType != JSONTokenType::Null)
+            {
+                return SLANG_FAIL;
+            }
+            *(String*)out = _getTransientString();
+            return _advance();
+        }
+    case RttiInfo::Kind::UnownedStringSlice:
+        {
+            if (tokenType == JSONTokenType::Null)
+            {
+                *(UnownedStringSlice*)out = UnownedStringSlice();
+                return _advance();
+            }
+            // The text being decoded may not outlive the slice, so it is held in the container
+            if (tokenType != JSONTokenType::StringLiteral || !m_container)
+            {
+                return SLANG_FAIL;
+            }
+            *(UnownedStringSlice*)out =
+                m_container->getStringFromKey(m_container->getKey(_getTransientString()));
+            return _advance();
+        }
+    case RttiInfo::Kind::List:
+        {
+            if (tokenType == JSONTokenType::Null)
+            {
+                return _advance();
+            }
+            if (tokenType != JSONTokenType::LBracket)
+            {
+                return SLANG_FAIL;
+            }
+            return _decodeList(rttiInfo, out);
+        }
+    case RttiInfo::Kind::FixedArray:
+        {
+            if (tokenType != JSONTokenType::LBracket)
+            {
+                return SLANG_FAIL;
+            }
+            return _decodeFixedArray(rttiInfo, out);
+        }
+    case RttiInfo::Kind::Other:
+        {
+            if (rttiInfo == GetRttiInfo<JSONValue>::get() && m_container)
+            {
+                return _readValue(*(JSONValue*)out);
+            }
+            return SLANG_FAIL;
+        }
+    default:
+        break;
+    }
+    return SLANG_FAIL;
+}
+
+SlangResult JSONToNativeDecoder::_decodeArrayToStruct(const RttiInfo* rttiInfo, void* out)
+{
+    // Check decoding JSON array into a struct, as that's what this method supports
+    if (!(rttiInfo->m_kind == RttiInfo::Kind::Struct &&
+          m_lexer.peekType() == JSONTokenType::LBracket))
+    {
+        return SLANG_FAIL;
+    }
+
+    Byte* dstBase = (Byte*)out;
+
+    FlatFields fields;
+    _getFlatFields(static_cast<const StructRttiInfo*>(rttiInfo), fields);
+    const Index fieldCount = fields.getCount();
+
+    Index argIndex = 0;
+
+    SLANG_RETURN_ON_FAIL(_advance());
+    if (m_lexer.peekType() != JSONTokenType::RBracket)
+    {
+        for (;;)
+        {
+            // Must have the same amount of elements as fields
+            if (argIndex >= fieldCount)
+            {
+                return SLANG_FAIL;
+            }
+
+            const auto field = fields[argIndex++].field;
+            SLANG_RETURN_ON_FAIL(_decode(field->m_type, dstBase + field->m_offset));
+
+            if (m_lexer.peekType() != JSONTokenType::Comma)
+            {
+                break;
+            }
+            SLANG_RETURN_ON_FAIL(_advance());
+        }
+    }
+    SLANG_RETURN_ON_FAIL(_expect(JSONTokenType::RBracket));
+
+    return (argIndex == fieldCount) ? SLANG_OK : SLANG_FAIL;
+}
+
+SlangResult JSONToNativeDecoder::decode(SourceView* sourceView, const RttiInfo* rttiInfo, void* out)
+{
+    SLANG_RETURN_ON_FAIL(_begin(sourceView));
+    SLANG_RETURN_ON_FAIL(_decode(rttiInfo, out));
+    return _end();
+}
+
+SlangResult JSONToNativeDecoder::decodeArrayToStruct(
+    SourceView* sourceView,
+    const RttiInfo* rttiInfo,
+    void* out)
+{
+    SLANG_RETURN_ON_FAIL(_begin(sourceView));
+    SLANG_RETURN_ON_FAIL(_decodeArrayToStruct(rttiInfo, out));
+    return _end();
+}
+
+} // namespace Slang
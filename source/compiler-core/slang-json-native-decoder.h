@@ -0,0 +1,85 @@
+#ifndef SLANG_COMPILER_CORE_JSON_NATIVE_DECODER_H
+#define SLANG_COMPILER_CORE_JSON_NATIVE_DECODER_H
+
+#include "slang-com-helper.h"
+#include "slang-json-lexer.h"
+#include "slang-json-value.h"
+
+namespace Slang
+{
+
+/* Decodes JSON text directly into native types described by RttiInfo.
+
+Unlike parsing into a JSONContainer and then using JSONToNativeConverter, the tokens from the
+JSONLexer are written into the native representation as they are read, without building a JSON
+hierarchy. The conversions and diagnostics match JSONToNativeConverter.
+
+The container is only used for values that need storage outside of the native types -
+UnownedStringSlice fields and JSONValue fields. JSONValues refer to the text of the source view,
+so the container must use the same SourceManager. It can be nullptr if the types don't have such
+fields.
+*/
+struct JSONToNativeDecoder
+{
+    /// Decode the JSON text of sourceView into out, which is of type rttiInfo
+    SlangResult decode(SourceView* sourceView, const RttiInfo* rttiInfo, void* out);
+    template<typename T>
+    SlangResult decode(SourceView* sourceView, T* out)
+    {
+        return decode(sourceView, GetRttiInfo<T>::get(), (void*)out);
+    }
+
+    /// Decode a JSON array into the struct out, where the elements are the fields in order (as
+    /// JSONToNativeConverter::convertArrayToStruct)
+    SlangResult decodeArrayToStruct(SourceView* sourceView, const RttiInfo* rttiInfo, void* out);
+    template<typename T>
+    SlangResult decodeArrayToStruct(SourceView* sourceView, T* out)
+    {
+        return decodeArrayToStruct(sourceView, GetRttiInfo<T>::get(), (void*)out);
+    }
+
+    JSONToNativeDecoder(JSONContainer* container, RttiTypeFuncsMap* typeMap, DiagnosticSink* sink)
+        : m_container(container), m_typeMap(typeMap), m_sink(sink)
+    {
+    }
+
+protected:
+    SlangResult _begin(SourceView* sourceView);
+    SlangResult _end();
+
+    /// Move to the next token. Fails if it couldn't be lexed (which the lexer reports).
+    SlangResult _advance();
+    SlangResult _expect(JSONTokenType type);
+    SlangResult _unexpected();
+
+    /// Get the contents of the current string token, unescaped if necessary. The returned slice
+    /// is only valid until the next string is unescaped.
+    UnownedStringSlice _getTransientString();
+
+    int64_t _getInteger();
+    double _getFloat();
+
+    /// Decode the value at the current token into out, and advance past it
+    SlangResult _decode(const RttiInfo* rttiInfo, void* out);
+    SlangResult _decodeStruct(const StructRttiInfo* structRttiInfo, void* out);
+    SlangResult _decodeList(const RttiInfo* rttiInfo, void* out);
+    SlangResult _decodeFixedArray(const RttiInfo* rttiInfo, void* out);
+    SlangResult _decodeArrayToStruct(const RttiInfo* rttiInfo, void* out);
+
+    /// Read the value at the current token as a JSONValue held in m_container
+    SlangResult _readValue(JSONValue& outValue);
+    /// Skip the value at the current token
+    SlangResult _skipValue();
+
+    JSONLexer m_lexer;
+
+    StringBuilder m_buf;
+
+    DiagnosticSink* m_sink;
+    RttiTypeFuncsMap* m_typeMap;
+    JSONContainer* m_container;
+};
+
+} // namespace Slang
+
+#endif // SLANG_COMPILER_CORE_JSON_NATIVE_DECODER_H
@@ -4,12 +4,44 @@
 #include "../core/slang-process-util.h"
 #include "../core/slang-short-list.h"
 #include "../core/slang-string-util.h"
+#include "slang-json-native-decoder.h"
 #include "slang-json-native.h"
 #include "slang-json-rpc.h"
 
 namespace Slang
 {
 
+namespace
+{ // anonymous
+
+/// The fields of a JSON-RPC message that determine what kind of message it is, and its id.
+/// Any other fields are skipped when this is decoded.
+struct JSONRPCMessageHeader
+{
+    JSONValue result;
+    JSONValue error;
+    JSONValue method;
+    JSONValue id;
+
+    static const StructRttiInfo g_rttiInfo;
+};
+
+static const StructRttiInfo _makeJSONRPCMessageHeaderRtti()
+{
+    JSONRPCMessageHeader obj;
+    StructRttiBuilder builder(&obj, "JSONRPCMessageHeader", nullptr);
+    builder.addField("result", &obj.result, StructRttiInfo::Flag::Optional);
+    builder.addField("error", &obj.error, StructRttiInfo::Flag::Optional);
+    builder.addField("method", &obj.method, StructRttiInfo::Flag::Optional);
+    builder.addField("id", &obj.id, StructRttiInfo::Flag::Optional);
+    builder.ignoreUnknownFields();
+    return builder.make();
+}
+/* static */ const StructRttiInfo JSONRPCMessageHeader::g_rttiInfo =
+    _makeJSONRPCMessageHeaderRtti();
+
+} // namespace
+
 /// Ctor
 JSONRPCConnection::JSONRPCConnection()
     : m_container(nullptr), m_typeMap(JSONNativeUtil::getTypeFuncsMap())
@@ -58,7 +90,9 @@ void JSONRPCConnection::clearBuffers()
     m_sourceManager.reset();
     m_diagnosticSink.reset();
     m_container.reset();
-    m_jsonRoot.reset();
+    m_messageSourceView = nullptr;
+    m_messageType = JSONRPCMessageType::Invalid;
+    m_messageId.reset();
 }
 
 bool JSONRPCConnection::isActive()
@@ -69,7 +103,7 @@ bool JSONRPCConnection::isActive()
 JSONValue JSONRPCConnection::getCurrentMessageId()
 {
     SLANG_ASSERT(hasMessage());
-    return JSONRPCUtil::getId(&m_container, m_jsonRoot);
+    return m_messageId;
 }
 
 void JSONRPCConnection::disconnect()
@@ -273,17 +307,28 @@ SlangResult JSONRPCConnection::sendCall(
 
 SlangResult JSONRPCConnection::waitForResult(Int timeOutInMs)
 {
-    // Invalidate m_jsonRoot before waitForResult, because when waitForResult fail,
+    // Invalidate the message before waitForResult, because when waitForResult fail,
     // we don't want to use the result from the previous read.
-    m_jsonRoot.reset();
+    m_messageSourceView = nullptr;
+    _consumeMessageContent();
 
     SLANG_RETURN_ON_FAIL(m_connection->waitForResult(timeOutInMs));
     return tryReadMessage();
 }
 
+void JSONRPCConnection::_consumeMessageContent()
+{
+    if (m_isHoldingContent)
+    {
+        m_connection->consumeContent();
+        m_isHoldingContent = false;
+    }
+}
+
 SlangResult JSONRPCConnection::tryReadMessage()
 {
-    m_jsonRoot.reset();
+    m_messageSourceView = nullptr;
+    _consumeMessageContent();
 
     SLANG_RETURN_ON_FAIL(m_connection->update());
     if (!m_connection->hasContent())
@@ -291,30 +336,66 @@ SlangResult JSONRPCConnection::tryReadMessage()
         return SLANG_OK;
     }
 
-    auto content = m_connection->getContent();
-    UnownedStringSlice slice((const char*)content.begin(), content.getCount());
-
     clearBuffers();
 
+    SourceView* sourceView;
     {
-        const SlangResult res =
-            JSONRPCUtil::parseJSON(slice, &m_container, &m_diagnosticSink, m_jsonRoot);
+        // The message is decoded straight from the connection's read buffer, so the packet isn't
+        // consumed until the next message is read.
+        const UnownedStringSlice text = m_connection->getContentAsTerminatedText();
+        m_isHoldingContent = true;
+
+        ComPtr<ISlangBlob> blob = UnownedRawBlob::createTerminated(text.begin(), text.getLength());
+        SourceFile* sourceFile =
+            m_sourceManager.createSourceFileWithBlob(PathInfo::makeUnknown(), blob);
+        sourceView = m_sourceManager.createSourceView(sourceFile, nullptr, SourceLoc());
+    }
 
-        // Consume that content/packet
-        m_connection->consumeContent();
-        if (SLANG_FAILED(res))
+    // The message is decoded from its text when it's asked for (see getRPC), so only the fields
+    // that say what kind of message it is are read here. The other fields are skipped, which still
+    // checks they are valid JSON, but doesn't build anything from them.
+    JSONRPCMessageHeader header;
+    JSONToNativeDecoder decoder(&m_container, &m_typeMap, &m_diagnosticSink);
+    if (SLANG_FAILED(decoder.decode(sourceView, &header)))
+    {
+        // It could be valid JSON that isn't an object, which is a message of an invalid type
+        // rather than a parse error
+        m_diagnosticSink.reset();
+
+        JSONLexer lexer;
+        lexer.init(sourceView, &m_diagnosticSink);
+        JSONBuilder builder(&m_container);
+        JSONParser parser;
+        if (SLANG_FAILED(parser.parse(&lexer, sourceView, &builder, &m_diagnosticSink)))
         {
+            // There is no message to decode later, so the packet can be consumed now
+            _consumeMessageContent();
+
             // if we can't parse JSON, we return with id of 'null' as per the standard
             return sendError(JSONRPC::ErrorCode::ParseError, JSONValue::makeNull());
         }
     }
 
+    m_messageSourceView = sourceView;
+    m_messageId = header.id;
+    if (header.result.isValid())
+    {
+        m_messageType = JSONRPCMessageType::Result;
+    }
+    else if (header.error.isValid())
+    {
+        m_messageType = JSONRPCMessageType::Error;
+    }
+    else if (header.method.isValid())
+    {
+        m_messageType = JSONRPCMessageType::Call;
+    }
     return SLANG_OK;
 }
 
 JSONRPCMessageType JSONRPCConnection::getMessageType()
 {
-    return JSONRPCUtil::getMessageType(&m_container, m_jsonRoot);
+    return m_messageType;
 }
 
 SlangResult JSONRPCConnection::getMessage(const RttiInfo* rttiInfo, void* out)
@@ -325,13 +406,14 @@ SlangResult JSONRPCConnection::getMessage(const RttiInfo* rttiInfo, void* out)
     }
 
     m_diagnosticSink.outputBuffer.clear();
-    JSONToNativeConverter converter(&m_container, &m_typeMap, &m_diagnosticSink);
 
     // Get the RPC response
     JSONResultResponse resultResponse;
-    SLANG_RETURN_ON_FAIL(converter.convert(m_jsonRoot, &resultResponse));
+    JSONToNativeDecoder decoder(&m_container, &m_typeMap, &m_diagnosticSink);
+    SLANG_RETURN_ON_FAIL(decoder.decode(m_messageSourceView, &resultResponse));
 
     // Convert the result in the response
+    JSONToNativeConverter converter(&m_container, &m_typeMap, &m_diagnosticSink);
     SLANG_RETURN_ON_FAIL(converter.convert(resultResponse.result, rttiInfo, out));
     return SLANG_OK;
 }
@@ -359,10 +441,10 @@ SlangResult JSONRPCConnection::getRPC(const RttiInfo* rttiInfo, void* out)
     }
 
     m_diagnosticSink.outputBuffer.clear();
-    JSONToNativeConverter converter(&m_container, &m_typeMap, &m_diagnosticSink);
 
-    // Convert the result in the response
-    SLANG_RETURN_ON_FAIL(converter.convert(m_jsonRoot, rttiInfo, out));
+    // Decode straight from the text of the message
+    JSONToNativeDecoder decoder(&m_container, &m_typeMap, &m_diagnosticSink);
+    SLANG_RETURN_ON_FAIL(decoder.decode(m_messageSourceView, rttiInfo, out));
     return SLANG_OK;
 }
 
@@ -156,8 +156,8 @@ public:
     /// Will block for message/result up to time
     SlangResult waitForResult(Int timeOutInMs = -1);
 
-    /// If we have an JSON-RPC message m_jsonRoot the root.
-    bool hasMessage() const { return m_jsonRoot.isValid(); }
+    /// True if a JSON-RPC message has been read
+    bool hasMessage() const { return m_messageSourceView != nullptr; }
 
     /// If there is a message returns kind of JSON RPC message
     JSONRPCMessageType getMessageType();
@@ -232,6 +232,9 @@ protected:
         return (callStyle == CallStyle::Default) ? m_defaultCallStyle : callStyle;
     }
 
+    /// Consume the packet of the last message read from the connection, if it hasn't been
+    void _consumeMessageContent();
+
     RefPtr<Process> m_process;                 ///< Backing process (optional)
     RefPtr<HTTPPacketConnection> m_connection; ///< The underlying 'transport' connection, whilst
                                                ///< HTTP currently doesn't have to be
@@ -244,7 +247,12 @@ protected:
     JSONContainer m_container; ///< Holds the backing memory for jsonMemory, and used when
                                ///< converting input into output JSON
 
-    JSONValue m_jsonRoot; ///< The root JSON value for the currently read message.
+    SourceView* m_messageSourceView =
+        nullptr; ///< The text of the currently read message. Decoded as it's needed.
+    bool m_isHoldingContent =
+        false; ///< True if the text of the current message is still in the connection's buffer
+    JSONRPCMessageType m_messageType = JSONRPCMessageType::Invalid; ///< Type of the current message
+    JSONValue m_messageId;                                            ///< Id of the current message
 
     CallStyle m_defaultCallStyle = CallStyle::Array; ///< The default calling style
 
@@ -1,6 +1,7 @@
 #include "slang-json-rpc.h"
 
 #include "slang-com-helper.h"
+#include "slang-json-native-decoder.h"
 #include "slang-json-native.h"
 
 namespace Slang
@@ -149,6 +150,27 @@ static const StructRttiInfo _makeJSONResultResponseResponseRtti()
     return SLANG_OK;
 }
 
+/* static */ SlangResult JSONRPCUtil::decodeToNative(
+    const UnownedStringSlice& slice,
+    JSONContainer* container,
+    DiagnosticSink* sink,
+    const RttiInfo* rttiInfo,
+    void* out)
+{
+    SourceManager* sourceManager = sink->getSourceManager();
+
+    String contents(slice);
+    SourceFile* sourceFile =
+        sourceManager->createSourceFileWithString(PathInfo::makeUnknown(), contents);
+    SourceView* sourceView = sourceManager->createSourceView(sourceFile, nullptr, SourceLoc());
+
+    auto typeMap = JSONNativeUtil::getTypeFuncsMap();
+
+    JSONToNativeDecoder decoder(container, &typeMap, sink);
+    SLANG_RETURN_ON_FAIL(decoder.decode(sourceView, rttiInfo, out));
+    return SLANG_OK;
+}
+
 /* static */ SlangResult JSONRPCUtil::convertToJSON(
     const RttiInfo* rttiInfo,
     const void* in,
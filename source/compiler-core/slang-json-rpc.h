@@ -140,6 +140,26 @@ public:
         return convertToNative(container, value, sink, GetRttiInfo<T>::get(), (void*)&out);
     }
 
+    /// Decode the JSON text in slice directly into out, without parsing it into a container
+    /// first. The container is only used to hold UnownedStringSlice and JSONValue fields, and can
+    /// be nullptr if out has none.
+    /// NOTE! As parseJSON, the text is held in the source manager of the sink.
+    static SlangResult decodeToNative(
+        const UnownedStringSlice& slice,
+        JSONContainer* container,
+        DiagnosticSink* sink,
+        const RttiInfo* rttiInfo,
+        void* out);
+    template<typename T>
+    static SlangResult decodeToNative(
+        const UnownedStringSlice& slice,
+        JSONContainer* container,
+        DiagnosticSink* sink,
+        T& out)
+    {
+        return decodeToNative(slice, container, sink, GetRttiInfo<T>::get(), (void*)&out);
+    }
+
     /// Convert to JSON
     static SlangResult convertToJSON(
         const RttiInfo* rttiInfo,
@@ -23,13 +23,26 @@ const char* getCstr(Name* name)
 
 Name* NamePool::getName(UnownedStringSlice text)
 {
-    RefPtr<Name> name;
-    if (rootPool->names.tryGetValue(text, name))
+    // Look up without copying the `RefPtr`, so that the reference count of
+    // a shared name isn't modified.
+    if (auto found = rootPool->names.tryGetValue(text))
+        return *found;
+
+    if (!rootPool->isFrozen)
+    {
+        RefPtr<Name> name = new Name();
+        name->text = text;
+        rootPool->names.add(text, name);
         return name;
+    }
+
+    std::lock_guard<std::mutex> lock(rootPool->addedNamesMutex);
+    if (auto found = rootPool->addedNames.tryGetValue(text))
+        return *found;
 
-    name = new Name();
+    RefPtr<Name> name = new Name();
     name->text = text;
-    rootPool->names.add(text, name);
+    rootPool->addedNames.add(text, name);
     return name;
 }
 
@@ -40,9 +53,15 @@ Name* NamePool::getName(String const& text)
 
 Name* NamePool::tryGetName(String const& text)
 {
-    RefPtr<Name> name;
-    if (rootPool->names.tryGetValue(text, name))
-        return name;
+    if (auto found = rootPool->names.tryGetValue(text))
+        return *found;
+
+    if (rootPool->isFrozen)
+    {
+        std::lock_guard<std::mutex> lock(rootPool->addedNamesMutex);
+        if (auto found = rootPool->addedNames.tryGetValue(text))
+            return *found;
+    }
     return nullptr;
 }
 
@@ -7,6 +7,8 @@
 
 #include "../core/slang-basic.h"
 
+#include <mutex>
+
 namespace Slang
 {
 
@@ -52,6 +54,18 @@ struct RootNamePool
 {
     // The mapping from text strings to the corresponding name.
     Dictionary<String, RefPtr<Name>> names;
+
+    // Once a pool is frozen `names` is never modified again, so it can be
+    // read from any thread without locking (and its memory stays untouched
+    // in processes that share it after a `fork()`). Names created after
+    // that are stored in `addedNames`, guarded by `addedNamesMutex`.
+    //
+    bool isFrozen = false;
+    Dictionary<String, RefPtr<Name>> addedNames;
+    std::mutex addedNamesMutex;
+
+    // Freeze the pool, see `isFrozen`.
+    void freeze() { isFrozen = true; }
 };
 
 // A `NamePool` is effectively a way of storing a subset of the
@@ -611,6 +611,17 @@ int SourceFile::calcColumnIndex(int lineIndex, int offset, int tabSize)
 
 /* !!!!!!!!!!!!!!!!!!!!!!!!! SourceFile !!!!!!!!!!!!!!!!!!!!!!!!!!!! */
 
+/// True if the blob's contents are known to be followed by a 0 byte
+static bool _isZeroTerminated(ISlangBlob* blob)
+{
+    ComPtr<ICastable> castable;
+    if (SLANG_SUCCEEDED(blob->queryInterface(SLANG_IID_PPV_ARGS(castable.writeRef()))))
+    {
+        return castable->castAs(SlangTerminatedChars::getTypeGuid()) != nullptr;
+    }
+    return false;
+}
+
 void SourceFile::setContents(ISlangBlob* blob)
 {
     const UInt rawContentSize = blob->getBufferSize();
@@ -624,6 +635,17 @@ void SourceFile::setContents(ISlangBlob* blob)
     auto type = CharEncoding::determineEncoding(rawContentBegin, rawContentSize, offset);
     SLANG_ASSERT(rawContentSize >= offset);
 
+    // UTF-8 without a byte order mark needs no decoding, so the blob can be used directly as
+    // long as it is zero terminated like a decoded copy would be. This avoids copying files
+    // that are loaded by mapping them into memory, and the source file then holds the mapping
+    // (see MappedFileBlob for when that is safe).
+    if (type == CharEncodeType::UTF8 && offset == 0 && _isZeroTerminated(blob))
+    {
+        m_contentBlob = blob;
+        m_content = UnownedStringSlice((char const*)rawContentBegin, rawContentSize);
+        return;
+    }
+
     List<char> decodedBuffer;
     CharEncoding::getEncoding(type)->decode(
         rawContentBegin + offset,
@@ -0,0 +1,8 @@
+#include "slang-allocator.h"
+
+namespace Slang
+{
+
+thread_local ptrdiff_t ContainerMemory::s_allocatedOnThread = 0;
+
+} // namespace Slang
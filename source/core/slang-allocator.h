@@ -3,11 +3,13 @@
 
 #include "slang-common.h"
 
+#include <stddef.h>
 #include <stdlib.h>
 #if SLANG_WINDOWS_FAMILY
 #include <malloc.h>
 #endif
 
+#include <memory>
 #include <type_traits>
 
 namespace Slang
@@ -34,6 +36,62 @@ inline void alignedDeallocate(void* ptr)
 #endif
 }
 
+/** Counts the memory of container buffers (such as those of List and Dictionary) allocated and
+freed on the current thread. The memory taken by some work on a thread is the difference between
+the count before and after it (see MemoryAccounting::Snapshot).
+
+A buffer freed on a different thread from the one that allocated it lowers the count of the
+freeing thread, so the count of a thread can go below zero.
+*/
+struct ContainerMemory
+{
+    /// Record that sizeInBytes of container memory has been allocated on this thread
+    static void add(size_t sizeInBytes) { s_allocatedOnThread += ptrdiff_t(sizeInBytes); }
+    /// Record that sizeInBytes of container memory has been freed on this thread
+    static void remove(size_t sizeInBytes) { s_allocatedOnThread -= ptrdiff_t(sizeInBytes); }
+    /// Get the container memory allocated on this thread, less what has been freed on it
+    static ptrdiff_t getAllocatedOnThread() { return s_allocatedOnThread; }
+
+    static thread_local ptrdiff_t s_allocatedOnThread;
+};
+
+/// An allocator for std style containers, that counts the memory with ContainerMemory
+template<typename T>
+class ContainerStdAllocator
+{
+public:
+    typedef T value_type;
+
+    ContainerStdAllocator() = default;
+    template<typename U>
+    ContainerStdAllocator(const ContainerStdAllocator<U>&)
+    {
+    }
+
+    T* allocate(size_t count)
+    {
+        T* ptr = std::allocator<T>().allocate(count);
+        ContainerMemory::add(count * sizeof(T));
+        return ptr;
+    }
+    void deallocate(T* ptr, size_t count)
+    {
+        std::allocator<T>().deallocate(ptr, count);
+        ContainerMemory::remove(count * sizeof(T));
+    }
+
+    template<typename U>
+    bool operator==(const ContainerStdAllocator<U>&) const
+    {
+        return true;
+    }
+    template<typename U>
+    bool operator!=(const ContainerStdAllocator<U>&) const
+    {
+        return false;
+    }
+};
+
 class StandardAllocator
 {
 public:
@@ -58,6 +116,7 @@ public:
     {
         TAllocator allocator;
         T* rs = (T*)allocator.allocate(count * sizeof(T));
+        ContainerMemory::add(count * sizeof(T));
         if (!std::is_trivially_constructible<T>::value)
         {
             for (Index i = 0; i < count; i++)
@@ -74,6 +133,7 @@ public:
                 ptr[i].~T();
         }
         allocator.deallocate(ptr);
+        ContainerMemory::remove(count * sizeof(T));
     }
 };
 
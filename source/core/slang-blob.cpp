@@ -171,6 +171,26 @@ void* RawBlob::getObject(const Guid& guid)
     return nullptr;
 }
 
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! UnownedRawBlob !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+void* UnownedRawBlob::castAs(const SlangUUID& guid)
+{
+    if (auto intf = getInterface(guid))
+    {
+        return intf;
+    }
+    return getObject(guid);
+}
+
+void* UnownedRawBlob::getObject(const Guid& guid)
+{
+    if (guid == SlangTerminatedChars::getTypeGuid() && m_isTerminated)
+    {
+        return const_cast<void*>(m_data);
+    }
+    return nullptr;
+}
+
 /* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! ScopeBlob !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
 
 void* ScopeBlob::castAs(const SlangUUID& guid)
@@ -293,6 +293,9 @@ protected:
 class UnownedRawBlob : public BlobBase
 {
 public:
+    // ICastable
+    virtual SLANG_NO_THROW void* SLANG_MCALL castAs(const SlangUUID& guid) SLANG_OVERRIDE;
+
     // ISlangBlob
     SLANG_NO_THROW void const* SLANG_MCALL getBufferPointer() SLANG_OVERRIDE { return m_data; }
     SLANG_NO_THROW size_t SLANG_MCALL getBufferSize() SLANG_OVERRIDE { return m_dataSizeInBytes; }
@@ -302,7 +305,18 @@ public:
         return ComPtr<ISlangBlob>(new UnownedRawBlob(inData, size));
     }
 
+    /// Create from chars that are followed by a 0 byte (which isn't part of the blob), so the
+    /// blob can be accessed as SlangTerminatedChars.
+    static inline ComPtr<ISlangBlob> createTerminated(const char* chars, size_t size)
+    {
+        auto blob = new UnownedRawBlob(chars, size);
+        blob->m_isTerminated = true;
+        return ComPtr<ISlangBlob>(blob);
+    }
+
 protected:
+    void* getObject(const Guid& guid);
+
     // Ctor
     UnownedRawBlob(const void* data, size_t size)
         : m_data(data), m_dataSizeInBytes(size)
@@ -313,6 +327,7 @@ protected:
 
     const void* m_data;
     size_t m_dataSizeInBytes;
+    bool m_isTerminated = false; ///< True if the data is followed by a 0 byte
 };
 
 /** A Blob that has no ref counting and exists typically for entire execution.
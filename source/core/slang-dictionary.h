@@ -106,7 +106,8 @@ template<
     typename KeyEqual = std::equal_to<TKey>>
 class Dictionary
 {
-    using InnerMap = ankerl::unordered_dense::map<TKey, TValue, Hash, KeyEqual>;
+    using InnerMap = ankerl::unordered_dense::
+        map<TKey, TValue, Hash, KeyEqual, ContainerStdAllocator<std::pair<TKey, TValue>>>;
     using ThisType = Dictionary<TKey, TValue, Hash, KeyEqual>;
     InnerMap map;
 
@@ -1,9 +1,18 @@
 #include "slang-file-system.h"
 
 #include "../core/slang-io.h"
+#include "../core/slang-mapped-file-blob.h"
 #include "../core/slang-string-util.h"
 #include "slang-com-ptr.h"
 
+#if defined(__linux__) || defined(__CYGWIN__) || SLANG_APPLE_FAMILY
+#include <atomic>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace Slang
 {
 
@@ -202,6 +211,16 @@ SlangResult OSFileSystem::loadFile(char const* pathIn, ISlangBlob** outBlob)
         return SLANG_E_NOT_FOUND;
     }
 
+    // Large files are mapped, so they aren't copied and are only paged in as they are read
+    {
+        ComPtr<ISlangBlob> mappedBlob;
+        if (SLANG_SUCCEEDED(MappedFileBlob::create(path, kMinMappedFileSize, mappedBlob)))
+        {
+            *outBlob = mappedBlob.detach();
+            return SLANG_OK;
+        }
+    }
+
     ScopedAllocation alloc;
     SLANG_RETURN_ON_FAIL(File::readAllBytes(path, alloc));
     *outBlob = RawBlob::moveCreate(alloc).detach();
@@ -253,13 +272,86 @@ SlangResult OSFileSystem::enumeratePathContents(
     return SLANG_OK;
 }
 
+#if defined(__linux__) || defined(__CYGWIN__) || SLANG_APPLE_FAMILY
+/// Write a new file in the same directory as path, and rename it over path.
+/// If fileStat is set it's for the file being replaced, and its mode and owner are kept.
+static SlangResult _replaceFile(
+    const String& path,
+    const struct stat* fileStat,
+    const void* data,
+    size_t size)
+{
+    static std::atomic<uint32_t> counter{0};
+
+    StringBuilder tempPath;
+    tempPath << path << "." << int64_t(::getpid()) << "." << (counter++) << ".tmp";
+
+    // Created with the same permissions as a new file written by FileStream
+    const int fd = ::open(tempPath.getBuffer(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0666);
+    if (fd < 0)
+    {
+        return SLANG_E_CANNOT_OPEN;
+    }
+
+    bool ok = true;
+    if (fileStat)
+    {
+        ok = ::fchmod(fd, fileStat->st_mode & 07777) == 0;
+        // Keeping the owner needs privileges the process may not have, so is best effort
+        if (ok && ::fchown(fd, fileStat->st_uid, fileStat->st_gid) != 0)
+        {
+            // Written with the process' owner instead
+        }
+    }
+
+    const char* cur = (const char*)data;
+    size_t remaining = size;
+    while (ok && remaining > 0)
+    {
+        const ssize_t written = ::write(fd, cur, remaining);
+        if (written < 0)
+        {
+            ok = (errno == EINTR);
+            continue;
+        }
+        cur += written;
+        remaining -= size_t(written);
+    }
+
+    ok = (::close(fd) == 0) && ok;
+    if (ok)
+    {
+        ok = ::rename(tempPath.getBuffer(), path.getBuffer()) == 0;
+    }
+    if (!ok)
+    {
+        ::unlink(tempPath.getBuffer());
+        return SLANG_FAIL;
+    }
+    return SLANG_OK;
+}
+#endif
+
 SlangResult OSFileSystem::saveFile(const char* pathIn, const void* data, size_t size)
 {
     SLANG_RETURN_ON_FAIL(_checkMutable(m_style));
     const String path = _fixPathDelimiters(pathIn);
+
+#if defined(__linux__) || defined(__CYGWIN__) || SLANG_APPLE_FAMILY
+    // The file may be mapped by a blob from loadFile. Truncating it would make accessing the
+    // mapping fault, so the contents are written to a temporary file which then replaces it.
+    // Symbolic and hard links are written through as before.
+    struct stat fileStat;
+    const bool exists = ::lstat(path.getBuffer(), &fileStat) == 0;
+    if (!exists || (S_ISREG(fileStat.st_mode) && fileStat.st_nlink == 1))
+    {
+        return _replaceFile(path, exists ? &fileStat : nullptr, data, size);
+    }
+#endif
+
     FileStream stream;
     SLANG_RETURN_ON_FAIL(
-        stream.init(pathIn, FileMode::Create, FileAccess::Write, FileShare::ReadWrite));
+        stream.init(path, FileMode::Create, FileAccess::Write, FileShare::ReadWrite));
     SLANG_RETURN_ON_FAIL(stream.write(data, size));
     return SLANG_OK;
 }
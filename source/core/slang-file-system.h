@@ -65,6 +65,10 @@ public:
     virtual SLANG_NO_THROW SlangResult SLANG_MCALL remove(const char* path) SLANG_OVERRIDE;
     virtual SLANG_NO_THROW SlangResult SLANG_MCALL createDirectory(const char* path) SLANG_OVERRIDE;
 
+    /// Files at least this size are loaded by mapping them into memory (where supported), rather
+    /// than reading them into a copy. See MappedFileBlob.
+    static const size_t kMinMappedFileSize = 64 * 1024;
+
     /// Get a default instance
     static ISlangFileSystem* getLoadSingleton() { return &g_load; }
     static ISlangFileSystemExt* getExtSingleton() { return &g_ext; }
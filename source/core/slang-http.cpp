@@ -384,13 +384,28 @@ SlangResult HTTPPacketConnection::waitForResult(Int timeOutInMs)
     return m_readResult;
 }
 
+UnownedStringSlice HTTPPacketConnection::getContentAsTerminatedText()
+{
+    SLANG_ASSERT(m_readState == ReadState::Done);
+    const Index contentLength = Index(m_readHeader.m_contentLength);
+    if (!m_isContentTerminated)
+    {
+        m_readStream->insert(contentLength, 0);
+        m_isContentTerminated = true;
+    }
+    const char* chars = (const char*)m_readStream->getBuffer();
+    return UnownedStringSlice(chars, chars + contentLength);
+}
+
 void HTTPPacketConnection::consumeContent()
 {
     SLANG_ASSERT(m_readState == ReadState::Done);
     if (m_readState == ReadState::Done)
     {
-        // Consume the content
-        m_readStream->consume(Index(m_readHeader.m_contentLength));
+        // Consume the content, and the 0 byte after it if it was inserted
+        m_readStream->consume(
+            Index(m_readHeader.m_contentLength) + (m_isContentTerminated ? 1 : 0));
+        m_isContentTerminated = false;
         // Back looking for the header again
         m_readState = ReadState::Header;
     }
@@ -129,6 +129,13 @@ public:
             m_readHeader.m_contentLength);
     }
 
+    /// Get the content as text that is followed by a 0 byte, so it can be used where zero
+    /// terminated text is needed without copying it. The 0 byte is written into the read buffer
+    /// after the content (moving any bytes of the next packet that have been read), and is
+    /// consumed with the content. As with getContent, the text is only valid until update or
+    /// consumeContent is called.
+    UnownedStringSlice getContentAsTerminatedText();
+
     /// Write. Will potentially block if write stream is blocking.
     SlangResult write(const void* content, size_t sizeInBytes);
 
@@ -172,6 +179,7 @@ protected:
     HTTPHeader m_readHeader;
 
     ReadState m_readState;
+    bool m_isContentTerminated = false; ///< True if a 0 byte was inserted after the content
 
     RefPtr<BufferedReadStream> m_readStream;
     RefPtr<Stream> m_writeStream;
@@ -64,6 +64,25 @@ namespace Slang
 #endif
 }
 
+/* static */ SlangResult File::rename(const String& oldFileName, const String& newFileName)
+{
+#ifdef _WIN32
+    // https://learn.microsoft.com/en-us/windows/win32/api/winbase/nf-winbase-movefileexa
+    if (MoveFileExA(oldFileName.getBuffer(), newFileName.getBuffer(), MOVEFILE_REPLACE_EXISTING))
+    {
+        return SLANG_OK;
+    }
+    return SLANG_FAIL;
+#else
+    // https://linux.die.net/man/3/rename
+    if (::rename(oldFileName.getBuffer(), newFileName.getBuffer()) == 0)
+    {
+        return SLANG_OK;
+    }
+    return SLANG_FAIL;
+#endif
+}
+
 
 #ifdef _WIN32
 /* static */ SlangResult File::generateTemporary(
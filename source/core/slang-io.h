@@ -30,6 +30,11 @@ public:
 
     static SlangResult remove(const String& fileName);
 
+    /// Rename the file at oldFileName to newFileName, replacing any file already there. On most
+    /// platforms the file at newFileName is replaced atomically, so other readers see either
+    /// the old or the new file, never a partially written one.
+    static SlangResult rename(const String& oldFileName, const String& newFileName);
+
     static SlangResult makeExecutable(const String& fileName);
 
     /// Creates a temporary file typically in some way based on the prefix
@@ -0,0 +1,324 @@
+// slang-local-socket.cpp
+#include "slang-local-socket.h"
+
+#include "slang-com-helper.h"
+#include "slang-common.h"
+
+#if !SLANG_WINDOWS_FAMILY
+#include <errno.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace Slang
+{
+
+#if !SLANG_WINDOWS_FAMILY
+
+namespace
+{ // anonymous
+
+#ifdef MSG_NOSIGNAL
+static const int kSendFlags = MSG_NOSIGNAL;
+#else
+static const int kSendFlags = 0;
+#endif
+
+class LocalSocketStream : public Stream
+{
+public:
+    // Stream
+    virtual Int64 getPosition() SLANG_OVERRIDE { return 0; }
+    virtual SlangResult seek(SeekOrigin origin, Int64 offset) SLANG_OVERRIDE
+    {
+        SLANG_UNUSED(origin);
+        SLANG_UNUSED(offset);
+        return SLANG_E_NOT_AVAILABLE;
+    }
+    virtual SlangResult read(void* buffer, size_t length, size_t& outReadBytes) SLANG_OVERRIDE;
+    virtual SlangResult write(const void* buffer, size_t length) SLANG_OVERRIDE;
+    virtual bool isEnd() SLANG_OVERRIDE { return m_fd < 0; }
+    virtual bool canRead() SLANG_OVERRIDE { return m_fd >= 0; }
+    virtual bool canWrite() SLANG_OVERRIDE { return m_fd >= 0; }
+    virtual void close() SLANG_OVERRIDE;
+    virtual SlangResult flush() SLANG_OVERRIDE { return SLANG_OK; }
+
+    LocalSocketStream(int fd)
+        : m_fd(fd)
+    {
+    }
+    ~LocalSocketStream() { close(); }
+
+protected:
+    int m_fd;
+};
+
+void LocalSocketStream::close()
+{
+    if (m_fd >= 0)
+    {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}
+
+SlangResult LocalSocketStream::read(void* buffer, size_t length, size_t& outReadBytes)
+{
+    outReadBytes = 0;
+    if (m_fd < 0)
+    {
+        return SLANG_OK;
+    }
+
+    pollfd pollInfo;
+    pollInfo.fd = m_fd;
+    pollInfo.events = POLLIN;
+    pollInfo.revents = 0;
+
+    // Return immediately, so reads don't block
+    const int pollResult = ::poll(&pollInfo, 1, 0);
+    if (pollResult < 0)
+    {
+        return (errno == EINTR) ? SLANG_OK : SLANG_FAIL;
+    }
+    if (pollResult == 0)
+    {
+        return SLANG_OK;
+    }
+
+    if (pollInfo.revents & POLLIN)
+    {
+        const auto count = ::recv(m_fd, buffer, length, 0);
+        if (count < 0)
+        {
+            const int err = errno;
+            return (err == EAGAIN || err == EWOULDBLOCK || err == EINTR) ? SLANG_OK : SLANG_FAIL;
+        }
+        outReadBytes = size_t(count);
+
+        // A zero sized read when bytes were wanted means the other end has closed.
+        if (count > 0 || length == 0)
+        {
+            return SLANG_OK;
+        }
+    }
+
+    close();
+    return SLANG_OK;
+}
+
+SlangResult LocalSocketStream::write(const void* buffer, size_t length)
+{
+    if (m_fd < 0)
+    {
+        return SLANG_FAIL;
+    }
+
+    const char* cur = (const char*)buffer;
+    while (length > 0)
+    {
+        const auto count = ::send(m_fd, cur, length, kSendFlags);
+        if (count < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            // Most likely the other end has closed
+            close();
+            return SLANG_FAIL;
+        }
+        cur += count;
+        length -= size_t(count);
+    }
+    return SLANG_OK;
+}
+
+static SlangResult _initAddress(const String& path, sockaddr_un& outAddr)
+{
+    ::memset(&outAddr, 0, sizeof(outAddr));
+    outAddr.sun_family = AF_UNIX;
+
+    // Must fit, including the terminating zero
+    if (size_t(path.getLength()) >= sizeof(outAddr.sun_path))
+    {
+        return SLANG_E_INVALID_ARG;
+    }
+    ::memcpy(outAddr.sun_path, path.getBuffer(), path.getLength());
+    return SLANG_OK;
+}
+
+static int _createSocket()
+{
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+#ifdef SO_NOSIGPIPE
+    // Targets without MSG_NOSIGNAL, so writing to a closed connection doesn't raise SIGPIPE
+    if (fd >= 0)
+    {
+        int value = 1;
+        ::setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &value, sizeof(value));
+    }
+#endif
+    return fd;
+}
+
+/* Remove a socket file left behind by a server that didn't shut down cleanly, so that `path` can
+be bound. Anything that isn't a socket is left alone, as is a socket that another server is still
+accepting connections on. */
+static SlangResult _removeStaleSocket(const String& path, const sockaddr_un& addr)
+{
+    struct stat info;
+    if (::lstat(path.getBuffer(), &info) != 0)
+    {
+        // Nothing there
+        return (errno == ENOENT) ? SLANG_OK : SLANG_FAIL;
+    }
+    if (!S_ISSOCK(info.st_mode))
+    {
+        return SLANG_E_INVALID_ARG;
+    }
+
+    const int fd = _createSocket();
+    if (fd < 0)
+    {
+        return SLANG_FAIL;
+    }
+    const int connectResult = ::connect(fd, (const sockaddr*)&addr, sizeof(addr));
+    const int connectErr = errno;
+    ::close(fd);
+
+    if (connectResult == 0)
+    {
+        // There is a live server on the socket
+        return SLANG_E_NOT_AVAILABLE;
+    }
+    if (connectErr != ECONNREFUSED)
+    {
+        return SLANG_FAIL;
+    }
+
+    return (::unlink(path.getBuffer()) == 0 || errno == ENOENT) ? SLANG_OK : SLANG_FAIL;
+}
+
+} // namespace
+
+/* static */ bool LocalSocketServer::isAvailable()
+{
+    return true;
+}
+
+SlangResult LocalSocketServer::listen(const String& path)
+{
+    close();
+
+    sockaddr_un addr;
+    SLANG_RETURN_ON_FAIL(_initAddress(path, addr));
+
+    SLANG_RETURN_ON_FAIL(_removeStaleSocket(path, addr));
+
+    const int fd = _createSocket();
+    if (fd < 0)
+    {
+        return SLANG_FAIL;
+    }
+
+    if (::bind(fd, (const sockaddr*)&addr, sizeof(addr)) != 0 || ::listen(fd, 16) != 0)
+    {
+        ::close(fd);
+        return SLANG_FAIL;
+    }
+
+    m_fd = fd;
+    m_path = path;
+    return SLANG_OK;
+}
+
+SlangResult LocalSocketServer::accept(RefPtr<Stream>& outStream)
+{
+    if (m_fd < 0)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    for (;;)
+    {
+        const int fd = ::accept(m_fd, nullptr, nullptr);
+        if (fd >= 0)
+        {
+            outStream = new LocalSocketStream(fd);
+            return SLANG_OK;
+        }
+        if (errno != EINTR && errno != ECONNABORTED)
+        {
+            return SLANG_FAIL;
+        }
+    }
+}
+
+void LocalSocketServer::close()
+{
+    if (m_fd >= 0)
+    {
+        ::close(m_fd);
+        ::unlink(m_path.getBuffer());
+        m_fd = -1;
+        m_path = String();
+    }
+}
+
+/* static */ SlangResult LocalSocketServer::connect(const String& path, RefPtr<Stream>& outStream)
+{
+    sockaddr_un addr;
+    SLANG_RETURN_ON_FAIL(_initAddress(path, addr));
+
+    const int fd = _createSocket();
+    if (fd < 0)
+    {
+        return SLANG_FAIL;
+    }
+
+    if (::connect(fd, (const sockaddr*)&addr, sizeof(addr)) != 0)
+    {
+        ::close(fd);
+        return SLANG_E_NOT_FOUND;
+    }
+
+    outStream = new LocalSocketStream(fd);
+    return SLANG_OK;
+}
+
+#else
+
+/* static */ bool LocalSocketServer::isAvailable()
+{
+    return false;
+}
+
+SlangResult LocalSocketServer::listen(const String& path)
+{
+    SLANG_UNUSED(path);
+    return SLANG_E_NOT_AVAILABLE;
+}
+
+SlangResult LocalSocketServer::accept(RefPtr<Stream>& outStream)
+{
+    SLANG_UNUSED(outStream);
+    return SLANG_E_NOT_AVAILABLE;
+}
+
+void LocalSocketServer::close() {}
+
+/* static */ SlangResult LocalSocketServer::connect(const String& path, RefPtr<Stream>& outStream)
+{
+    SLANG_UNUSED(path);
+    SLANG_UNUSED(outStream);
+    return SLANG_E_NOT_AVAILABLE;
+}
+
+#endif
+
+} // namespace Slang
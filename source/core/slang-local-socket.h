@@ -0,0 +1,52 @@
+#ifndef SLANG_CORE_LOCAL_SOCKET_H
+#define SLANG_CORE_LOCAL_SOCKET_H
+
+#include "slang-stream.h"
+
+namespace Slang
+{
+
+/* Local (Unix domain) sockets, that allow processes on the same machine to communicate via a
+path in the file system.
+
+Connections are exposed as a `Stream` that can be both read and written. Like the pipe streams
+used for processes, reading does not block - if there is no data available a read will return 0
+bytes. This means a connection stream can be used with `BufferedReadStream` and
+`HTTPPacketConnection`.
+
+Currently only available on unix-like targets. On other targets all functions return
+SLANG_E_NOT_AVAILABLE. */
+class LocalSocketServer : public RefObject
+{
+public:
+    /// Listen for connections on the socket at `path`. A stale socket file at the path, that no
+    /// server is accepting connections on, is replaced. Fails with SLANG_E_INVALID_ARG if
+    /// something other than a socket is at the path, and SLANG_E_NOT_AVAILABLE if another server
+    /// is listening there.
+    SlangResult listen(const String& path);
+
+    /// Block until a client connects, and return the stream for the connection
+    SlangResult accept(RefPtr<Stream>& outStream);
+
+    /// Stop listening, and remove the socket file
+    void close();
+
+    /// Get the path being listened on
+    const String& getPath() const { return m_path; }
+
+    /// Connect to a server listening at `path`
+    static SlangResult connect(const String& path, RefPtr<Stream>& outStream);
+
+    /// True if local sockets are available on this target
+    static bool isAvailable();
+
+    ~LocalSocketServer() { close(); }
+
+protected:
+    int m_fd = -1;
+    String m_path;
+};
+
+} // namespace Slang
+
+#endif // SLANG_CORE_LOCAL_SOCKET_H
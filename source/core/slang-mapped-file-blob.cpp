@@ -0,0 +1,111 @@
+#include "slang-mapped-file-blob.h"
+
+#if defined(__linux__) || defined(__CYGWIN__) || SLANG_APPLE_FAMILY
+#define SLANG_HAS_MAPPED_FILES 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define SLANG_HAS_MAPPED_FILES 0
+#endif
+
+namespace Slang
+{
+
+// NOTE! Files are not mapped on Windows. A mapped view there prevents the file from being
+// truncated or replaced, so saving over a file that had been loaded (and is perhaps still held
+// in a cache) would fail.
+
+void* MappedFileBlob::castAs(const SlangUUID& guid)
+{
+    if (auto intf = getInterface(guid))
+    {
+        return intf;
+    }
+    return getObject(guid);
+}
+
+void* MappedFileBlob::getObject(const Guid& guid)
+{
+    // The mapping is always followed by zeros, see create
+    if (guid == SlangTerminatedChars::getTypeGuid())
+    {
+        return const_cast<void*>(m_data);
+    }
+    return nullptr;
+}
+
+MappedFileBlob::~MappedFileBlob()
+{
+#if SLANG_HAS_MAPPED_FILES
+    ::munmap(const_cast<void*>(m_data), m_dataSizeInBytes);
+#endif
+}
+
+/* static */ SlangResult MappedFileBlob::create(
+    const String& path,
+    size_t minSizeInBytes,
+    ComPtr<ISlangBlob>& outBlob)
+{
+#if SLANG_HAS_MAPPED_FILES
+    const int fd = ::open(path.getBuffer(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return SLANG_E_NOT_FOUND;
+    }
+
+    struct stat fileStat;
+    if (::fstat(fd, &fileStat) != 0 || !S_ISREG(fileStat.st_mode))
+    {
+        ::close(fd);
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    const UInt64 fileSize = UInt64(fileStat.st_size);
+    const UInt64 pageSize = UInt64(::sysconf(_SC_PAGESIZE));
+
+    // If the size is a multiple of the page size there is nothing mapped after the contents, so
+    // they can't be zero terminated. Empty files can't be mapped at all.
+    if (fileSize == 0 || fileSize < minSizeInBytes || fileSize > UInt64(~size_t(0)) ||
+        (fileSize % pageSize) == 0)
+    {
+        ::close(fd);
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    const size_t sizeInBytes = size_t(fileSize);
+    void* data = ::mmap(nullptr, sizeInBytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED)
+    {
+        ::close(fd);
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    // If the file was truncated or rewritten while it was being mapped, reading the mapping
+    // could fault, so use a copy instead.
+    struct stat mappedStat;
+    const bool isUnchanged = ::fstat(fd, &mappedStat) == 0 &&
+                             mappedStat.st_size == fileStat.st_size &&
+                             mappedStat.st_mtime == fileStat.st_mtime;
+
+    // The mapping holds its own reference to the file
+    ::close(fd);
+
+    if (!isUnchanged)
+    {
+        ::munmap(data, sizeInBytes);
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    outBlob = ComPtr<ISlangBlob>(new MappedFileBlob(data, sizeInBytes));
+    return SLANG_OK;
+#else
+    SLANG_UNUSED(path);
+    SLANG_UNUSED(minSizeInBytes);
+    SLANG_UNUSED(outBlob);
+    return SLANG_E_NOT_AVAILABLE;
+#endif
+}
+
+} // namespace Slang
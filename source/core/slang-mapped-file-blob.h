@@ -0,0 +1,59 @@
+#ifndef SLANG_CORE_MAPPED_FILE_BLOB_H
+#define SLANG_CORE_MAPPED_FILE_BLOB_H
+
+#include "slang-blob.h"
+
+namespace Slang
+{
+
+/** A blob whose contents are a read-only memory mapping of a file.
+
+The mapping is held until the blob is released, so the contents are only paged in as they are
+read, and are shared with any other process mapping the same file.
+
+Only files whose size isn't a multiple of the page size are mapped. The remainder of the last
+page is zero filled, so the contents are always zero terminated, like a blob read with
+File::readAllBytes.
+
+The file must not be truncated or written in place while it is mapped: reading the mapping
+after a truncation raises SIGBUS, and pages that haven't been read yet show later writes.
+Replacing the file is fine, as the mapping continues to refer to the original contents, and
+OSFileSystem::saveFile replaces files (by writing a temporary file and renaming it) for this
+reason. SourceFile and CacheFileSystem keep mapped blobs without copying them.
+*/
+class MappedFileBlob : public BlobBase
+{
+public:
+    // ICastable
+    virtual SLANG_NO_THROW void* SLANG_MCALL castAs(const SlangUUID& guid) SLANG_OVERRIDE;
+
+    // ISlangBlob
+    SLANG_NO_THROW void const* SLANG_MCALL getBufferPointer() SLANG_OVERRIDE { return m_data; }
+    SLANG_NO_THROW size_t SLANG_MCALL getBufferSize() SLANG_OVERRIDE { return m_dataSizeInBytes; }
+
+    /// Map the file at path, if its size is at least minSizeInBytes.
+    /// Returns SLANG_E_NOT_AVAILABLE if the file is too small, can't be mapped, or mapping isn't
+    /// supported on the platform. The file can then be read with File::readAllBytes instead.
+    static SlangResult create(
+        const String& path,
+        size_t minSizeInBytes,
+        ComPtr<ISlangBlob>& outBlob);
+
+    /// Dtor
+    ~MappedFileBlob();
+
+protected:
+    MappedFileBlob(const void* data, size_t size)
+        : m_data(data), m_dataSizeInBytes(size)
+    {
+    }
+
+    void* getObject(const Guid& guid);
+
+    const void* m_data;
+    size_t m_dataSizeInBytes;
+};
+
+} // namespace Slang
+
+#endif // SLANG_CORE_MAPPED_FILE_BLOB_H
@@ -0,0 +1,104 @@
+#include "slang-memory-accounting.h"
+
+namespace Slang
+{
+
+MemoryAccounting::MemoryAccounting(MemoryAllocator* allocator)
+    : m_allocator(allocator ? allocator : new MemoryAllocator)
+{
+    for (auto& used : m_used)
+    {
+        used.store(0);
+    }
+}
+
+MemoryAccounting::~MemoryAccounting()
+{
+    SLANG_ASSERT(m_totalUsed.load() == 0);
+}
+
+MemoryAccounting::Snapshot MemoryAccounting::getSnapshot() const
+{
+    Snapshot snapshot;
+    for (Index i = 0; i < Index(Category::CountOf); ++i)
+    {
+        snapshot.used[i] = m_used[i].load();
+    }
+    snapshot.totalUsed = m_totalUsed.load();
+    snapshot.containersAllocatedOnThread = ContainerMemory::getAllocatedOnThread();
+    return snapshot;
+}
+
+size_t MemoryAccounting::getUsedSince(const Snapshot& snapshot, Category category) const
+{
+    const size_t used = getUsed(category);
+    const size_t usedBefore = snapshot.used[Index(category)];
+    return used > usedBefore ? used - usedBefore : 0;
+}
+
+size_t MemoryAccounting::getTotalUsedSince(const Snapshot& snapshot) const
+{
+    const size_t totalUsed = getTotalUsed();
+    return totalUsed > snapshot.totalUsed ? totalUsed - snapshot.totalUsed : 0;
+}
+
+/* static */ size_t MemoryAccounting::getContainersUsedSince(const Snapshot& snapshot)
+{
+    const ptrdiff_t used =
+        ContainerMemory::getAllocatedOnThread() - snapshot.containersAllocatedOnThread;
+    return used > 0 ? size_t(used) : 0;
+}
+
+/* static */ const char* MemoryAccounting::getCategoryName(Category category)
+{
+    switch (category)
+    {
+    case Category::ASTArena:
+        return "AST";
+    case Category::IRArena:
+        return "IR";
+    case Category::Other:
+        return "other";
+    default:
+        return "unknown";
+    }
+}
+
+void* MemoryAccounting::allocate(Category category, size_t sizeInBytes)
+{
+    void* ptr = m_allocator->allocate(sizeInBytes);
+    if (ptr)
+    {
+        _add(category, sizeInBytes);
+    }
+    return ptr;
+}
+
+void MemoryAccounting::deallocate(Category category, void* ptr, size_t sizeInBytes)
+{
+    if (ptr)
+    {
+        m_allocator->deallocate(ptr, sizeInBytes);
+        _remove(category, sizeInBytes);
+    }
+}
+
+void MemoryAccounting::_add(Category category, size_t sizeInBytes)
+{
+    m_used[Index(category)].fetch_add(sizeInBytes);
+    const size_t totalUsed = m_totalUsed.fetch_add(sizeInBytes) + sizeInBytes;
+
+    // Raise the peak, unless another thread has raised it further already
+    size_t peak = m_peakTotalUsed.load();
+    while (totalUsed > peak && !m_peakTotalUsed.compare_exchange_weak(peak, totalUsed))
+    {
+    }
+}
+
+void MemoryAccounting::_remove(Category category, size_t sizeInBytes)
+{
+    m_used[Index(category)].fetch_sub(sizeInBytes);
+    m_totalUsed.fetch_sub(sizeInBytes);
+}
+
+} // namespace Slang
@@ -0,0 +1,144 @@
+#ifndef SLANG_CORE_MEMORY_ACCOUNTING_H
+#define SLANG_CORE_MEMORY_ACCOUNTING_H
+
+#include "slang-allocator.h"
+#include "slang-com-ptr.h"
+#include "slang-smart-pointer.h"
+
+#include <atomic>
+#include <stdlib.h>
+
+namespace Slang
+{
+
+/** Allocates the large blocks of memory that MemoryArenas are built from.
+
+The default implementation uses the heap. Derive from it to take the memory from somewhere else,
+for example from a pool owned by an application, or to fail allocations past some size.
+*/
+class MemoryAllocator : public RefObject
+{
+public:
+    /// Allocate sizeInBytes, with at least the alignment of malloc. Returns nullptr on failure.
+    virtual void* allocate(size_t sizeInBytes) { return ::malloc(sizeInBytes); }
+    /// Free memory previously returned by allocate. sizeInBytes is the size that was requested.
+    virtual void deallocate(void* ptr, size_t sizeInBytes)
+    {
+        SLANG_UNUSED(sizeInBytes);
+        ::free(ptr);
+    }
+};
+
+/// A MemoryAllocator that takes its memory from an ISlangAllocator provided through the API
+class ComMemoryAllocator : public MemoryAllocator
+{
+public:
+    virtual void* allocate(size_t sizeInBytes) SLANG_OVERRIDE
+    {
+        return m_allocator->allocate(sizeInBytes);
+    }
+    virtual void deallocate(void* ptr, size_t sizeInBytes) SLANG_OVERRIDE
+    {
+        m_allocator->deallocate(ptr, sizeInBytes);
+    }
+
+    ComMemoryAllocator(ISlangAllocator* allocator)
+        : m_allocator(allocator)
+    {
+    }
+
+protected:
+    ComPtr<ISlangAllocator> m_allocator;
+};
+
+/** Keeps count of the memory in use by a session, split by what it is used for.
+
+MemoryArenas that have been given a MemoryAccounting (see MemoryArena::setAccounting) allocate
+and free their blocks through it. Memory is counted in whole blocks, so the count is what is held
+from the allocator, not what has been handed out from the arenas.
+
+The memory used by a piece of work, such as a compile, is found by taking a Snapshot when it
+starts and comparing against it with getUsedSince.
+
+Container buffers (see ContainerMemory) aren't allocated through the accounting, and are counted
+for the thread instead. A Snapshot also records that count, so that getContainersUsedSince gives
+the container memory taken on the thread since the snapshot.
+
+A MemoryAccounting isn't reference counted, as arenas using it may be created and destroyed on
+several threads. Its owner must keep it alive for longer than any arena using it. The counts can
+be updated from multiple threads.
+*/
+class MemoryAccounting
+{
+public:
+    enum class Category
+    {
+        ASTArena, ///< AST nodes
+        IRArena,  ///< IR instructions of IR modules
+        Other,    ///< Any other arena, such as the one holding SPIR-V as it is emitted
+        CountOf,
+    };
+
+    /// The memory in use at some point
+    struct Snapshot
+    {
+        size_t used[Index(Category::CountOf)] = {};
+        size_t totalUsed = 0;
+        /// ContainerMemory::getAllocatedOnThread when the snapshot was taken
+        ptrdiff_t containersAllocatedOnThread = 0;
+    };
+
+    /// Allocate memory for category through the allocator
+    void* allocate(Category category, size_t sizeInBytes);
+    /// Free memory previously allocated with allocate
+    void deallocate(Category category, void* ptr, size_t sizeInBytes);
+
+    /// Get the amount of memory in use for category
+    size_t getUsed(Category category) const { return m_used[Index(category)].load(); }
+    /// Get the amount of memory in use across all categories
+    size_t getTotalUsed() const { return m_totalUsed.load(); }
+    /// Get the largest amount of memory that has been in use at one time
+    size_t getPeakTotalUsed() const { return m_peakTotalUsed.load(); }
+
+    /// Get the memory in use now
+    Snapshot getSnapshot() const;
+    /// Get how much more memory is in use for category than at snapshot. 0 if less is in use.
+    size_t getUsedSince(const Snapshot& snapshot, Category category) const;
+    /// Get how much more memory is in use across all categories than at snapshot. 0 if less is
+    /// in use.
+    size_t getTotalUsedSince(const Snapshot& snapshot) const;
+    /// Get how much more container memory is allocated on this thread than at snapshot, which
+    /// must have been taken on this thread. 0 if less is allocated.
+    static size_t getContainersUsedSince(const Snapshot& snapshot);
+
+    /// Get the allocator memory comes from
+    MemoryAllocator* getAllocator() const { return m_allocator; }
+
+    /// Get the name of a category, for reporting
+    static const char* getCategoryName(Category category);
+
+    /// Ctor. If allocator is nullptr memory comes from the heap.
+    MemoryAccounting(MemoryAllocator* allocator = nullptr);
+
+    /// Dtor. All memory must have been returned.
+    ~MemoryAccounting();
+
+protected:
+    void _add(Category category, size_t sizeInBytes);
+    void _remove(Category category, size_t sizeInBytes);
+
+    RefPtr<MemoryAllocator> m_allocator;
+
+    std::atomic<size_t> m_used[Index(Category::CountOf)];
+    std::atomic<size_t> m_totalUsed{0};
+    std::atomic<size_t> m_peakTotalUsed{0};
+
+private:
+    // Disable
+    MemoryAccounting(const MemoryAccounting&) = delete;
+    void operator=(const MemoryAccounting&) = delete;
+};
+
+} // namespace Slang
+
+#endif // SLANG_CORE_MEMORY_ACCOUNTING_H
@@ -79,6 +79,9 @@ void MemoryArena::swapWith(ThisType& rhs)
     Swap(m_usedBlocks, rhs.m_usedBlocks);
 
     m_blockFreeList.swapWith(rhs.m_blockFreeList);
+
+    Swap(m_accounting, rhs.m_accounting);
+    Swap(m_accountingCategory, rhs.m_accountingCategory);
 }
 
 void MemoryArena::_resetCurrentBlock()
@@ -118,7 +121,7 @@ void MemoryArena::_deallocateBlocksPayload(Block* start)
     while (cur)
     {
         // Deallocate the block
-        ::free(cur->m_alloc);
+        _freeBlockMemory(cur);
         cur = cur->m_next;
     }
 }
@@ -130,7 +133,7 @@ void MemoryArena::_deallocateBlocks(Block* start)
     {
         Block* next = cur->m_next;
         // Deallocate the block
-        ::free(cur->m_alloc);
+        _freeBlockMemory(cur);
 
         m_blockFreeList.deallocate(cur);
         cur = next;
@@ -157,7 +160,7 @@ void MemoryArena::_deallocateBlock(Block* block)
     else
     {
         // Must be odd sized so free it
-        ::free(block->m_alloc);
+        _freeBlockMemory(block);
         // Free it in the block list
         m_blockFreeList.deallocate(block);
     }
@@ -258,7 +261,9 @@ MemoryArena::Block* MemoryArena::_newBlock(size_t allocSize, size_t alignment)
     }
 
     // Allocate the memory
-    uint8_t* alloc = (uint8_t*)::malloc(allocSize);
+    uint8_t* alloc = m_accounting
+                         ? (uint8_t*)m_accounting->allocate(m_accountingCategory, allocSize)
+                         : (uint8_t*)::malloc(allocSize);
     if (!alloc)
     {
         m_blockFreeList.deallocate(block);
@@ -279,6 +284,31 @@ MemoryArena::Block* MemoryArena::_newBlock(size_t allocSize, size_t alignment)
     return block;
 }
 
+void MemoryArena::_freeBlockMemory(Block* block)
+{
+    if (m_accounting)
+    {
+        // The size allocated is from m_alloc to m_end, see _newBlock
+        m_accounting->deallocate(
+            m_accountingCategory,
+            block->m_alloc,
+            size_t(block->m_end - block->m_alloc));
+    }
+    else
+    {
+        ::free(block->m_alloc);
+    }
+}
+
+void MemoryArena::setAccounting(MemoryAccounting* accounting, MemoryAccounting::Category category)
+{
+    // Blocks must be freed the same way they were allocated
+    assert(m_usedBlocks == nullptr && m_availableBlocks == nullptr);
+
+    m_accounting = accounting;
+    m_accountingCategory = category;
+}
+
 void MemoryArena::addExternalBlock(void* inData, size_t size)
 {
     // Allocate block
@@ -2,6 +2,7 @@
 #define SLANG_CORE_MEMORY_ARENA_H
 
 #include "slang-free-list.h"
+#include "slang-memory-accounting.h"
 #include "slang.h"
 
 #include <stdlib.h>
@@ -162,8 +163,19 @@ public:
     void rewindToCursor(const void* cursor);
 
     /// Add a block such that it will be freed when everything else is freed.
+    /// The block must have been allocated with malloc, or if the arena has accounting set, with
+    /// the accounting under the arena's category.
     void addExternalBlock(void* data, size_t size);
 
+    /// Allocate and free blocks through accounting, such that they are counted under category.
+    /// Must be set before anything is allocated from the arena. accounting isn't owned, and must
+    /// outlive the arena.
+    void setAccounting(MemoryAccounting* accounting, MemoryAccounting::Category category);
+    /// Get the accounting blocks are allocated with. Returns nullptr if they come from the heap.
+    MemoryAccounting* getAccounting() const { return m_accounting; }
+    /// Get the category blocks are counted under, if there is accounting
+    MemoryAccounting::Category getAccountingCategory() const { return m_accountingCategory; }
+
     // Swap this with rhs
     void swapWith(ThisType& rhs);
 
@@ -202,6 +214,9 @@ protected:
     /// Allocates a new block with allocSize and alignment
     Block* _newBlock(size_t allocSizeInBytes, size_t alignment);
 
+    /// Frees the memory of the block (but not the block itself)
+    void _freeBlockMemory(Block* block);
+
     void* _allocateAlignedFromNewBlock(size_t sizeInBytes, size_t alignment);
     void* _allocateAlignedFromNewBlockAndZero(size_t sizeInBytes, size_t alignment);
 
@@ -238,6 +253,10 @@ protected:
 
     FreeList m_blockFreeList; ///< Holds all of the blocks for fast allocation/free
 
+    /// If set, block memory is allocated and freed through it, otherwise through malloc/free
+    MemoryAccounting* m_accounting = nullptr;
+    MemoryAccounting::Category m_accountingCategory = MemoryAccounting::Category::Other;
+
 private:
     // Disable
     MemoryArena(const ThisType& rhs) = delete;
@@ -56,6 +56,11 @@ SlangResult PersistentCache::clear()
             {
                 Path::remove(fullPath);
             }
+            else if (type == Path::Type::Directory)
+            {
+                // The files derived from an entry
+                Path::removeNonEmpty(fullPath);
+            }
         }
     };
 
@@ -126,6 +131,7 @@ SlangResult PersistentCache::readEntry(const Key& key, ISlangBlob** outData)
     }
     else
     {
+        removeEntryFiles(key);
         cacheIndex.removeAt(entryIndex);
     }
 
@@ -169,17 +175,30 @@ SlangResult PersistentCache::writeEntry(const Key& key, ISlangBlob* data)
         }
     }
 
+    // If the entry is already in the cache its data is replaced, so files derived from the
+    // old data are removed.
+    Index existingEntryIndex =
+        cacheIndex.findFirstIndex([&key](const CacheEntry& entry) { return entry.key == key; });
+    if (existingEntryIndex >= 0)
+    {
+        Path::removeNonEmpty(getEntryFilesDirectory(key));
+    }
+
     // Write the cache entry.
     String entryFileName = getEntryFileName(key);
     SLANG_RETURN_ON_FAIL(
         File::writeAllBytes(entryFileName, data->getBufferPointer(), data->getBufferSize()));
 
     // Update the index.
-    if (m_maxEntryCount > 0 && cacheIndex.getCount() >= m_maxEntryCount)
+    if (existingEntryIndex >= 0)
+    {
+        cacheIndex[existingEntryIndex].age = 0;
+    }
+    else if (m_maxEntryCount > 0 && cacheIndex.getCount() >= m_maxEntryCount)
     {
         // Replace oldest entry.
         SLANG_ASSERT(oldestEntryIndex >= 0);
-        File::remove(getEntryFileName(cacheIndex[oldestEntryIndex].key));
+        removeEntryFiles(cacheIndex[oldestEntryIndex].key);
         cacheIndex[oldestEntryIndex] = CacheEntry{key, 0};
     }
     else
@@ -230,6 +249,19 @@ String PersistentCache::getEntryFileName(const Key& key)
     return str;
 }
 
+String PersistentCache::getEntryFilesDirectory(const Key& key)
+{
+    StringBuilder str;
+    str << m_cacheDirectory << "/" << key.toString() << "-files";
+    return str;
+}
+
+void PersistentCache::removeEntryFiles(const Key& key)
+{
+    File::remove(getEntryFileName(key));
+    Path::removeNonEmpty(getEntryFilesDirectory(key));
+}
+
 struct CacheIndexHeader
 {
     char magic[4];
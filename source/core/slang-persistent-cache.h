@@ -44,6 +44,8 @@ public:
     SlangResult clear();
 
     const Stats& getStats() const { return m_stats; }
+    /// Get the (simplified) root directory of the cache.
+    const String& getDirectory() const { return m_cacheDirectory; }
     void resetStats();
 
     /// Read an entry from the cache.
@@ -54,6 +56,11 @@ public:
     /// Returns SLANG_OK if successful.
     SlangResult writeEntry(const Key& key, ISlangBlob* data);
 
+    /// Get the directory for files derived from the entry for `key`, such as a copy of its data
+    /// that has to exist as a file of its own. The directory isn't created by the cache, but is
+    /// removed along with the entry when it is evicted, and when the cache is cleared.
+    String getEntryFilesDirectory(const Key& key);
+
 private:
     struct CacheEntry
     {
@@ -67,6 +74,9 @@ private:
 
     String getEntryFileName(const Key& key);
 
+    /// Remove the file of the entry for `key`, and the files derived from it
+    void removeEntryFiles(const Key& key);
+
     SlangResult readIndex(const String& fileName, CacheIndex& outIndex);
     SlangResult writeIndex(const String& fileName, const CacheIndex& index);
 
@@ -66,6 +66,7 @@ struct ListFuncs
                 void* oldBuffer = dstList.detachBuffer();
 
                 void* newBuffer = ::malloc(count * elementType->m_size);
+                ContainerMemory::add(count * elementType->m_size);
                 // Initialize it all first
                 typeFuncs.ctorArray(typeMap, elementType, newBuffer, count);
                 typeFuncs.copyArray(typeMap, elementType, newBuffer, oldBuffer, count);
@@ -79,6 +80,7 @@ struct ListFuncs
                     typeFuncs.dtorArray(typeMap, elementType, oldBuffer, dstCapacity);
 
                     ::free(oldBuffer);
+                    ContainerMemory::remove(dstCapacity * elementType->m_size);
                 }
             }
             else
@@ -123,6 +125,7 @@ struct ListFuncs
             {
                 typeFuncs.dtorArray(typeMap, elementType, buffer, capacity);
                 ::free(buffer);
+                ContainerMemory::remove(capacity * elementType->m_size);
             }
         }
     }
@@ -196,6 +199,7 @@ struct StructFuncs
                 void* oldBuffer = dstList.detachBuffer();
 
                 void* newBuffer = ::malloc(count * elementType->m_size);
+                ContainerMemory::add(count * elementType->m_size);
                 // Initialize it all first
                 typeFuncs.ctorArray(typeMap, elementType, newBuffer, count);
                 typeFuncs.copyArray(typeMap, elementType, newBuffer, oldBuffer, count);
@@ -209,6 +213,7 @@ struct StructFuncs
                     typeFuncs.dtorArray(typeMap, elementType, oldBuffer, dstCapacity);
 
                     ::free(oldBuffer);
+                    ContainerMemory::remove(dstCapacity * elementType->m_size);
                 }
             }
             else
@@ -253,6 +258,7 @@ struct StructFuncs
             {
                 typeFuncs.dtorArray(typeMap, elementType, buffer, capacity);
                 ::free(buffer);
+                ContainerMemory::remove(capacity * elementType->m_size);
             }
         }
     }
@@ -591,6 +597,7 @@ static bool _isStructDefault(const StructRttiInfo* type, const void* src)
     void* oldBuffer = dstList.detachBuffer();
 
     void* newBuffer = ::malloc(count * elementType->m_size);
+    ContainerMemory::add(count * elementType->m_size);
     // Initialize it all first
     typeFuncs.ctorArray(typeMap, elementType, newBuffer, count);
 
@@ -604,6 +611,7 @@ static bool _isStructDefault(const StructRttiInfo* type, const void* src)
     {
         typeFuncs.dtorArray(typeMap, elementType, oldBuffer, dstCapacity);
         ::free(oldBuffer);
+        ContainerMemory::remove(dstCapacity * elementType->m_size);
     }
 
     return SLANG_OK;
@@ -935,6 +943,14 @@ static bool _isStructDefault(const StructRttiInfo* type, const void* src)
 
     switch (rttiInfo->m_kind)
     {
+    case RttiInfo::Kind::String:
+        {
+            for (Index i = 0; i < count; ++i, dst += stride, src += stride)
+            {
+                *(String*)dst = *(const String*)src;
+            }
+            return;
+        }
     case RttiInfo::Kind::FixedArray:
         {
             const FixedArrayRttiInfo* fixedArrayRttiInfo =
@@ -1027,6 +1043,14 @@ static bool _isStructDefault(const StructRttiInfo* type, const void* src)
 
     switch (rttiInfo->m_kind)
     {
+    case RttiInfo::Kind::String:
+        {
+            for (Index i = 0; i < count; ++i, dst += stride)
+            {
+                ((String*)dst)->~String();
+            }
+            return;
+        }
     case RttiInfo::Kind::FixedArray:
         {
             const FixedArrayRttiInfo* fixedArrayRttiInfo =
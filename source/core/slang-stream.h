@@ -249,6 +249,8 @@ public:
 
     /// Consume bytes in the buffer.
     void consume(Index byteCount);
+    /// Insert a byte into the buffer at index (from the start of the unconsumed bytes)
+    void insert(Index index, Byte value) { m_buffer.insert(m_startIndex + index, value); }
 
     Byte* getBuffer() { return m_buffer.getBuffer() + m_startIndex; }
     const Byte* getBuffer() const { return m_buffer.getBuffer() + m_startIndex; }
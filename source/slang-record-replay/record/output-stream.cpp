@@ -1,7 +1,12 @@
 #include "output-stream.h"
 
+#include "../../core/slang-math.h"
 #include "../util/record-utility.h"
 
+#include <chrono>
+#include <csignal>
+#include <string.h>
+
 namespace SlangRecord
 {
 FileOutputStream::FileOutputStream(const Slang::String& fileName, bool append)
@@ -32,6 +37,223 @@ void FileOutputStream::write(const void* data, size_t len)
     SLANG_RECORD_CHECK(m_fileStream.write(data, len));
 }
 
+// The async streams that are open, so their pending data can be written out if the process
+// dies from a fatal signal. Slots are claimed and released with atomic exchanges, so the
+// signal handler can read them at any time.
+static const int kMaxCrashFlushStreams = 16;
+static std::atomic<AsyncFileOutputStream*> g_crashFlushStreams[kMaxCrashFlushStreams];
+
+static const int kFatalSignals[] = {
+    SIGABRT,
+    SIGFPE,
+    SIGILL,
+    SIGSEGV,
+#ifdef SIGBUS
+    SIGBUS,
+#endif
+};
+
+static void _onFatalSignal(int signal)
+{
+    std::signal(signal, SIG_DFL);
+    for (auto& slot : g_crashFlushStreams)
+    {
+        if (auto stream = slot.load(std::memory_order_acquire))
+        {
+            stream->waitUntilWritten(2000);
+        }
+    }
+    // With the default handler back, this ends the process as the signal would have.
+    std::raise(signal);
+}
+
+static void _installFatalSignalHandlers()
+{
+    static std::once_flag installed;
+    std::call_once(
+        installed,
+        []()
+        {
+            for (int fatalSignal : kFatalSignals)
+            {
+                // Don't replace a handler installed by the application
+                auto previous = std::signal(fatalSignal, _onFatalSignal);
+                if (previous != SIG_DFL && previous != SIG_ERR)
+                {
+                    std::signal(fatalSignal, previous);
+                }
+            }
+        });
+}
+
+static void _addCrashFlushStream(AsyncFileOutputStream* stream)
+{
+    _installFatalSignalHandlers();
+    for (auto& slot : g_crashFlushStreams)
+    {
+        AsyncFileOutputStream* expected = nullptr;
+        if (slot.compare_exchange_strong(expected, stream))
+        {
+            return;
+        }
+    }
+    SlangRecord::slangRecordLog(
+        SlangRecord::LogLevel::Debug,
+        "Too many async record streams, data pending at a crash may be lost\n");
+}
+
+static void _removeCrashFlushStream(AsyncFileOutputStream* stream)
+{
+    for (auto& slot : g_crashFlushStreams)
+    {
+        AsyncFileOutputStream* expected = stream;
+        if (slot.compare_exchange_strong(expected, nullptr))
+        {
+            return;
+        }
+    }
+}
+
+AsyncFileOutputStream::AsyncFileOutputStream(const Slang::String& fileName, size_t bufferSizeInBytes)
+    : m_fileStream(fileName)
+{
+    m_capacity = 1;
+    while (m_capacity < bufferSizeInBytes)
+    {
+        m_capacity <<= 1;
+    }
+    m_ringBuffer.setCount((Slang::Index)m_capacity);
+
+    m_writerThread = std::thread(&AsyncFileOutputStream::writerThreadFunc, this);
+    _addCrashFlushStream(this);
+}
+
+AsyncFileOutputStream::~AsyncFileOutputStream()
+{
+    _removeCrashFlushStream(this);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isClosing.store(true, std::memory_order_release);
+    }
+    m_dataAvailable.notify_one();
+    m_writerThread.join();
+}
+
+void AsyncFileOutputStream::publish(size_t writePos)
+{
+    {
+        // Taking the lock orders this with the writer thread checking for data before
+        // waiting, so the notification can't be missed.
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_writePos.store(writePos, std::memory_order_release);
+    }
+    m_dataAvailable.notify_one();
+}
+
+void AsyncFileOutputStream::write(const void* data, size_t len)
+{
+    const uint8_t* src = (const uint8_t*)data;
+    const size_t writePos = m_writePos.load(std::memory_order_relaxed);
+    size_t written = 0;
+
+    while (written < len)
+    {
+        const size_t pos = writePos + written;
+        const size_t freeSpace = m_capacity - (pos - m_readPos.load(std::memory_order_acquire));
+        if (freeSpace == 0)
+        {
+            // Publish what we have so far, and wait for the writer thread to make space.
+            publish(pos);
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_spaceAvailable.wait(
+                lock,
+                [&]() { return pos - m_readPos.load(std::memory_order_acquire) < m_capacity; });
+            continue;
+        }
+
+        // Copy as much as fits before the end of the ring buffer.
+        const size_t offset = pos & (m_capacity - 1);
+        const size_t chunkSize = Slang::Math::Min(len - written, freeSpace, m_capacity - offset);
+        ::memcpy(m_ringBuffer.getBuffer() + offset, src + written, chunkSize);
+        written += chunkSize;
+    }
+
+    // Published by `flush`, at the end of the API call
+    m_writePos.store(writePos + len, std::memory_order_release);
+}
+
+void AsyncFileOutputStream::flush()
+{
+    publish(m_writePos.load(std::memory_order_relaxed));
+}
+
+bool AsyncFileOutputStream::waitUntilWritten(int timeoutMs)
+{
+    const size_t writePos = m_writePos.load(std::memory_order_acquire);
+    for (int i = 0; i < timeoutMs; ++i)
+    {
+        if (m_flushedPos.load(std::memory_order_acquire) == writePos)
+        {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return m_flushedPos.load(std::memory_order_acquire) == writePos;
+}
+
+void AsyncFileOutputStream::writerThreadFunc()
+{
+    size_t readPos = m_readPos.load(std::memory_order_relaxed);
+
+    for (;;)
+    {
+        size_t writePos;
+        bool isClosing;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_dataAvailable.wait(
+                lock,
+                [&]()
+                {
+                    return m_writePos.load(std::memory_order_acquire) != readPos ||
+                           m_isClosing.load(std::memory_order_acquire);
+                });
+            // Read the closing flag before the write position, so that once we see the
+            // stream closing, all the data written before it is visible.
+            isClosing = m_isClosing.load(std::memory_order_acquire);
+            writePos = m_writePos.load(std::memory_order_acquire);
+        }
+
+        if (writePos == readPos)
+        {
+            if (isClosing)
+            {
+                break;
+            }
+            continue;
+        }
+
+        // Write out everything available, in at most two contiguous chunks.
+        while (readPos != writePos)
+        {
+            const size_t offset = readPos & (m_capacity - 1);
+            const size_t chunkSize = Slang::Math::Min(writePos - readPos, m_capacity - offset);
+            m_fileStream.write(m_ringBuffer.getBuffer() + offset, chunkSize);
+            readPos += chunkSize;
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_readPos.store(readPos, std::memory_order_release);
+        }
+        m_spaceAvailable.notify_one();
+
+        // Everything up to the end of the last API call is handed to the OS, so it isn't lost
+        // if the process dies.
+        m_fileStream.flush();
+        m_flushedPos.store(readPos, std::memory_order_release);
+    }
+}
+
 MemoryStream::MemoryStream()
     : m_memoryStream(Slang::FileAccess::Write)
 {
@@ -1,9 +1,15 @@
 #ifndef OUTPUT_STREAM_H
 #define OUTPUT_STREAM_H
 
+#include "../../core/slang-list.h"
 #include "../../core/slang-stream.h"
 #include "../../core/slang-string.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 namespace SlangRecord
 {
 class OutputStream : public Slang::RefObject
@@ -26,6 +32,58 @@ private:
     Slang::FileStream m_fileStream;
 };
 
+// A file output stream that moves the actual file IO off the calling thread.
+//
+// `write` copies the data into a single-producer/single-consumer ring buffer and
+// returns, and a background thread writes it to the file. `flush` marks an API-call
+// boundary: it wakes the writer thread, which writes out and flushes everything written
+// so far, without the caller waiting for it.
+//
+// If the process dies from a fatal signal, the signal handler waits (for a bounded time)
+// for the writer thread to write out what was recorded before the crash, so the record
+// file is usable for replaying up to the crash. All pending data is written out when the
+// stream is destroyed. The producer side must only be used from one thread at a time.
+class AsyncFileOutputStream : public OutputStream
+{
+public:
+    AsyncFileOutputStream(const Slang::String& fileName, size_t bufferSizeInBytes = 16 << 20);
+    virtual ~AsyncFileOutputStream() override;
+    virtual void write(const void* data, size_t len) override;
+    virtual void flush() override;
+
+    // Wait until the writer thread has written and flushed everything published so far,
+    // or until about `timeoutMs` have passed. Returns true if everything was written.
+    // Doesn't take any locks, so it can be called from a signal handler.
+    bool waitUntilWritten(int timeoutMs);
+
+private:
+    void writerThreadFunc();
+
+    // Make the data written so far visible to the writer thread, and wake it up.
+    void publish(size_t writePos);
+
+    FileOutputStream m_fileStream;
+    Slang::List<uint8_t> m_ringBuffer;
+    // Size of the ring buffer, always a power of 2.
+    size_t m_capacity;
+
+    // Positions only ever increase, the offset into the ring buffer is pos & (capacity - 1).
+    // m_writePos is only written by the producer, m_readPos and m_flushedPos only by the
+    // writer thread. m_flushedPos is the position up to which the file has been flushed.
+    std::atomic<size_t> m_writePos{0};
+    std::atomic<size_t> m_readPos{0};
+    std::atomic<size_t> m_flushedPos{0};
+    std::atomic<bool> m_isClosing{false};
+
+    // Signalled by the producer when there is new data or the stream is closing, and by
+    // the writer thread when it has made space in the ring buffer.
+    std::mutex m_mutex;
+    std::condition_variable m_dataAvailable;
+    std::condition_variable m_spaceAvailable;
+
+    std::thread m_writerThread;
+};
+
 // The reason we inherit from OwnedMemoryStream instead of declaring it
 // as a member is because OwnedMemoryStream lacks some of the functionality
 // of operating on the underlying buffer directly.
@@ -42,7 +42,14 @@ RecordManager::RecordManager(uint64_t globalSessionHandle)
 
     Slang::String recordFilePath =
         Slang::Path::combine(m_recordFileDirectory, Slang::String(ss.str().c_str()));
-    m_fileStream = new FileOutputStream(recordFilePath);
+    if (isRecordAsyncEnabled())
+    {
+        m_fileStream = new AsyncFileOutputStream(recordFilePath);
+    }
+    else
+    {
+        m_fileStream = new FileOutputStream(recordFilePath);
+    }
 }
 
 void RecordManager::clearWithHeader(const ApiCallId& callId, uint64_t handleId)
@@ -84,7 +91,8 @@ ParameterRecorder* RecordManager::endMethodRecord()
     // write record data to file
     m_fileStream->write(m_memoryStream.getData(), m_memoryStream.getSizeInBytes());
 
-    // take effect of the write
+    // take effect of the write, the async stream hands it to its writer thread, which
+    // writes and flushes it without blocking this call.
     m_fileStream->flush();
 
     // clear the memory stream
@@ -104,7 +112,8 @@ void RecordManager::apendOutput()
     // write record data to file
     m_fileStream->write(m_memoryStream.getData(), m_memoryStream.getSizeInBytes());
 
-    // take effect of the write
+    // take effect of the write, the async stream hands it to its writer thread, which
+    // writes and flushes it without blocking this call.
     m_fileStream->flush();
 
     // clear the memory stream
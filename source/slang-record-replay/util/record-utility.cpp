@@ -11,6 +11,7 @@
 
 constexpr const char* kRecordLayerEnvVar = "SLANG_RECORD_LAYER";
 constexpr const char* kRecordLayerLogLevel = "SLANG_RECORD_LOG_LEVEL";
+constexpr const char* kRecordLayerAsyncEnvVar = "SLANG_RECORD_ASYNC";
 
 namespace SlangRecord
 {
@@ -48,6 +49,19 @@ bool isRecordLayerEnabled()
     return false;
 }
 
+bool isRecordAsyncEnabled()
+{
+    Slang::String envVarStr;
+    if (getEnvironmentVariable(kRecordLayerAsyncEnvVar, envVarStr))
+    {
+        if (envVarStr == "1")
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 void setLogLevel()
 {
     // We only want to set the log level once
@@ -18,6 +18,8 @@ enum LogLevel : unsigned int
 };
 
 bool isRecordLayerEnabled();
+// When enabled, the record file is written by a background thread.
+bool isRecordAsyncEnabled();
 void slangRecordLog(LogLevel logLevel, const char* fmt, ...);
 void setLogLevel();
 } // namespace SlangRecord
@@ -264,6 +264,18 @@ SLANG_API SlangResult slang_createGlobalSessionWithoutCoreModule(
     return SLANG_OK;
 }
 
+SLANG_API SlangResult slang_freezeGlobalSession(slang::IGlobalSession* globalSession)
+{
+    if (!globalSession)
+        return SLANG_E_INVALID_ARG;
+
+    auto session = Slang::asInternal(globalSession);
+    if (!session)
+        return SLANG_E_INVALID_ARG;
+
+    return session->freeze();
+}
+
 SLANG_API const char* slang_getLastInternalErrorMessage()
 {
     return Slang::getLastSignalMessage();
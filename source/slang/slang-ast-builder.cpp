@@ -169,6 +169,23 @@ Type* SharedASTBuilder::getOverloadedType()
     return m_overloadedType;
 }
 
+void SharedASTBuilder::createLazyTypes()
+{
+    getStringType();
+    getNativeStringType();
+    getEnumTypeType();
+    getDynamicType();
+    getNullPtrType();
+    getNoneType();
+    getDiffInterfaceType();
+    getIBufferDataLayoutType();
+    getErrorType();
+    getBottomType();
+    getInitializerListType();
+    getOverloadedType();
+    getThisTypeName();
+}
+
 SharedASTBuilder::~SharedASTBuilder()
 {
     // Release built in types..
@@ -46,6 +46,10 @@ public:
     Type* getInitializerListType();
     Type* getOverloadedType();
 
+    /// Create all of the types above that are otherwise created on first use.
+    /// Requires the core module to be loaded.
+    void createLazyTypes();
+
     SyntaxClass<NodeBase> findSyntaxClass(Name* name);
 
     SyntaxClass<NodeBase> findSyntaxClass(const UnownedStringSlice& slice);
@@ -397,9 +397,28 @@ CapabilitySet::CapabilitySet(Int atomCount, CapabilityName const* atoms)
 }
 
 CapabilitySet::CapabilitySet(CapabilityName atom)
+    : CapabilitySet(getSingletonSet(atom))
 {
-    this->m_targetSets.reserve(kCapabilityTargetCount);
-    addUnexpandedCapabilites(atom);
+}
+
+const CapabilitySet& CapabilitySet::getSingletonSet(CapabilityName atom)
+{
+    SLANG_ASSERT(Int(atom) < Int(CapabilityName::Count));
+
+    // The sets are cached per thread, so that no synchronization is needed.
+    thread_local List<std::optional<CapabilitySet>> cache;
+    if (cache.getCount() == 0)
+        cache.setCount(Index(CapabilityName::Count));
+
+    auto& cachedSet = cache[Index(atom)];
+    if (!cachedSet)
+    {
+        CapabilitySet set;
+        set.m_targetSets.reserve(kCapabilityTargetCount);
+        set.addUnexpandedCapabilites(atom);
+        cachedSet = _Move(set);
+    }
+    return *cachedSet;
 }
 
 CapabilitySet::CapabilitySet(List<CapabilityName> const& atoms)
@@ -423,7 +442,7 @@ CapabilitySet CapabilitySet::makeInvalid()
 
 void CapabilitySet::addCapability(CapabilityName name)
 {
-    join(CapabilitySet(name));
+    join(getSingletonSet(name));
 }
 
 bool CapabilitySet::isEmpty() const
@@ -443,16 +462,14 @@ bool CapabilitySet::isIncompatibleWith(CapabilityAtom other) const
     if (isEmpty())
         return false;
 
-    CapabilitySet otherSet((CapabilityName)other);
-    return isIncompatibleWith(otherSet);
+    return isIncompatibleWith(getSingletonSet((CapabilityName)other));
 }
 
 bool CapabilitySet::isIncompatibleWith(CapabilityName other) const
 {
     if (isEmpty())
         return false;
-    auto otherSet = CapabilitySet(other);
-    return isIncompatibleWith(otherSet);
+    return isIncompatibleWith(getSingletonSet(other));
 }
 
 bool CapabilitySet::isIncompatibleWith(CapabilitySet const& other) const
@@ -508,9 +525,7 @@ bool CapabilitySet::implies(CapabilityAtom atom) const
     if (isEmpty() || atom == CapabilityAtom::Invalid)
         return false;
 
-    CapabilitySet tmpSet = CapabilitySet(CapabilityName(atom));
-
-    return this->implies(tmpSet);
+    return this->implies(getSingletonSet(CapabilityName(atom)));
 }
 
 CapabilitySet::ImpliesReturnFlags CapabilitySet::_implies(
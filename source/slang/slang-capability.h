@@ -120,6 +120,13 @@ public:
     /// Construct a singleton set from a single atomic capability
     explicit CapabilitySet(CapabilityName atom);
 
+    /// Get the singleton set for `atom`, equal to `CapabilitySet(atom)`.
+    ///
+    /// Expanding an atom into its sets for every target and stage it applies to is costly,
+    /// so each atom is expanded once per thread and the result is shared. Prefer this to
+    /// constructing a temporary set, to avoid the copy.
+    static const CapabilitySet& getSingletonSet(CapabilityName atom);
+
     /// Make an empty capability set
     static CapabilitySet makeEmpty();
 
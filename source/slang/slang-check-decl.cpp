@@ -3572,6 +3572,48 @@ void discoverExtensionDecls(List<ExtensionDecl*>& decls, Decl* parent)
     }
 }
 
+bool isPlainFunctionDefinition(Decl* decl)
+{
+    if (auto genericDecl = as<GenericDecl>(decl))
+        decl = genericDecl->inner;
+
+    auto funcDecl = as<FunctionDeclBase>(decl);
+    if (!funcDecl || !funcDecl->body)
+        return false;
+    if (as<InterfaceDecl>(getParentDecl(funcDecl)))
+        return false;
+
+    for (auto modifier : funcDecl->modifiers)
+    {
+        if (as<AttributeBase>(modifier) || as<HLSLExportModifier>(modifier) ||
+            as<ExternModifier>(modifier) || as<ExportedModifier>(modifier) ||
+            as<ExternCppModifier>(modifier))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// Like `ensureAllDeclsRec`, but skips the plain functions under the module or file
+/// `containerDecl`, so that their bodies can be checked on demand.
+static void _ensureAllDeclsExceptOnDemandBodies(
+    SemanticsVisitor* visitor,
+    ContainerDecl* containerDecl,
+    DeclCheckState state)
+{
+    visitor->ensureDecl(containerDecl, state);
+
+    for (Index i = 0; i < containerDecl->getDirectMemberDeclCount(); ++i)
+    {
+        Decl* childDecl = containerDecl->getDirectMemberDecl(i);
+        if (auto fileDecl = as<FileDecl>(childDecl))
+            _ensureAllDeclsExceptOnDemandBodies(visitor, fileDecl, state);
+        else if (!isPlainFunctionDefinition(childDecl))
+            visitor->ensureAllDeclsRec(childDecl, state);
+    }
+}
+
 void SemanticsDeclVisitorBase::checkModule(ModuleDecl* moduleDecl)
 {
     // When we are dealing with code from the core modules,
@@ -3734,6 +3776,13 @@ void SemanticsDeclVisitorBase::checkModule(ModuleDecl* moduleDecl)
             break;
     }
 
+    // With `LazyImportedBodyChecking`, an imported module leaves the bodies of its
+    // plain functions unchecked, and they are checked once something refers to
+    // them (see `checkReachableFunctionBodies`).
+    //
+    auto module = getShared()->getModule();
+    const bool checkBodiesOnDemand = module && module->shouldCheckBodiesOnDemand();
+
     // With extensions taken care of, we can now check the remaining decls.
     for (auto s : states)
     {
@@ -3751,7 +3800,10 @@ void SemanticsDeclVisitorBase::checkModule(ModuleDecl* moduleDecl)
         // to the subset of declarations coming from a given source
         // file.
         //
-        ensureAllDeclsRec(moduleDecl, s);
+        if (checkBodiesOnDemand && s >= DeclCheckState::DefinitionChecked)
+            _ensureAllDeclsExceptOnDemandBodies(this, moduleDecl, s);
+        else
+            ensureAllDeclsRec(moduleDecl, s);
     }
 
     // Once we have completed the above loop, all declarations not
@@ -3761,6 +3813,149 @@ void SemanticsDeclVisitorBase::checkModule(ModuleDecl* moduleDecl)
     // declarations they contain should be fully checked.
 }
 
+/// Collects the declarations referenced from the code it visits, skipping the bodies
+/// of functions that have not been checked.
+struct SemanticsDeclReachabilityVisitor
+    : public SemanticsDeclReferenceVisitor<SemanticsDeclReachabilityVisitor>
+{
+    List<Decl*>& referencedDecls;
+
+    SemanticsDeclReachabilityVisitor(SemanticsContext const& outer, List<Decl*>& referencedDecls)
+        : SemanticsDeclReferenceVisitor<SemanticsDeclReachabilityVisitor>(outer)
+        , referencedDecls(referencedDecls)
+    {
+    }
+
+    virtual void processReferencedDecl(Decl* decl) override { referencedDecls.add(decl); }
+
+    virtual void processDeclModifiers(Decl* decl, SourceLoc refLoc) override
+    {
+        SLANG_UNUSED(decl);
+        SLANG_UNUSED(refLoc);
+    }
+
+    // Attributes like `[ForwardDerivative(f)]` can be the only reference to a function.
+    void dispatchAttributeArgs(Decl* decl)
+    {
+        for (auto attr : decl->getModifiersOfType<AttributeBase>())
+        {
+            for (auto arg : attr->args)
+                dispatchIfNotNull(arg);
+
+            if (auto derivativeAttr = as<UserDefinedDerivativeAttribute>(attr))
+                dispatchIfNotNull(derivativeAttr->funcExpr);
+            else if (auto derivativeOfAttr = as<DerivativeOfAttribute>(attr))
+                dispatchIfNotNull(derivativeOfAttr->funcExpr);
+            else if (auto substituteAttr = as<PrimalSubstituteAttribute>(attr))
+                dispatchIfNotNull(substituteAttr->funcExpr);
+            else if (auto substituteOfAttr = as<PrimalSubstituteOfAttribute>(attr))
+                dispatchIfNotNull(substituteOfAttr->funcExpr);
+        }
+    }
+
+    void visitDeclBase(DeclBase* decl)
+    {
+        if (auto d = as<Decl>(decl))
+            dispatchAttributeArgs(d);
+    }
+
+    void visitContainerDecl(ContainerDecl* decl)
+    {
+        dispatchAttributeArgs(decl);
+        for (auto m : decl->getDirectMemberDecls())
+        {
+            dispatchIfNotNull(m);
+        }
+    }
+
+    void visitGenericDecl(GenericDecl* decl)
+    {
+        visitContainerDecl(decl);
+        dispatchIfNotNull(decl->inner);
+    }
+
+    void visitFunctionDeclBase(FunctionDeclBase* decl)
+    {
+        visitContainerDecl(decl);
+        if (decl->isChecked(DeclCheckState::DefinitionChecked))
+            dispatchIfNotNull(decl->body);
+    }
+
+    void visitVarDeclBase(VarDeclBase* varDecl)
+    {
+        dispatchAttributeArgs(varDecl);
+        dispatchIfNotNull(varDecl->type.type);
+        dispatchIfNotNull(varDecl->initExpr);
+    }
+};
+
+void checkReachableFunctionBodies(
+    List<RefPtr<TranslationUnitRequest>> const& translationUnits,
+    List<RefPtr<TranslationUnitRequest>> const& imports)
+{
+    if (imports.getCount() == 0)
+        return;
+
+    SLANG_AST_BUILDER_RAII(imports[0]->compileRequest->getLinkage()->getASTBuilder());
+
+    // The bodies of each module get checked in the context the rest of the
+    // module was checked in.
+    //
+    Dictionary<ModuleDecl*, SharedSemanticsContext*> sharedContexts;
+    SharedSemanticsContext* anyShared = nullptr;
+    for (auto translationUnit : imports)
+    {
+        if (auto shared = translationUnit->sharedSemanticsForBodies.Ptr())
+        {
+            sharedContexts.add(translationUnit->getModuleDecl(), shared);
+            anyShared = shared;
+        }
+    }
+    if (!anyShared)
+        return;
+
+    List<Decl*> referencedDecls;
+    SemanticsDeclReachabilityVisitor visitor(SemanticsContext(anyShared), referencedDecls);
+
+    // Everything in the translation units being compiled is reachable, and so
+    // is everything the imported modules checked up front.
+    //
+    for (auto translationUnit : translationUnits)
+        visitor.dispatchIfNotNull(translationUnit->getModuleDecl());
+    for (auto translationUnit : imports)
+        visitor.dispatchIfNotNull(translationUnit->getModuleDecl());
+
+    // Checking a body can make more functions reachable, which are then
+    // appended to the list that we are going through.
+    //
+    for (Index i = 0; i < referencedDecls.getCount(); ++i)
+    {
+        Decl* decl = referencedDecls[i];
+        if (auto genericDecl = as<GenericDecl>(decl))
+            decl = genericDecl->inner;
+
+        auto funcDecl = as<FunctionDeclBase>(decl);
+        if (!funcDecl || !funcDecl->body || funcDecl->isChecked(DeclCheckState::DefinitionChecked))
+            continue;
+
+        SharedSemanticsContext* shared = nullptr;
+        if (!sharedContexts.tryGetValue(getModuleDecl(funcDecl), shared))
+            continue;
+
+        Decl* rootDecl = funcDecl;
+        if (auto genericDecl = as<GenericDecl>(getParentDecl(funcDecl)))
+            rootDecl = genericDecl;
+
+        SemanticsDeclVisitorBase checker((SemanticsContext(shared)));
+        checker.ensureAllDeclsRec(rootDecl, DeclCheckState::CapabilityChecked);
+
+        visitor.dispatchIfNotNull(funcDecl);
+    }
+
+    for (auto translationUnit : imports)
+        translationUnit->sharedSemanticsForBodies = nullptr;
+}
+
 bool SemanticsVisitor::doesSignatureMatchRequirement(
     DeclRef<CallableDecl> satisfyingMemberDeclRef,
     DeclRef<CallableDecl> requiredMemberDeclRef,
@@ -303,6 +303,32 @@ struct OverloadCandidate
     SubstitutionSet subst;
 };
 
+/// What can be told about a callable declaration as an overload candidate from its
+/// declared signature alone, without specializing it for a call.
+///
+/// Used to rule out candidates that can't be applied to the arguments of a call before
+/// doing the full (and much more expensive) check of each candidate.
+struct OverloadCandidateSignature
+{
+    /// The number of leading parameters whose types are recorded.
+    static const Index kMaxIndexedParamCount = 2;
+
+    /// False if the parameter count isn't known until the declaration is specialized,
+    /// because a parameter is a type pack. Nothing can be ruled out in that case.
+    bool isKnown = false;
+
+    Count requiredParamCount = 0;
+    Count allowedParamCount = 0;
+
+    /// The types of the leading parameters, and their `BasicTypeKey`s. The key is invalid
+    /// unless the type is a scalar, vector or matrix with known element type and size,
+    /// which is the only case the type is used to rule out a candidate.
+    QualType paramTypes[kMaxIndexedParamCount];
+    BasicTypeKey paramKeys[kMaxIndexedParamCount] = {
+        BasicTypeKey::invalid(),
+        BasicTypeKey::invalid()};
+};
+
 struct ResolvedOperatorOverload
 {
     // The resolved decl.
@@ -323,6 +349,10 @@ struct TypeCheckingCache : public RefObject
     Dictionary<OperatorOverloadCacheKey, ResolvedOperatorOverload> resolvedOperatorOverloadCache;
     Dictionary<BasicTypeKeyPair, ConversionCost> conversionCostCache;
 
+    // Signatures of core module declarations, used to rule out overload candidates.
+    // Only core module declarations are cached, because they outlive the linkage.
+    Dictionary<Decl*, OverloadCandidateSignature> overloadCandidateSignatureCache;
+
     // The version used to invalidate the cached declRefs in ResolvedOperatorOverload entries.
     int version = 0;
 };
@@ -2481,6 +2511,22 @@ public:
 
         // Full list of all candidates being considered, in the ambiguous case
         List<OverloadCandidate> bestCandidates;
+
+        // If set, candidates from lookup that can't apply to the arguments (judging by
+        // their signature alone) are discarded without being checked.
+        bool filterCandidates = false;
+
+        // Candidates from lookup that were checked, or discarded by the filter
+        Count checkedCandidateCount = 0;
+        Count filteredCandidateCount = 0;
+
+        // True if an applicable candidate has been found
+        bool hasApplicableCandidate()
+        {
+            if (bestCandidates.getCount())
+                return bestCandidates[0].status == OverloadCandidate::Status::Applicable;
+            return bestCandidate && bestCandidate->status == OverloadCandidate::Status::Applicable;
+        }
     };
 
     struct ParamCounts
@@ -2749,6 +2795,19 @@ public:
         OverloadResolveContext& context,
         ConversionCost baseCost);
 
+    /// Get the signature of `decl` as an overload candidate.
+    void getOverloadCandidateSignature(
+        CallableDecl* decl,
+        OverloadCandidateSignature& outSignature);
+
+    /// True if the lookup result `item` can't be applied to the arguments in `context`.
+    bool isOverloadCandidateRuledOut(LookupResultItem const& item, OverloadResolveContext& context);
+
+    /// Add the lookup result `item` as a candidate, unless it is ruled out by the filter.
+    void addFilteredOverloadCandidates(
+        LookupResultItem const& item,
+        OverloadResolveContext& context);
+
     void AddOverloadCandidates(LookupResult const& result, OverloadResolveContext& context);
 
     void AddOverloadCandidates(Expr* funcExpr, OverloadResolveContext& context);
@@ -2357,6 +2357,123 @@ void SemanticsVisitor::AddDeclRefOverloadCandidates(
     }
 }
 
+void SemanticsVisitor::getOverloadCandidateSignature(
+    CallableDecl* decl,
+    OverloadCandidateSignature& outSignature)
+{
+    // Heavily overloaded functions are almost all in the core module, and its
+    // declarations live as long as the global session, so only they are cached.
+    const bool canCache = isFromCoreModule(decl);
+    TypeCheckingCache* typeCheckingCache = getLinkage()->getTypeCheckingCache();
+    if (canCache &&
+        typeCheckingCache->overloadCandidateSignatureCache.tryGetValue(decl, outSignature))
+    {
+        return;
+    }
+
+    ensureDecl(decl, DeclCheckState::CanUseFuncSignature);
+
+    OverloadCandidateSignature signature;
+    signature.isKnown = true;
+
+    Index paramIndex = 0;
+    for (auto paramDecl : decl->getParameters())
+    {
+        auto paramType = paramDecl->getType();
+
+        // The number of arguments a type pack takes isn't known until it is specialized
+        if (!paramType || isTypePack(paramType))
+        {
+            signature.isKnown = false;
+            break;
+        }
+
+        // Matches the counting in `CountParameters`
+        if (!paramDecl->initExpr)
+            signature.requiredParamCount++;
+        signature.allowedParamCount++;
+
+        if (paramIndex < OverloadCandidateSignature::kMaxIndexedParamCount)
+        {
+            const QualType paramQualType = getParamQualType(m_astBuilder, makeDeclRef(paramDecl));
+            signature.paramTypes[paramIndex] = paramQualType;
+            signature.paramKeys[paramIndex] = makeBasicTypeKey(paramQualType);
+        }
+        paramIndex++;
+    }
+
+    if (canCache)
+    {
+        typeCheckingCache->overloadCandidateSignatureCache[decl] = signature;
+    }
+    outSignature = signature;
+}
+
+bool SemanticsVisitor::isOverloadCandidateRuledOut(
+    LookupResultItem const& item,
+    OverloadResolveContext& context)
+{
+    // Only functions (including generic ones) are considered, because they are what
+    // gets heavily overloaded.
+    Decl* decl = item.declRef.getDecl();
+    if (auto genericDecl = as<GenericDecl>(decl))
+        decl = genericDecl->inner;
+
+    auto callableDecl = as<CallableDecl>(decl);
+    if (!callableDecl)
+        return false;
+
+    OverloadCandidateSignature signature;
+    getOverloadCandidateSignature(callableDecl, signature);
+    if (!signature.isKnown)
+        return false;
+
+    // Specializing a declaration doesn't change how many parameters it has,
+    // so a candidate with the wrong arity can never apply.
+    const Count argCount = context.getArgCount();
+    if (argCount < signature.requiredParamCount || argCount > signature.allowedParamCount)
+        return true;
+
+    // A parameter whose type is a scalar, vector or matrix with known element type and size
+    // has that type whatever the declaration is specialized with, so if an argument of such
+    // a type can't be coerced to it the candidate can never apply. Coercions between these
+    // types are cached, so this is cheap.
+    const Index indexedCount =
+        Math::Min(argCount, OverloadCandidateSignature::kMaxIndexedParamCount);
+    for (Index i = 0; i < indexedCount; ++i)
+    {
+        if (signature.paramKeys[i].getRaw() == BasicTypeKey::invalid().getRaw())
+            continue;
+
+        auto argType = context.getArgType(i);
+        if (!argType)
+            continue;
+
+        auto argExpr = context.args ? context.getArg(i) : nullptr;
+        const auto& paramType = signature.paramTypes[i];
+        const QualType argQualType(argType, paramType.isLeftValue);
+        if (makeBasicTypeKey(argQualType, argExpr).getRaw() == BasicTypeKey::invalid().getRaw())
+            continue;
+
+        if (!canCoerce(paramType, argQualType, argExpr))
+            return true;
+    }
+    return false;
+}
+
+void SemanticsVisitor::addFilteredOverloadCandidates(
+    LookupResultItem const& item,
+    OverloadResolveContext& context)
+{
+    if (context.filterCandidates && isOverloadCandidateRuledOut(item, context))
+    {
+        context.filteredCandidateCount++;
+        return;
+    }
+    context.checkedCandidateCount++;
+    AddDeclRefOverloadCandidates(item, context, kConversionCost_None);
+}
+
 void SemanticsVisitor::AddOverloadCandidates(
     LookupResult const& result,
     OverloadResolveContext& context)
@@ -2365,12 +2482,12 @@ void SemanticsVisitor::AddOverloadCandidates(
     {
         for (auto item : result.items)
         {
-            AddDeclRefOverloadCandidates(item, context, kConversionCost_None);
+            addFilteredOverloadCandidates(item, context);
         }
     }
     else
     {
-        AddDeclRefOverloadCandidates(result.item, context, kConversionCost_None);
+        addFilteredOverloadCandidates(result.item, context);
     }
 }
 
@@ -2688,7 +2805,33 @@ Expr* SemanticsVisitor::ResolveInvoke(InvokeExpr* expr)
     }
     if (!context.bestCandidate && !typeOverloadChecked)
     {
+        // Heavily overloaded functions have hundreds of candidates, most of which can be ruled
+        // out from their signature alone, without the full check.
+        context.filterCandidates = true;
         AddOverloadCandidates(funcExpr, context);
+
+        auto& stats = getLinkage()->m_overloadResolutionStats;
+
+        // The filter only rules out candidates that can't apply. If nothing applies, resolve
+        // again without it, so that diagnostics see the same candidates as before.
+        if (context.filteredCandidateCount && !context.hasApplicableCandidate())
+        {
+            stats.unfilteredCallCount++;
+
+            context.bestCandidate = nullptr;
+            context.bestCandidates.clear();
+            context.filterCandidates = false;
+            context.checkedCandidateCount = 0;
+            context.filteredCandidateCount = 0;
+            AddOverloadCandidates(funcExpr, context);
+        }
+
+        stats.callCount++;
+        stats.checkedCandidateCount += context.checkedCandidateCount;
+        stats.filteredCandidateCount += context.filteredCandidateCount;
+        stats.maxCandidatesPerCall = Math::Max(
+            stats.maxCandidatesPerCall,
+            context.checkedCandidateCount + context.filteredCandidateCount);
     }
 
     if (context.bestCandidates.getCount() > 0)
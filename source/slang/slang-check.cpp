@@ -175,14 +175,14 @@ void checkTranslationUnit(
 {
     SLANG_AST_BUILDER_RAII(translationUnit->compileRequest->getLinkage()->getASTBuilder());
 
-    SharedSemanticsContext sharedSemanticsContext(
+    RefPtr<SharedSemanticsContext> sharedSemanticsContext = new SharedSemanticsContext(
         translationUnit->compileRequest->getLinkage(),
         translationUnit->getModule(),
         translationUnit->compileRequest->getSink(),
         &loadedModules,
         translationUnit);
 
-    SemanticsDeclVisitorBase visitor((SemanticsContext(&sharedSemanticsContext)));
+    SemanticsDeclVisitorBase visitor((SemanticsContext(sharedSemanticsContext.Ptr())));
 
     // Apply the visitor to do the main semantic
     // checking that is required on all declarations
@@ -191,6 +191,15 @@ void checkTranslationUnit(
     visitor.checkModule(translationUnit->getModuleDecl());
 
     translationUnit->getModule()->_collectShaderParams();
+
+    // Function bodies left to be checked on demand are checked in the same
+    // context later on. The loaded modules are only needed for `import`s.
+    //
+    if (translationUnit->getModule()->shouldCheckBodiesOnDemand())
+    {
+        sharedSemanticsContext->m_environmentModules = nullptr;
+        translationUnit->sharedSemanticsForBodies = sharedSemanticsContext;
+    }
 }
 
 void SemanticsVisitor::dispatchStmt(Stmt* stmt, SemanticsContext const& context)
@@ -21,6 +21,13 @@ class TranslationUnitRequest;
 bool isGlobalShaderParameter(VarDeclBase* decl);
 bool isFromCoreModule(Decl* decl);
 
+/// Is `decl` a function definition that only matters once other code refers to it?
+///
+/// Functions with an attribute (like `[shader]` or `[ForwardDerivativeOf]`), exported or
+/// extern linkage, and interface requirements can matter without a reference, so they
+/// are not. Used to find the functions that can be checked or lowered on demand.
+bool isPlainFunctionDefinition(Decl* decl);
+
 void registerBuiltinDecls(Session* session, Decl* decl);
 
 Type* unwrapArrayType(Type* type);
@@ -5,6 +5,7 @@
 #include "slang-capability.h"
 #include "slang-check-impl.h"
 #include "slang-compiler.h"
+#include "slang-ir-autodiff.h"
 #include "slang-ir-insts.h"
 #include "slang-ir-util.h"
 
@@ -93,6 +94,7 @@ static bool attemptPrecompiledExport(IRInst* inst)
 SLANG_NO_THROW SlangResult SLANG_MCALL
 Module::precompileForTarget(SlangCompileTarget target, slang::IBlob** outDiagnostics)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     CodeGenTarget targetEnum = CodeGenTarget(target);
 
     // Don't precompile twice for the same target
@@ -155,6 +157,20 @@ Module::precompileForTarget(SlangCompileTarget target, slang::IBlob** outDiagnos
     CodeGenContext::Shared sharedCodeGenContext(&tp, entryPointIndices, &sink, nullptr);
     CodeGenContext codeGenContext(&sharedCodeGenContext);
 
+    // Forward derivatives don't depend on the target, so they are generated once, into the
+    // module IR itself. Linking this module later picks them up through their
+    // `ForwardDerivativeDecoration` instead of differentiating the functions again.
+    if (linkage->m_optionSet.getBoolOption(CompilerOptionName::PrecompileForwardDerivatives) ||
+        m_optionSet.getBoolOption(CompilerOptionName::PrecompileForwardDerivatives))
+    {
+        SlangResult derivativesResult = precompileForwardDerivatives(module, &sink);
+        if (SLANG_FAILED(derivativesResult))
+        {
+            sink.getBlobIfNeeded(outDiagnostics);
+            return derivativesResult;
+        }
+    }
+
     // Mark all public functions as exported, ensure there's at least one. Store a mapping
     // of function name to IRInst* for later reference. After linking is done, we'll scan
     // the linked result to see which functions survived the pruning and are included in the
@@ -175,6 +191,7 @@ Module::precompileForTarget(SlangCompileTarget target, slang::IBlob** outDiagnos
     // because it's possible that the module just doesn't have any simple HLSL.
     if (!hasAtLeastOneFunction)
     {
+        sink.getBlobIfNeeded(outDiagnostics);
         return SLANG_OK;
     }
 
@@ -232,6 +249,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Module::getPrecompiledTargetCode(
     slang::IBlob** outCode,
     slang::IBlob** outDiagnostics)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     SLANG_UNUSED(outDiagnostics);
     for (auto globalInst : getIRModule()->getModuleInst()->getChildren())
     {
@@ -253,6 +271,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Module::getPrecompiledTargetCode(
 
 SLANG_NO_THROW SlangInt SLANG_MCALL Module::getModuleDependencyCount()
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     return 0;
 }
 
@@ -261,6 +280,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Module::getModuleDependency(
     IModule** outModule,
     slang::IBlob** outDiagnostics)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     SLANG_UNUSED(dependencyIndex);
     SLANG_UNUSED(outModule);
     SLANG_UNUSED(outDiagnostics);
@@ -272,6 +292,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Module::getModuleDependency(
 SLANG_NO_THROW SlangResult SLANG_MCALL
 ComponentType::precompileForTarget(SlangCompileTarget target, slang::IBlob** outDiagnostics)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     SLANG_UNUSED(target);
     SLANG_UNUSED(outDiagnostics);
     return SLANG_FAIL;
@@ -282,6 +303,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getPrecompiledTargetCode(
     slang::IBlob** outCode,
     slang::IBlob** outDiagnostics)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     SLANG_UNUSED(target);
     SLANG_UNUSED(outCode);
     SLANG_UNUSED(outDiagnostics);
@@ -290,6 +312,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getPrecompiledTargetCode(
 
 SLANG_NO_THROW SlangInt SLANG_MCALL ComponentType::getModuleDependencyCount()
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     return getModuleDependencies().getCount();
 }
 
@@ -298,6 +321,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getModuleDependency(
     slang::IModule** outModule,
     slang::IBlob** outDiagnostics)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     SLANG_UNUSED(outDiagnostics);
     if (dependencyIndex < 0 || dependencyIndex >= getModuleDependencies().getCount())
     {
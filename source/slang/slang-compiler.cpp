@@ -31,6 +31,7 @@
 #include "slang-artifact-output-util.h"
 #include "slang-emit-cuda.h"
 #include "slang-extension-tracker.h"
+#include "slang-ir-link.h"
 #include "slang-lower-to-ir.h"
 #include "slang-mangle.h"
 #include "slang-parameter-binding.h"
@@ -143,6 +144,7 @@ Module* EntryPoint::getModule()
 
 Index EntryPoint::getSpecializationParamCount()
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     return m_genericSpecializationParams.getCount() + m_existentialSpecializationParams.getCount();
 }
 
@@ -2032,6 +2034,7 @@ struct CompileTimerRAII
 SlangResult CodeGenContext::emitEntryPoints(ComPtr<IArtifact>& outArtifact)
 {
     CompileTimerRAII recordCompileTime(getSession());
+    Linkage::MemoryLimitScope memoryLimitScope(getLinkage());
 
     auto target = getTargetFormat();
 
@@ -2282,6 +2285,15 @@ IArtifact* TargetProgram::_createEntryPointResult(
         m_entryPointResults.setCount(entryPointIndex + 1);
 
 
+    // Programs with several entry points can link the IR for all of them up front, so
+    // that most of the symbol resolution is shared. If that fails, the entry point
+    // is linked from the source modules as usual.
+    if (m_optionSet.getBoolOption(CompilerOptionName::ShareLinkedIR) &&
+        m_program->getEntryPointCount() > 1)
+    {
+        getOrCreateSharedLinkedIR();
+    }
+
     CodeGenContext::EntryPointIndices entryPointIndices;
     entryPointIndices.add(entryPointIndex);
 
@@ -2293,6 +2305,43 @@ IArtifact* TargetProgram::_createEntryPointResult(
     return m_entryPointResults[entryPointIndex];
 }
 
+IRModule* TargetProgram::getOrCreateSharedLinkedIR()
+{
+    // Entry points can be added to the program after the IR was linked, in
+    // which case it has to be linked again.
+    const Index entryPointCount = m_program->getEntryPointCount();
+    if (m_sharedLinkedIREntryPointCount == entryPointCount)
+        return m_sharedLinkedIR;
+
+    // `linkIR` links from the shared IR whenever it is set
+    m_sharedLinkedIR = nullptr;
+    m_sharedLinkedIRGlobalScopeVarLayout = nullptr;
+    m_sharedLinkedIREntryPointCount = entryPointCount;
+
+    CodeGenContext::EntryPointIndices entryPointIndices;
+    entryPointIndices.setCount(entryPointCount);
+    for (Index i = 0; i < entryPointCount; i++)
+        entryPointIndices[i] = i;
+
+    // Diagnostics go to a sink of their own. If linking fails, the entry points are linked
+    // from the program's modules, and that reports the same errors.
+    DiagnosticSink linkSink(m_program->getLinkage()->getSourceManager(), nullptr);
+
+    CodeGenContext::Shared sharedCodeGenContext(this, entryPointIndices, &linkSink, nullptr);
+    CodeGenContext codeGenContext(&sharedCodeGenContext);
+
+    LinkedIR linkedIR = linkIR(&codeGenContext);
+    if (linkSink.getErrorCount() != 0)
+        return nullptr;
+
+    // Entry points are linked from the module by their mangled names
+    linkedIR.module->buildMangledNameToGlobalInstMap();
+
+    m_sharedLinkedIR = linkedIR.module;
+    m_sharedLinkedIRGlobalScopeVarLayout = linkedIR.globalScopeVarLayout;
+    return m_sharedLinkedIR;
+}
+
 IArtifact* TargetProgram::getOrCreateWholeProgramResult(DiagnosticSink* sink)
 {
     if (m_wholeProgramResult)
@@ -2918,6 +2967,7 @@ bool CodeGenContext::isSpecializationDisabled()
 
 SLANG_NO_THROW SlangResult SLANG_MCALL Module::serialize(ISlangBlob** outSerializedBlob)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     SerialContainerUtil::WriteOptions writeOptions;
     writeOptions.sourceManager = getLinkage()->getSourceManager();
     OwnedMemoryStream memoryStream(FileAccess::Write);
@@ -2931,6 +2981,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Module::serialize(ISlangBlob** outSeriali
 
 SLANG_NO_THROW SlangResult SLANG_MCALL Module::writeToFile(char const* fileName)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     SerialContainerUtil::WriteOptions writeOptions;
     writeOptions.sourceManager = getLinkage()->getSourceManager();
     FileStream fileStream;
@@ -2940,6 +2991,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Module::writeToFile(char const* fileName)
 
 SLANG_NO_THROW const char* SLANG_MCALL Module::getName()
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     if (m_name)
         return m_name->text.getBuffer();
     return nullptr;
@@ -2947,6 +2999,7 @@ SLANG_NO_THROW const char* SLANG_MCALL Module::getName()
 
 SLANG_NO_THROW const char* SLANG_MCALL Module::getFilePath()
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     if (m_pathInfo.hasFoundPath())
         return m_pathInfo.foundPath.getBuffer();
     return nullptr;
@@ -2954,6 +3007,7 @@ SLANG_NO_THROW const char* SLANG_MCALL Module::getFilePath()
 
 SLANG_NO_THROW const char* SLANG_MCALL Module::getUniqueIdentity()
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     if (m_pathInfo.hasUniqueIdentity())
         return m_pathInfo.getMostUniqueIdentity().getBuffer();
     return nullptr;
@@ -2961,11 +3015,13 @@ SLANG_NO_THROW const char* SLANG_MCALL Module::getUniqueIdentity()
 
 SLANG_NO_THROW SlangInt32 SLANG_MCALL Module::getDependencyFileCount()
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     return (SlangInt32)getFileDependencies().getCount();
 }
 
 SLANG_NO_THROW char const* SLANG_MCALL Module::getDependencyFilePath(SlangInt32 index)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     SourceFile* sourceFile = getFileDependencies()[index];
     return sourceFile->getPathInfo().hasFoundPath()
                ? sourceFile->getPathInfo().getMostUniqueIdentity().getBuffer()
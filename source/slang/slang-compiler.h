@@ -13,11 +13,13 @@
 #include "../core/slang-command-options.h"
 #include "../core/slang-crypto.h"
 #include "../core/slang-file-system.h"
+#include "../core/slang-memory-accounting.h"
 #include "../core/slang-shared-library.h"
 #include "../core/slang-std-writers.h"
 #include "slang-capability.h"
 #include "slang-com-ptr.h"
 #include "slang-compiler-options.h"
+#include "slang-container-pool.h"
 #include "slang-content-assist-info.h"
 #include "slang-diagnostics.h"
 #include "slang-hlsl-to-vulkan-layout-options.h"
@@ -28,6 +30,8 @@
 #include "slang.h"
 
 #include <chrono>
+#include <memory>
+#include <mutex>
 
 namespace Slang
 {
@@ -35,6 +39,7 @@ struct PathInfo;
 struct IncludeHandler;
 struct SharedSemanticsContext;
 struct ModuleChunk;
+struct IRVarLayout;
 
 class ProgramLayout;
 class PtrType;
@@ -42,6 +47,7 @@ class TargetProgram;
 class TargetRequest;
 class TypeLayout;
 class Artifact;
+class ImportPrefetcher;
 
 enum class CompilerMode
 {
@@ -280,6 +286,64 @@ class EntryPoint;
 class ComponentType;
 class ComponentTypeVisitor;
 
+/// Mutex used to serialize API calls on a session, and the component types created
+/// from it, when the session was created with `CompilerOptionName::EnableConcurrentSessionAccess`.
+///
+/// Null if the session is only used from a single thread at a time.
+typedef std::shared_ptr<std::recursive_mutex> SessionAccessMutex;
+
+/// Holds the lock on a `SessionAccessMutex` for its lifetime. Does nothing if the mutex is null.
+///
+/// A reference to the mutex is held, so the lock can be taken around an operation (such as
+/// `release`) that may destroy the session that owns it.
+class SessionAccessLock
+{
+public:
+    SessionAccessLock(SessionAccessMutex const& mutex)
+        : m_mutex(mutex)
+    {
+        if (m_mutex)
+            m_mutex->lock();
+    }
+    ~SessionAccessLock()
+    {
+        if (m_mutex)
+            m_mutex->unlock();
+    }
+
+private:
+    SessionAccessMutex m_mutex;
+};
+
+/// Like `SLANG_REF_OBJECT_IUNKNOWN_ALL`, but the reference count is only changed while
+/// holding the session access lock, because `RefObject` reference counts are not atomic.
+///
+/// The class must provide `getSessionAccessMutex()`.
+#define SLANG_SESSION_OBJECT_IUNKNOWN_ALL                                                          \
+    SLANG_NO_THROW SlangResult SLANG_MCALL queryInterface(SlangUUID const& uuid, void** outObject) \
+        SLANG_OVERRIDE                                                                             \
+    {                                                                                              \
+        void* intf = getInterface(uuid);                                                           \
+        if (intf)                                                                                  \
+        {                                                                                          \
+            SessionAccessLock sessionAccessLock(getSessionAccessMutex());                          \
+            addReference();                                                                        \
+            *outObject = intf;                                                                     \
+            return SLANG_OK;                                                                       \
+        }                                                                                          \
+        return SLANG_E_NO_INTERFACE;                                                               \
+    }                                                                                              \
+    SLANG_NO_THROW uint32_t SLANG_MCALL addRef() SLANG_OVERRIDE                                    \
+    {                                                                                              \
+        SessionAccessLock sessionAccessLock(getSessionAccessMutex());                              \
+        return (uint32_t)addReference();                                                           \
+    }                                                                                              \
+    SLANG_NO_THROW uint32_t SLANG_MCALL release() SLANG_OVERRIDE                                   \
+    {                                                                                              \
+        SessionAccessLock sessionAccessLock(getSessionAccessMutex());                              \
+        return (uint32_t)releaseReference();                                                       \
+    }
+
 /// Base class for "component types" that represent the pieces a final
 /// shader program gets linked together from.
 ///
@@ -293,7 +357,7 @@ public:
     // ISlangUnknown interface
     //
 
-    SLANG_REF_OBJECT_IUNKNOWN_ALL;
+    SLANG_SESSION_OBJECT_IUNKNOWN_ALL
     ISlangUnknown* getInterface(Guid const& guid);
 
     //
@@ -397,6 +461,10 @@ public:
     /// Get the linkage (aka "session" in the public API) for this component type.
     Linkage* getLinkage() { return m_linkage; }
 
+    /// Get the mutex that serializes API calls on the linkage, or null if it can only be
+    /// used from a single thread at a time.
+    SessionAccessMutex const& getSessionAccessMutex() { return m_sessionAccessMutex; }
+
     /// Get the target-specific version of this program for the given `target`.
     ///
     /// The `target` must be a target on the `Linkage` that was used to create this program.
@@ -596,6 +664,9 @@ protected:
 protected:
     Linkage* m_linkage;
 
+    // Copied from the linkage, so the mutex stays alive while this component type does.
+    SessionAccessMutex m_sessionAccessMutex;
+
     CompilerOptionSet m_optionSet;
 
     // Cache of target-specific programs for each target.
@@ -932,7 +1003,7 @@ class EntryPoint : public ComponentType, public slang::IEntryPoint
     typedef ComponentType Super;
 
 public:
-    SLANG_REF_OBJECT_IUNKNOWN_ALL
+    SLANG_SESSION_OBJECT_IUNKNOWN_ALL
 
     ISlangUnknown* getInterface(const Guid& guid);
 
@@ -1227,7 +1298,7 @@ class TypeConformance : public ComponentType, public slang::ITypeConformance
     typedef ComponentType Super;
 
 public:
-    SLANG_REF_OBJECT_IUNKNOWN_ALL
+    SLANG_SESSION_OBJECT_IUNKNOWN_ALL
 
     ISlangUnknown* getInterface(const Guid& guid);
 
@@ -1461,7 +1532,7 @@ class Module : public ComponentType, public slang::IModule
     typedef ComponentType Super;
 
 public:
-    SLANG_REF_OBJECT_IUNKNOWN_ALL
+    SLANG_SESSION_OBJECT_IUNKNOWN_ALL
 
     ISlangUnknown* getInterface(const Guid& guid);
 
@@ -1545,6 +1616,7 @@ public:
     SLANG_NO_THROW SlangResult SLANG_MCALL
     findEntryPointByName(char const* name, slang::IEntryPoint** outEntryPoint) SLANG_OVERRIDE
     {
+        SessionAccessLock sessionAccessLock(getSessionAccessMutex());
         if (outEntryPoint == nullptr)
         {
             return SLANG_E_INVALID_ARG;
@@ -1564,6 +1636,7 @@ public:
         slang::IEntryPoint** outEntryPoint,
         ISlangBlob** outDiagnostics) override
     {
+        SessionAccessLock sessionAccessLock(getSessionAccessMutex());
         if (outEntryPoint == nullptr)
         {
             return SLANG_E_INVALID_ARG;
@@ -1579,12 +1652,14 @@ public:
 
     virtual SLANG_NO_THROW SlangInt32 SLANG_MCALL getDefinedEntryPointCount() override
     {
+        SessionAccessLock sessionAccessLock(getSessionAccessMutex());
         return (SlangInt32)m_entryPoints.getCount();
     }
 
     virtual SLANG_NO_THROW SlangResult SLANG_MCALL
     getDefinedEntryPoint(SlangInt32 index, slang::IEntryPoint** outEntryPoint) override
     {
+        SessionAccessLock sessionAccessLock(getSessionAccessMutex());
         if (index < 0 || index >= m_entryPoints.getCount())
             return SLANG_E_INVALID_ARG;
 
@@ -1751,6 +1826,11 @@ public:
     ///
     void setIRModule(IRModule* irModule) { m_irModule = irModule; }
 
+    /// Should checking leave the bodies of plain functions in this module until something
+    /// refers to them? See `LazyImportedBodyChecking`.
+    bool shouldCheckBodiesOnDemand() { return m_checkBodiesOnDemand; }
+    void setCheckBodiesOnDemand(bool value) { m_checkBodiesOnDemand = value; }
+
     Index getEntryPointCount() SLANG_OVERRIDE { return 0; }
     RefPtr<EntryPoint> getEntryPoint(Index index) SLANG_OVERRIDE
     {
@@ -1773,6 +1853,7 @@ public:
 
     SLANG_NO_THROW Index SLANG_MCALL getSpecializationParamCount() SLANG_OVERRIDE
     {
+        SessionAccessLock sessionAccessLock(getSessionAccessMutex());
         return m_specializationParams.getCount();
     }
     SpecializationParam const& getSpecializationParam(Index index) SLANG_OVERRIDE
@@ -1865,6 +1946,8 @@ private:
     // The IR for the module
     RefPtr<IRModule> m_irModule = nullptr;
 
+    bool m_checkBodiesOnDemand = false;
+
     List<ShaderParamInfo> m_shaderParams;
     SpecializationParams m_specializationParams;
 
@@ -1985,6 +2068,10 @@ public:
 
     bool isChecked = false;
 
+    /// The context the module was checked in, kept when the module has function bodies that
+    /// are checked on demand, so that they are checked from the point of view of the module.
+    RefPtr<SharedSemanticsContext> sharedSemanticsForBodies;
+
     Module* getModule() { return module; }
     ModuleDecl* getModuleDecl() { return module->getModuleDecl(); }
 
@@ -2215,7 +2302,7 @@ enum ModuleBlobType
 class Linkage : public RefObject, public slang::ISession
 {
 public:
-    SLANG_REF_OBJECT_IUNKNOWN_ALL
+    SLANG_SESSION_OBJECT_IUNKNOWN_ALL
 
     CompilerOptionSet m_optionSet;
 
@@ -2302,8 +2389,13 @@ public:
     SlangResult addSearchPath(char const* path);
     SlangResult addPreprocessorDefine(char const* name, char const* value);
     SlangResult setMatrixLayoutMode(SlangMatrixLayoutMode mode);
-    /// Create an initially-empty linkage
-    Linkage(Session* session, ASTBuilder* astBuilder, Linkage* builtinLinkage);
+    /// Create an initially-empty linkage. AST and IR memory is allocated with memoryAllocator, or
+    /// if it is nullptr, with the session's allocator.
+    Linkage(
+        Session* session,
+        ASTBuilder* astBuilder,
+        Linkage* builtinLinkage,
+        MemoryAllocator* memoryAllocator = nullptr);
 
     /// Dtor
     ~Linkage();
@@ -2316,6 +2408,16 @@ public:
     /// Get the parent session for this linkage
     Session* getSessionImpl() { return m_session; }
 
+    /// Get the mutex that serializes API calls on this linkage, or null if it can only be
+    /// used from a single thread at a time.
+    SessionAccessMutex const& getSessionAccessMutex() { return m_sessionAccessMutex; }
+
+    /// Set when created with `CompilerOptionName::EnableConcurrentSessionAccess`.
+    ///
+    /// Held by every component type created from the linkage, and locked by the public API
+    /// entry points on both, so that threads sharing the session take turns.
+    SessionAccessMutex m_sessionAccessMutex;
+
     // Information on the targets we are being asked to
     // generate code for.
     List<RefPtr<TargetRequest>> targets;
@@ -2335,11 +2437,60 @@ public:
 
     ASTBuilder* getASTBuilder() { return m_astBuilder; }
 
+    /// Counts the memory held by the linkage's AST, and by IR modules and other arenas created
+    /// while compiling with it. Declared before anything holding those arenas, so it is
+    /// destroyed after them.
+    std::unique_ptr<MemoryAccounting> m_memoryAccounting;
+
     RefPtr<ASTBuilder> m_astBuilder;
 
     // Cache for container types.
     Dictionary<ContainerTypeKey, Type*> m_containerTypes;
 
+    /// Counts of the work done resolving overloaded calls, reported by
+    /// `-report-perf-benchmark`.
+    struct OverloadResolutionStats
+    {
+        Count callCount = 0;              ///< Calls resolved
+        Count checkedCandidateCount = 0;  ///< Candidates from lookup that were checked
+        Count filteredCandidateCount = 0; ///< Candidates ruled out without being checked
+        Count maxCandidatesPerCall = 0;   ///< Most candidates from lookup for one call
+        Count unfilteredCallCount = 0;    ///< Calls resolved again without the filter
+    };
+    OverloadResolutionStats m_overloadResolutionStats;
+
+    /// Containers IR passes took from the pools of the IR modules generated and linked with
+    /// this linkage, reported by `-report-perf-benchmark`.
+    ContainerPool::Stats m_containerPoolStats;
+
+    /// Dominator trees computed and reused by IR passes on the IR modules generated and linked
+    /// with this linkage, reported by `-report-perf-benchmark`.
+    IRAnalysisStats m_irAnalysisStats;
+
+    /// Get the accounting of the memory held by the linkage's AST, and by IR modules and other
+    /// arenas created while compiling with it.
+    MemoryAccounting* getMemoryAccounting() { return m_memoryAccounting.get(); }
+
+    /// Marks a compile that `CompilerOptionName::MemoryLimit` applies to. The memory counted
+    /// against the limit is the memory taken since the outermost scope started, so a module
+    /// loaded while compiling counts as part of that compile.
+    struct MemoryLimitScope
+    {
+        MemoryLimitScope(Linkage* linkage);
+        ~MemoryLimitScope();
+
+        Linkage* m_linkage;
+    };
+
+    /// If the memory taken by the current compile (see MemoryLimitScope) is over the limit set
+    /// with `CompilerOptionName::MemoryLimit`, report it to sink and abort the compilation.
+    void checkMemoryLimit(DiagnosticSink* sink);
+
+    /// Number of MemoryLimitScopes in effect
+    Index m_memoryLimitScopeDepth = 0;
+    /// The memory in use when the outermost MemoryLimitScope started
+    MemoryAccounting::Snapshot m_memoryAtCompileStart;
+
     // cache used by type checking, implemented in check.cpp
     TypeCheckingCache* getTypeCheckingCache();
     void destroyTypeCheckingCache();
@@ -2357,6 +2508,18 @@ public:
     // Map from the logical name of a module to its definition
     Dictionary<Name*, RefPtr<LoadedModule>> mapNameToLoadedModules;
 
+    /// Should modules imported right now leave their function bodies to be checked on demand?
+    ///
+    /// Set while the translation units of a compile request are checked with
+    /// `LazyImportedBodyChecking`.
+    bool m_checkImportedBodiesOnDemand = false;
+
+    /// Requests that loaded imported modules which still have unchecked function bodies, in
+    /// the order they were loaded. These modules don't have IR until
+    /// `checkImportedFunctionBodiesOnDemand` is done, and are removed from the linkage by
+    /// `forgetImportsWithUncheckedBodies`.
+    List<RefPtr<FrontEndCompileRequest>> m_importsWithUncheckedBodies;
+
     // Map from the mangled name of RTTI objects to sequential IDs
     // used by `switch`-based dynamic dispatch.
     Dictionary<String, uint32_t> mapMangledNameToRTTIObjectIndex;
@@ -2478,6 +2641,17 @@ public:
         Name* name,
         PathInfo const& pathInfo);
 
+    /// Check the function bodies that imported modules left unchecked, if the translation
+    /// units of `compileRequest` can reach them, and then generate IR for those modules.
+    void checkImportedFunctionBodiesOnDemand(FrontEndCompileRequest* compileRequest);
+
+    /// Remove the modules imported with function bodies left unchecked from the linkage.
+    ///
+    /// Such a module only has the bodies (and IR) that one compile needed, so it must not be
+    /// found by later imports or `loadModule` calls, which load a fully checked copy instead.
+    /// The compile that imported the modules keeps its own references to them.
+    void forgetImportsWithUncheckedBodies();
+
     bool isBinaryModuleUpToDate(String fromPath, RIFF::ListChunk const* baseChunk);
 
     RefPtr<Module> findOrImportModule(
@@ -2486,6 +2660,21 @@ public:
         DiagnosticSink* sink,
         const LoadedModuleDictionary* loadedModules = nullptr);
 
+    /// Start reading the files of the modules `moduleDecl` imports (and transitively the
+    /// modules they import) on worker threads, so they are ready when `findOrImportModule`
+    /// needs them. Only does anything with `CompilerOptionName::PrefetchImports`.
+    void prefetchImports(ModuleDecl* moduleDecl);
+
+    /// Marks a compile that imports may be prefetched for. When the outermost scope ends the
+    /// prefetcher is released, along with any files it read that the compile didn't use.
+    struct ImportPrefetchScope
+    {
+        ImportPrefetchScope(Linkage* linkage);
+        ~ImportPrefetchScope();
+
+        Linkage* m_linkage;
+    };
+
     SourceFile* findFile(Name* name, SourceLoc loc, IncludeSystem& outIncludeSystem);
     struct IncludeResult
     {
@@ -2583,6 +2772,19 @@ private:
     /// Diagnose that an error occured in the process of importing a module
     void _diagnoseErrorInImportedModule(DiagnosticSink* sink);
 
+    /// Load the contents of the file for an imported module, using prefetched contents if
+    /// available
+    SlangResult _loadImportedModuleFile(
+        IncludeSystem& includeSystem,
+        const PathInfo& pathInfo,
+        ComPtr<ISlangBlob>& outBlob);
+
+    /// Reads the files of imported modules ahead of time, with the PrefetchImports option.
+    /// Created on first use, and released at the end of the outermost ImportPrefetchScope.
+    RefPtr<ImportPrefetcher> m_importPrefetcher;
+    /// Number of ImportPrefetchScopes in effect
+    Index m_importPrefetchScopeDepth = 0;
+
     List<Type*> m_specializedTypes;
 
     RefPtr<SharedSemanticsContext> m_semanticsForReflection;
@@ -2867,6 +3069,26 @@ public:
 
     RefPtr<IRModule> getExistingIRModuleForLayout() { return m_irModuleForLayout; }
 
+    /// Get the IR linked once for all of the entry points in the program.
+    ///
+    /// This is used when `CompilerOptionName::ShareLinkedIR` is enabled. Code
+    /// generation for a single entry point then links from this module, instead
+    /// of resolving symbols across every module the program depends on again.
+    ///
+    /// Returns nullptr if linking failed, in which case entry points are linked from the
+    /// program's modules, which reports the errors. The failure is remembered, so linking
+    /// isn't tried again unless entry points are added to the program.
+    ///
+    IRModule* getOrCreateSharedLinkedIR();
+
+    IRModule* getExistingSharedLinkedIR() { return m_sharedLinkedIR; }
+
+    /// The layout for the global scope, as cloned into the shared linked IR
+    IRVarLayout* getExistingSharedLinkedIRGlobalScopeVarLayout()
+    {
+        return m_sharedLinkedIRGlobalScopeVarLayout;
+    }
+
     CompilerOptionSet& getOptionSet() { return m_optionSet; }
 
     HLSLToVulkanLayoutOptions* getHLSLToVulkanLayoutOptions()
@@ -2900,6 +3122,12 @@ private:
     List<ComPtr<IArtifact>> m_entryPointResults;
 
     RefPtr<IRModule> m_irModuleForLayout;
+
+    // The IR linked for all entry points, and the number of entry points it was linked for
+    // (or -1 if linking hasn't been tried). If linking failed m_sharedLinkedIR is nullptr.
+    RefPtr<IRModule> m_sharedLinkedIR;
+    IRVarLayout* m_sharedLinkedIRGlobalScopeVarLayout = nullptr;
+    Index m_sharedLinkedIREntryPointCount = -1;
 };
 
 /// A back-end-specific object to track optional feaures/capabilities/extensions
@@ -3115,8 +3343,20 @@ public:
     // ISlangUnknown
     SLANG_NO_THROW SlangResult SLANG_MCALL queryInterface(SlangUUID const& uuid, void** outObject)
         SLANG_OVERRIDE;
-    SLANG_REF_OBJECT_IUNKNOWN_ADD_REF
-    SLANG_REF_OBJECT_IUNKNOWN_RELEASE
+    SLANG_NO_THROW uint32_t SLANG_MCALL addRef() SLANG_OVERRIDE
+    {
+        SessionAccessLock sessionAccessLock(getSessionAccessMutex());
+        return (uint32_t)addReference();
+    }
+    SLANG_NO_THROW uint32_t SLANG_MCALL release() SLANG_OVERRIDE
+    {
+        SessionAccessLock sessionAccessLock(getSessionAccessMutex());
+        return (uint32_t)releaseReference();
+    }
+
+    /// A compile request made from a session shares the session's linkage, and so takes the
+    /// same lock as the session's other API calls. See `SessionAccessMutex`.
+    SessionAccessMutex const& getSessionAccessMutex() { return m_linkage->getSessionAccessMutex(); }
 
     // slang::ICompileRequest
     virtual SLANG_NO_THROW void SLANG_MCALL setFileSystem(ISlangFileSystem* fileSystem)
@@ -3744,6 +3984,17 @@ public:
 
     void init();
 
+    /// Finish any lazy initialization of the builtin state (builtin linkage, shared AST
+    /// builder, name pool), and make that state immutable from then on.
+    ///
+    /// A frozen session can be used concurrently from multiple threads for read only access to
+    /// the builtin state, and if the process is forked the pages holding that state stay shared
+    /// between the processes.
+    SlangResult freeze();
+
+    /// True once `freeze` has been called
+    bool isFrozen() const { return m_isFrozen; }
+
     void addBuiltinSource(
         Scope* scope,
         String const& path,
@@ -3775,6 +4026,15 @@ public:
     TypeCheckingCache* getTypeCheckingCache();
     std::mutex m_typeCheckingCacheMutex;
 
+    /// Set the allocator that sessions created from now on allocate AST and IR memory with, unless
+    /// their SessionDesc sets one. nullptr uses the heap.
+    void setMemoryAllocator(MemoryAllocator* allocator) { m_memoryAllocator = allocator; }
+    MemoryAllocator* getMemoryAllocator() { return m_memoryAllocator; }
+
+    RefPtr<MemoryAllocator> m_memoryAllocator;
+
+    bool m_isFrozen = false;
+
 private:
     struct BuiltinModuleInfo
     {
@@ -3815,6 +4075,12 @@ void checkTranslationUnit(
     TranslationUnitRequest* translationUnit,
     LoadedModuleDictionary& loadedModules);
 
+/// Check the function bodies left unchecked in `imports` that are reachable from the
+/// already checked `translationUnits`, or from the rest of the code in `imports`.
+void checkReachableFunctionBodies(
+    List<RefPtr<TranslationUnitRequest>> const& translationUnits,
+    List<RefPtr<TranslationUnitRequest>> const& imports);
+
 // Look for a module that matches the given name:
 // either one we've loaded already, or one we
 // can find vai the search paths available to us.
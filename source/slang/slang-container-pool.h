@@ -3,40 +3,82 @@
 
 #include "../core/slang-dictionary.h"
 #include "../core/slang-list.h"
-#include "../core/slang-virtual-object-pool.h"
+#include "../core/slang-memory-arena.h"
+#include "../core/slang-uint-set.h"
 
 // A pool to allow reuse of common types of containers to avoid
 // frequent resizing and rehashing.
 
 namespace Slang
 {
-static const int kContainerPoolSize = 1024;
 
+/// Holds objects of type T that are not in use, so they can be handed out again.
+///
+/// An object is cleared by its user before it is returned to the pool, but it keeps the memory
+/// it has allocated, so reusing it doesn't need to allocate again unless it grows larger. At
+/// most `kMaxFreeObjectCount` objects are kept, any more returned are deleted.
 template<typename T>
 struct ObjectPool
 {
-    ObjectPool(int maxElementCount)
+    enum
     {
-        m_pool.initPool(maxElementCount);
-        m_objects.setCount(maxElementCount);
+        kMaxFreeObjectCount = 64,
+    };
+
+    ObjectPool() = default;
+    ~ObjectPool()
+    {
+        for (auto object : m_objects)
+            delete object;
     }
 
     T* getObject()
     {
-        auto id = m_pool.alloc(1);
-        if (id == -1)
-            SLANG_UNEXPECTED("container pool allocation failure.");
-        return &m_objects[id];
+        m_takenCount++;
+
+        // Hand out the most recently freed object, as it's the most likely to be in cache
+        if (m_freeObjects.getCount())
+        {
+            const auto freeObject = m_freeObjects.getLast();
+            m_freeObjects.removeLast();
+            m_reusedCount++;
+            m_reusedByteCount += freeObject.byteCount;
+            return freeObject.object;
+        }
+
+        auto object = new T();
+        m_objects.add(object);
+        return object;
     }
 
-    void freeObject(T* object)
+    /// Return `object` to the pool, where `byteCount` is the size of the memory it kept
+    void freeObject(T* object, size_t byteCount)
     {
-        auto id = (int)(object - m_objects.getBuffer());
-        m_pool.free(id, 1);
+        if (m_freeObjects.getCount() < kMaxFreeObjectCount)
+        {
+            m_freeObjects.add(FreeObject{object, byteCount});
+            return;
+        }
+        // Only happens when more objects are in use at once than are kept, so the search is rare
+        m_objects.fastRemove(object);
+        delete object;
     }
 
-    VirtualObjectPool m_pool;
-    List<T> m_objects;
+    struct FreeObject
+    {
+        T* object;
+        size_t byteCount;
+    };
+
+    List<T*> m_objects;              ///< Every object created by the pool, and not deleted
+    List<FreeObject> m_freeObjects;  ///< The objects that are not in use
+    Count m_takenCount = 0;          ///< The number of times an object has been taken
+    Count m_reusedCount = 0;         ///< How many of those were an object used before
+    uint64_t m_reusedByteCount = 0;  ///< The memory kept by the reused objects
+
+private:
+    ObjectPool(const ObjectPool&) = delete;
+    void operator=(const ObjectPool&) = delete;
 };
 
 struct ContainerPool
@@ -44,11 +86,21 @@ struct ContainerPool
     ObjectPool<List<void*>> m_listPool;
     ObjectPool<Dictionary<void*, void*>> m_dictionaryPool;
     ObjectPool<HashSet<void*>> m_hashSetPool;
+    ObjectPool<UIntSet> m_uintSetPool;
+
+    /// Memory that a pass only needs until it is done, see `ScratchArenaScope`
+    MemoryArena m_scratchArena;
+
+    enum
+    {
+        kScratchArenaBlockSize = 16 * 1024,
+        /// A container that held more elements than this has its memory freed when it is
+        /// returned, so one large use doesn't keep its memory for the life of the module.
+        kMaxRetainedElementCount = 4096,
+    };
 
     ContainerPool()
-        : m_listPool(kContainerPoolSize)
-        , m_dictionaryPool(kContainerPoolSize)
-        , m_hashSetPool(kContainerPoolSize)
+        : m_scratchArena(kScratchArenaBlockSize)
     {
     }
 
@@ -70,27 +122,211 @@ struct ContainerPool
         return (HashSet<T*>*)m_hashSetPool.getObject();
     }
 
+    /// Get an empty set. It may still have a buffer sized for an earlier use.
+    UIntSet* getUIntSet() { return m_uintSetPool.getObject(); }
+
     template<typename T>
     void free(List<T*>* list)
     {
+        const Index capacity = list->getCapacity();
+        if (capacity > kMaxRetainedElementCount)
+        {
+            list->clearAndDeallocate();
+            m_listPool.freeObject((List<void*>*)list, 0);
+            return;
+        }
         list->clear();
-        m_listPool.freeObject((List<void*>*)list);
+        m_listPool.freeObject((List<void*>*)list, size_t(capacity) * sizeof(T*));
     }
 
+    // The capacity of a dictionary or set isn't available, so the memory it keeps is taken to be
+    // that of the elements it held, which it has at least enough room for.
+
     template<typename T, typename U>
     void free(Dictionary<T*, U*>* dict)
     {
+        const auto count = dict->getCount();
+        if (count > kMaxRetainedElementCount)
+        {
+            *dict = Dictionary<T*, U*>();
+            m_dictionaryPool.freeObject((Dictionary<void*, void*>*)dict, 0);
+            return;
+        }
         dict->clear();
-        m_dictionaryPool.freeObject((Dictionary<void*, void*>*)dict);
+        m_dictionaryPool.freeObject(
+            (Dictionary<void*, void*>*)dict,
+            count * (sizeof(T*) + sizeof(U*)));
     }
 
     template<typename T>
     void free(HashSet<T*>* set)
     {
+        const auto count = set->getCount();
+        if (count > kMaxRetainedElementCount)
+        {
+            *set = HashSet<T*>();
+            m_hashSetPool.freeObject((HashSet<void*>*)set, 0);
+            return;
+        }
+        set->clear();
+        m_hashSetPool.freeObject((HashSet<void*>*)set, count * sizeof(T*));
+    }
+
+    void free(UIntSet* set)
+    {
+        // The elements of a UIntSet's buffer each hold many values
+        const Index elementCount = set->getBuffer().getCount();
+        if (elementCount > kMaxRetainedElementCount)
+        {
+            set->clearAndDeallocate();
+            m_uintSetPool.freeObject(set, 0);
+            return;
+        }
         set->clear();
-        m_hashSetPool.freeObject((HashSet<void*>*)set);
+        m_uintSetPool.freeObject(set, size_t(elementCount) * sizeof(UIntSet::Element));
     }
+
+    /// Counts of containers taken from the pool, reported by `-report-perf-benchmark`
+    struct Stats
+    {
+        Count takenCount = 0; ///< Containers taken from the pool
+        /// Containers taken that were reused rather than created. Each saves at least one
+        /// allocation, more if the container would have grown to its reused size.
+        Count reusedCount = 0;
+        uint64_t reusedByteCount = 0; ///< The memory the reused containers already had
+
+        Stats& operator+=(const Stats& rhs)
+        {
+            takenCount += rhs.takenCount;
+            reusedCount += rhs.reusedCount;
+            reusedByteCount += rhs.reusedByteCount;
+            return *this;
+        }
+    };
+
+    Stats getStats() const
+    {
+        Stats stats;
+        stats.takenCount = m_listPool.m_takenCount + m_dictionaryPool.m_takenCount +
+                           m_hashSetPool.m_takenCount + m_uintSetPool.m_takenCount;
+        stats.reusedCount = m_listPool.m_reusedCount + m_dictionaryPool.m_reusedCount +
+                            m_hashSetPool.m_reusedCount + m_uintSetPool.m_reusedCount;
+        stats.reusedByteCount =
+            m_listPool.m_reusedByteCount + m_dictionaryPool.m_reusedByteCount +
+            m_hashSetPool.m_reusedByteCount + m_uintSetPool.m_reusedByteCount;
+        return stats;
+    }
+};
+
+/// A `List<T*>` taken from a `ContainerPool`, and given back when this goes out of scope.
+template<typename T>
+struct PooledList
+{
+    PooledList(ContainerPool& pool)
+        : m_pool(pool), m_list(pool.getList<T>())
+    {
+    }
+    ~PooledList() { m_pool.free(m_list); }
+
+    List<T*>& operator*() { return *m_list; }
+    List<T*>* operator->() { return m_list; }
+
+    ContainerPool& m_pool;
+    List<T*>* m_list;
+
+private:
+    PooledList(const PooledList&) = delete;
+    void operator=(const PooledList&) = delete;
 };
+
+/// A `HashSet<T*>` taken from a `ContainerPool`, and given back when this goes out of scope.
+template<typename T>
+struct PooledHashSet
+{
+    PooledHashSet(ContainerPool& pool)
+        : m_pool(pool), m_set(pool.getHashSet<T>())
+    {
+    }
+    ~PooledHashSet() { m_pool.free(m_set); }
+
+    HashSet<T*>& operator*() { return *m_set; }
+    HashSet<T*>* operator->() { return m_set; }
+
+    ContainerPool& m_pool;
+    HashSet<T*>* m_set;
+
+private:
+    PooledHashSet(const PooledHashSet&) = delete;
+    void operator=(const PooledHashSet&) = delete;
+};
+
+/// A `Dictionary<T*, U*>` taken from a `ContainerPool`, and given back when this goes out of
+/// scope.
+template<typename T, typename U>
+struct PooledDictionary
+{
+    PooledDictionary(ContainerPool& pool)
+        : m_pool(pool), m_dictionary(pool.getDictionary<T, U>())
+    {
+    }
+    ~PooledDictionary() { m_pool.free(m_dictionary); }
+
+    Dictionary<T*, U*>& operator*() { return *m_dictionary; }
+    Dictionary<T*, U*>* operator->() { return m_dictionary; }
+
+    ContainerPool& m_pool;
+    Dictionary<T*, U*>* m_dictionary;
+
+private:
+    PooledDictionary(const PooledDictionary&) = delete;
+    void operator=(const PooledDictionary&) = delete;
+};
+
+/// A `UIntSet` taken from a `ContainerPool`, and given back when this goes out of scope.
+///
+/// Useful as a set of instructions or blocks that have been numbered, see `IRInstNumbering`.
+struct PooledUIntSet
+{
+    PooledUIntSet(ContainerPool& pool)
+        : m_pool(pool), m_set(pool.getUIntSet())
+    {
+    }
+    ~PooledUIntSet() { m_pool.free(m_set); }
+
+    UIntSet& operator*() { return *m_set; }
+    UIntSet* operator->() { return m_set; }
+
+    ContainerPool& m_pool;
+    UIntSet* m_set;
+
+private:
+    PooledUIntSet(const PooledUIntSet&) = delete;
+    void operator=(const PooledUIntSet&) = delete;
+};
+
+/// Allocations made from the scratch arena of a `ContainerPool` while this is in scope are
+/// freed when it goes out of scope. Scopes can be nested, but must be exited in reverse order.
+///
+/// The memory is not destructed, so it should only be used for types that don't need it (such
+/// as arrays of pointers or indices).
+struct ScratchArenaScope
+{
+    ScratchArenaScope(ContainerPool& pool)
+        : m_arena(pool.m_scratchArena), m_cursor(pool.m_scratchArena.getCursor())
+    {
+    }
+    ~ScratchArenaScope() { m_arena.rewindToCursor(m_cursor); }
+
+    MemoryArena& getArena() { return m_arena; }
+
+    MemoryArena& m_arena;
+    void* m_cursor;
+
+private:
+    ScratchArenaScope(const ScratchArenaScope&) = delete;
+    void operator=(const ScratchArenaScope&) = delete;
+};
+
 } // namespace Slang
 
 #endif
@@ -323,6 +323,12 @@ DIAGNOSTIC(
     "downstream compiler '$0' doesn't support whole program compilation")
 DIAGNOSTIC(102, Note, downstreamCompileTime, "downstream compile time: $0s")
 DIAGNOSTIC(103, Note, performanceBenchmarkResult, "compiler performance benchmark:\n$0")
+DIAGNOSTIC(
+    104,
+    Fatal,
+    memoryLimitExceeded,
+    "compilation exceeded the memory limit of $0 MB (AST: $1 MB, IR: $2 MB, containers: $3 MB, "
+    "other: $4 MB)")
 DIAGNOSTIC(99999, Note, noteFailedToLoadDynamicLibrary, "failed to load dynamic library '$0'")
 
 //
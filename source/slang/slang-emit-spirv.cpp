@@ -9142,6 +9142,8 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
     SPIRVEmitContext(IRModule* module, TargetProgram* program, DiagnosticSink* sink)
         : SPIRVEmitSharedContext(module, program, sink), m_irModule(module), m_memoryArena(2048)
     {
+        auto accounting = program->getProgram()->getLinkage()->getMemoryAccounting();
+        m_memoryArena.setAccounting(accounting, MemoryAccounting::Category::Other);
     }
 };
 
@@ -660,6 +660,11 @@ Result linkAndOptimizeIR(
     auto irModule = outLinkedIR.module;
     auto irEntryPoints = outLinkedIR.entryPoints;
 
+    // Stop if linking has taken the memory in use over `CompilerOptionName::MemoryLimit`.
+    // The limit is checked again after the passes that can grow the IR the most.
+    auto linkage = codeGenContext->getLinkage();
+    linkage->checkMemoryLimit(sink);
+
     // For now, only emit the debug build identifier if separate debug info is enabled
     // and only if there are targets.
     // TODO: We will ultimately need to change this to always emit the instruction.
@@ -985,6 +990,7 @@ Result linkAndOptimizeIR(
     }
 
     finalizeSpecialization(irModule);
+    linkage->checkMemoryLimit(sink);
 
     // Lower `Result<T,E>` types into ordinary struct types. This must happen
     // after specialization, since otherwise incompatible copies of the lowered
@@ -1876,6 +1882,10 @@ Result linkAndOptimizeIR(
     if (!targetProgram->getOptionSet().shouldPerformMinimumOptimizations())
         checkUnsupportedInst(codeGenContext->getTargetReq(), irModule, sink);
 
+    linkage->checkMemoryLimit(sink);
+    linkage->m_containerPoolStats += irModule->getContainerPool().getStats();
+    linkage->m_irAnalysisStats += irModule->getAnalysisStats();
+
     return sink->getErrorCount() == 0 ? SLANG_OK : SLANG_FAIL;
 }
 
@@ -0,0 +1,384 @@
+// slang-import-prefetch.cpp
+#include "slang-import-prefetch.h"
+
+#include "../core/slang-char-util.h"
+#include "../core/slang-io.h"
+
+namespace Slang
+{
+
+namespace
+{ // anonymous
+
+class SearchDirectorySnapshot : public RefObject
+{
+public:
+    SearchDirectoryList list;
+};
+
+} // namespace
+
+String getFileNameFromModuleName(const UnownedStringSlice& moduleName, bool translateUnderScore)
+{
+    if (moduleName.endsWithCaseInsensitive(".slang"))
+    {
+        return moduleName;
+    }
+
+    StringBuilder sb;
+    for (auto c : moduleName)
+    {
+        if (translateUnderScore && c == '_')
+            c = '-';
+
+        sb.append(c);
+    }
+    sb.append(".slang");
+    return sb.produceString();
+}
+
+/* static */ Index ImportPrefetcher::getDefaultWorkerCount()
+{
+    // Reading files is mostly waiting on IO, so there is little gain from more threads than
+    // this, even with many cores.
+    const Index maxWorkerCount = 4;
+    return Math::Clamp(Index(std::thread::hardware_concurrency()), Index(1), maxWorkerCount);
+}
+
+ImportPrefetcher::ImportPrefetcher(ISlangFileSystemExt* fileSystem, Index workerCount)
+    : m_fileSystem(fileSystem), m_workerCount(workerCount)
+{
+}
+
+ImportPrefetcher::~ImportPrefetcher()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isQuitting = true;
+    }
+    m_jobAdded.notify_all();
+
+    for (auto& worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+bool ImportPrefetcher::_findModuleFile(
+    SearchDirectoryList* searchDirectories,
+    const UnownedStringSlice& moduleName,
+    const String& requestingPath,
+    String& outPath,
+    bool& outIsSource)
+{
+    IncludeSystem includeSystem(searchDirectories, m_fileSystem);
+
+    const String sourceFileNames[] = {
+        getFileNameFromModuleName(moduleName, false),
+        getFileNameFromModuleName(moduleName, true)};
+
+    // Like `findOrImportModule`, look for a precompiled module first.
+    for (auto isSource : {false, true})
+    {
+        for (const auto& sourceFileName : sourceFileNames)
+        {
+            const String fileName =
+                isSource ? sourceFileName : Path::replaceExt(sourceFileName, "slang-module");
+
+            PathInfo pathInfo;
+            if (SLANG_SUCCEEDED(includeSystem.findFile(fileName, requestingPath, pathInfo)))
+            {
+                outPath = pathInfo.foundPath;
+                outIsSource = isSource;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/* static */ void ImportPrefetcher::_findImports(
+    const UnownedStringSlice& source,
+    List<String>& outModuleNames)
+{
+    const char* cur = source.begin();
+    const char* const end = source.end();
+
+    auto skipWhitespace = [&]()
+    {
+        while (cur < end && CharUtil::isWhitespace(*cur))
+            cur++;
+    };
+
+    auto readIdentifier = [&]() -> UnownedStringSlice
+    {
+        const char* start = cur;
+        while (cur < end && (CharUtil::isAlphaOrDigit(*cur) || *cur == '_'))
+            cur++;
+        return UnownedStringSlice(start, cur);
+    };
+
+    while (cur < end)
+    {
+        const char c = *cur;
+        const char next = (cur + 1 < end) ? cur[1] : 0;
+
+        if (c == '/' && next == '/')
+        {
+            while (cur < end && *cur != '\n')
+                cur++;
+        }
+        else if (c == '/' && next == '*')
+        {
+            cur += 2;
+            while (cur < end && !(cur[0] == '*' && cur + 1 < end && cur[1] == '/'))
+                cur++;
+            cur = (cur < end) ? cur + 2 : end;
+        }
+        else if (c == '"' || c == '\'')
+        {
+            for (cur++; cur < end && *cur != c && *cur != '\n'; cur++)
+            {
+                if (*cur == '\\')
+                    cur++;
+            }
+            cur = (cur < end) ? cur + 1 : end;
+        }
+        else if (CharUtil::isDigit(c))
+        {
+            // Skip numeric literals as a whole, so suffixes aren't taken as identifiers
+            readIdentifier();
+        }
+        else if (CharUtil::isAlpha(c) || c == '_')
+        {
+            const UnownedStringSlice identifier = readIdentifier();
+            if (identifier != toSlice("import") && identifier != toSlice("__import"))
+                continue;
+
+            skipWhitespace();
+
+            StringBuilder moduleName;
+            if (cur < end && *cur == '"')
+            {
+                const char* start = ++cur;
+                while (cur < end && *cur != '"' && *cur != '\\' && *cur != '\n')
+                    cur++;
+                if (cur >= end || *cur != '"')
+                    continue;
+                moduleName.append(UnownedStringSlice(start, cur));
+                cur++;
+            }
+            else
+            {
+                // Identifier form, with the dotted sugar `import a.b;` meaning `a/b`
+                for (;;)
+                {
+                    const UnownedStringSlice part = readIdentifier();
+                    if (part.getLength() == 0)
+                        break;
+                    moduleName.append(part);
+
+                    skipWhitespace();
+                    if (cur >= end || *cur != '.')
+                        break;
+                    cur++;
+                    skipWhitespace();
+                    moduleName.append('/');
+                }
+            }
+
+            skipWhitespace();
+            if (moduleName.getLength() && cur < end && *cur == ';')
+            {
+                outModuleNames.add(moduleName.produceString());
+            }
+        }
+        else
+        {
+            cur++;
+        }
+    }
+}
+
+SearchDirectoryList* ImportPrefetcher::_getSearchDirectorySnapshot(
+    SearchDirectoryList& searchDirectories)
+{
+    // Search directories rarely change, so reuse the current snapshot if it still matches
+    if (auto current = m_currentSearchDirectories)
+    {
+        bool isSame = !searchDirectories.parent && current->searchDirectories.getCount() ==
+                                                       searchDirectories.searchDirectories.getCount();
+        for (Index i = 0; isSame && i < current->searchDirectories.getCount(); ++i)
+        {
+            isSame = current->searchDirectories[i].path ==
+                     searchDirectories.searchDirectories[i].path;
+        }
+        if (isSame)
+            return current;
+    }
+
+    // Flatten the list, deep copying the paths, so nothing is shared with the caller
+    RefPtr<SearchDirectorySnapshot> snapshot = new SearchDirectorySnapshot;
+    for (auto list = &searchDirectories; list; list = list->parent)
+    {
+        for (const auto& dir : list->searchDirectories)
+        {
+            snapshot->list.searchDirectories.add(
+                SearchDirectory(String(dir.path.getUnownedSlice())));
+        }
+    }
+
+    m_currentSearchDirectories = &snapshot->list;
+    m_searchDirectorySnapshots.add(snapshot);
+    return m_currentSearchDirectories;
+}
+
+void ImportPrefetcher::prefetch(
+    const UnownedStringSlice& moduleName,
+    const String& requestingPath,
+    SearchDirectoryList& searchDirectories)
+{
+    SearchDirectoryList* snapshot = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        snapshot = _getSearchDirectorySnapshot(searchDirectories);
+    }
+
+    // Resolve the file here rather than on a worker, so that a following `takeFile` for it
+    // always finds the entry.
+    String path;
+    bool isSource = false;
+    if (!_findModuleFile(snapshot, moduleName, requestingPath, path, isSource))
+        return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    _addJobLocked(path, isSource, snapshot);
+
+    // Start the workers on first use
+    if (m_workers.getCount() == 0)
+    {
+        for (Index i = 0; i < m_workerCount; ++i)
+        {
+            m_workers.add(std::thread([this]() { _workerThread(); }));
+        }
+    }
+}
+
+void ImportPrefetcher::_addJobLocked(
+    const String& path,
+    bool isSource,
+    SearchDirectoryList* searchDirectories)
+{
+    if (m_entries.containsKey(path))
+        return;
+
+    const String sharedPath(path.getUnownedSlice());
+    m_entries.add(sharedPath, Entry());
+
+    Job job;
+    job.path = String(path.getUnownedSlice());
+    job.isSource = isSource;
+    job.searchDirectories = searchDirectories;
+    m_jobs.add(_Move(job));
+
+    m_jobAdded.notify_one();
+}
+
+bool ImportPrefetcher::takeFile(const String& path, ComPtr<ISlangBlob>& outBlob)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    Entry* entry = m_entries.tryGetValue(path);
+    if (!entry || entry->isTaken)
+        return false;
+
+    while (!entry->isDone)
+    {
+        m_entryDone.wait(lock);
+        // The dictionary may have been rehashed while waiting
+        entry = m_entries.tryGetValue(path);
+    }
+
+    // Keep the entry so the file isn't read again, but release the contents
+    entry->isTaken = true;
+    outBlob.swap(entry->blob);
+    entry->blob.setNull();
+    return outBlob != nullptr;
+}
+
+void ImportPrefetcher::_processJob(const Job& job)
+{
+    ComPtr<ISlangBlob> blob;
+    m_fileSystem->loadFile(job.path.getBuffer(), blob.writeRef());
+
+    // Find the files for the modules this one imports. Binary modules record their
+    // dependencies in a form that needs the linkage to decode, so are not followed.
+    List<String> importPaths;
+    List<bool> importIsSource;
+    if (blob && job.isSource)
+    {
+        List<String> moduleNames;
+        _findImports(
+            UnownedStringSlice((const char*)blob->getBufferPointer(), blob->getBufferSize()),
+            moduleNames);
+
+        for (const auto& moduleName : moduleNames)
+        {
+            String path;
+            bool isSource = false;
+            if (_findModuleFile(
+                    job.searchDirectories,
+                    moduleName.getUnownedSlice(),
+                    job.path,
+                    path,
+                    isSource))
+            {
+                importPaths.add(path);
+                importIsSource.add(isSource);
+            }
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        Entry* entry = m_entries.tryGetValue(job.path);
+        SLANG_ASSERT(entry);
+        entry->blob.swap(blob);
+        entry->isDone = true;
+
+        for (Index i = 0; i < importPaths.getCount(); ++i)
+        {
+            _addJobLocked(importPaths[i], importIsSource[i], job.searchDirectories);
+        }
+    }
+    m_entryDone.notify_all();
+}
+
+void ImportPrefetcher::_workerThread()
+{
+    for (;;)
+    {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            while (!m_isQuitting && m_jobsStart >= m_jobs.getCount())
+            {
+                m_jobAdded.wait(lock);
+            }
+            if (m_isQuitting)
+                return;
+
+            job = _Move(m_jobs[m_jobsStart++]);
+            if (m_jobsStart >= m_jobs.getCount())
+            {
+                m_jobs.clear();
+                m_jobsStart = 0;
+            }
+        }
+
+        _processJob(job);
+    }
+}
+
+} // namespace Slang
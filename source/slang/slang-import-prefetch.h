@@ -0,0 +1,128 @@
+// slang-import-prefetch.h
+#ifndef SLANG_IMPORT_PREFETCH_H
+#define SLANG_IMPORT_PREFETCH_H
+
+#include "../compiler-core/slang-include-system.h"
+#include "../core/slang-basic.h"
+#include "slang-com-ptr.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace Slang
+{
+
+/// Derive the file name for the module `moduleName`, optionally replacing `_` with `-`.
+///
+/// For example, `foo_bar` becomes `foo-bar.slang` when `translateUnderScore` is set.
+String getFileNameFromModuleName(const UnownedStringSlice& moduleName, bool translateUnderScore);
+
+/// Discovers the import graph of a module ahead of semantic checking, and reads the files of
+/// the modules it imports on worker threads.
+///
+/// `import` declarations are resolved depth first while a module is being checked, so without
+/// prefetching every imported file is found and read serially, interleaved with the parsing and
+/// checking of the modules that import it. The prefetcher is given the imports of a module as
+/// soon as it has been parsed. It resolves them to files using the same search rules as
+/// `Linkage::findOrImportModule`, reads them concurrently, and finds the imports of each file read
+/// with a cheap lexical scan so the rest of the graph is read ahead too.
+///
+/// The scan doesn't preprocess, so it can find imports that are not used (for example in a
+/// disabled `#if` block) and miss ones produced by macros. That only affects how much is read
+/// ahead: the results are only used as the contents of files `findOrImportModule` itself decides
+/// to load.
+///
+/// The file system is used from the worker threads, so it must be safe to use from any thread.
+/// The linkage only prefetches with the OS file system, as user provided file systems may not be.
+///
+/// Files that were read but never taken are released when the prefetcher is destroyed, which the
+/// linkage does at the end of each compile (see `Linkage::ImportPrefetchScope`).
+class ImportPrefetcher : public RefObject
+{
+public:
+    /// Start finding and reading the file for the module `moduleName` imported from a file at
+    /// `requestingPath` (which can be empty), and the files of the modules it imports.
+    void prefetch(
+        const UnownedStringSlice& moduleName,
+        const String& requestingPath,
+        SearchDirectoryList& searchDirectories);
+
+    /// If the file at `path` has been prefetched, get its contents, waiting for the read to
+    /// complete if necessary. The contents of a file are only handed out once.
+    ///
+    /// Returns false if the file wasn't prefetched, or couldn't be read.
+    bool takeFile(const String& path, ComPtr<ISlangBlob>& outBlob);
+
+    /// Ctor. Worker threads are only started once there is something to prefetch.
+    ImportPrefetcher(ISlangFileSystemExt* fileSystem, Index workerCount);
+    ~ImportPrefetcher();
+
+    /// Get the default number of worker threads to use
+    static Index getDefaultWorkerCount();
+
+protected:
+    struct Job
+    {
+        String path;
+        bool isSource = false;
+        SearchDirectoryList* searchDirectories = nullptr;
+    };
+
+    struct Entry
+    {
+        ComPtr<ISlangBlob> blob;
+        bool isDone = false;
+        bool isTaken = false;
+    };
+
+    /// Find the file for `moduleName`, trying the same candidates as `findOrImportModule`
+    bool _findModuleFile(
+        SearchDirectoryList* searchDirectories,
+        const UnownedStringSlice& moduleName,
+        const String& requestingPath,
+        String& outPath,
+        bool& outIsSource);
+
+    /// Find the module names of the `import` declarations in `source`
+    static void _findImports(const UnownedStringSlice& source, List<String>& outModuleNames);
+
+    /// Get a search directory list equal to `searchDirectories` that is safe to use on workers.
+    /// Must be called on the thread that owns `searchDirectories`.
+    SearchDirectoryList* _getSearchDirectorySnapshot(SearchDirectoryList& searchDirectories);
+
+    /// Add a job for `path` if it hasn't been seen before. `m_mutex` must be held.
+    void _addJobLocked(const String& path, bool isSource, SearchDirectoryList* searchDirectories);
+
+    void _processJob(const Job& job);
+    void _workerThread();
+
+    // Note that `String` and `RefObject` reference counting isn't atomic. All strings that are
+    // shared between threads are deep copies that are only accessed with `m_mutex` held.
+
+    std::mutex m_mutex;
+    std::condition_variable m_jobAdded;
+    std::condition_variable m_entryDone;
+
+    List<Job> m_jobs;
+    Index m_jobsStart = 0;
+
+    /// Prefetched files, keyed by the found path
+    Dictionary<String, Entry> m_entries;
+
+    /// Search directory snapshots handed to jobs. They are kept until the prefetcher is
+    /// destroyed, so that jobs can use them without reference counting.
+    List<RefPtr<RefObject>> m_searchDirectorySnapshots;
+    SearchDirectoryList* m_currentSearchDirectories = nullptr;
+
+    /// The file system files are found and read with. Used from any thread.
+    ComPtr<ISlangFileSystemExt> m_fileSystem;
+
+    Index m_workerCount = 0;
+    List<std::thread> m_workers;
+    bool m_isQuitting = false;
+};
+
+} // namespace Slang
+
+#endif
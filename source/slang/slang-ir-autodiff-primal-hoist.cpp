@@ -431,7 +431,7 @@ RefPtr<HoistedPrimalsInfo> AutodiffCheckpointPolicyBase::processFunc(
 
     RefPtr<CheckpointSetInfo> checkpointInfo = new CheckpointSetInfo();
 
-    RefPtr<IRDominatorTree> domTree = computeDominatorTree(func);
+    RefPtr<IRDominatorTree> domTree = func->getModule()->findOrCreateDominatorTree(func);
 
     List<UseOrPseudoUse> workList;
     HashSet<UseOrPseudoUse> processedUses;
@@ -1134,7 +1134,7 @@ void AutodiffCheckpointPolicyBase::collectLoopExitConditions(IRGlobalValueWithCo
 {
     // Assume that the InductionValueInfo is already collected.
     IRBuilder builder(func->getModule());
-    RefPtr<IRDominatorTree> domTree = computeDominatorTree(func);
+    RefPtr<IRDominatorTree> domTree = func->getModule()->findOrCreateDominatorTree(func);
     for (auto block : func->getBlocks())
     {
         auto loopInst = as<IRLoop>(block->getTerminator());
@@ -1964,7 +1964,7 @@ RefPtr<HoistedPrimalsInfo> ensurePrimalAvailability(
     // }
     //
 
-    RefPtr<IRDominatorTree> domTree = computeDominatorTree(func);
+    RefPtr<IRDominatorTree> domTree = func->getModule()->findOrCreateDominatorTree(func);
 
     IRBlock* defaultVarBlock = func->getFirstBlock()->getNextBlock();
 
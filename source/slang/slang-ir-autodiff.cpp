@@ -65,6 +65,27 @@ IRInst* _lookupWitness(
     return nullptr;
 }
 
+static IRInst* _lookupWitness(
+    AutoDiffSharedContext* sharedContext,
+    IRBuilder* builder,
+    IRInst* witness,
+    IRInst* requirementKey,
+    IRType* resultType)
+{
+    if (auto result = _lookupWitness(builder, witness, requirementKey, resultType))
+        return result;
+
+    // A table imported from another module has no entries until the module is linked, so
+    // when generating derivatives ahead of linking the lookup is left for specialization.
+    if (!sharedContext->isModuleLinked)
+    {
+        auto witnessTable = as<IRWitnessTable>(witness);
+        if (witnessTable && witnessTable->findDecoration<IRImportDecoration>())
+            return builder->emitLookupInterfaceMethodInst(resultType, witness, requirementKey);
+    }
+    return nullptr;
+}
+
 static IRInst* _getDiffTypeFromPairType(
     AutoDiffSharedContext* sharedContext,
     IRBuilder* builder,
@@ -87,12 +108,14 @@ static IRInst* _getDiffTypeFromPairType(
 
     if (as<IRDifferentialPairType>(type) || as<IRDifferentialPairUserCodeType>(type))
         return _lookupWitness(
+            sharedContext,
             builder,
             witness,
             sharedContext->differentialAssocTypeStructKey,
             builder->getTypeKind());
     else if (as<IRDifferentialPtrPairType>(type))
         return _lookupWitness(
+            sharedContext,
             builder,
             witness,
             sharedContext->differentialAssocRefTypeStructKey,
@@ -110,12 +133,14 @@ static IRInst* _getDiffTypeWitnessFromPairType(
 
     if (as<IRDifferentialPairType>(type) || as<IRDifferentialPairUserCodeType>(type))
         return _lookupWitness(
+            sharedContext,
             builder,
             witnessTable,
             sharedContext->differentialAssocTypeWitnessStructKey,
             sharedContext->differentialAssocTypeWitnessTableType);
     else if (as<IRDifferentialPtrPairType>(type))
         return _lookupWitness(
+            sharedContext,
             builder,
             witnessTable,
             sharedContext->differentialAssocRefTypeWitnessStructKey,
@@ -1382,7 +1407,7 @@ IRInst* DifferentiableTypeConformanceContext::lookUpInterfaceMethod(
     DiffConformanceKind kind)
 {
     if (auto conformance = tryGetDifferentiableWitness(builder, origType, kind))
-        return _lookupWitness(builder, conformance, key, resultType);
+        return _lookupWitness(sharedContext, builder, conformance, key, resultType);
     return nullptr;
 }
 
@@ -1413,6 +1438,7 @@ IRInst* DifferentiableTypeConformanceContext::getDiffZeroMethodFromPairType(
 {
     auto witnessTable = type->getWitness();
     return _lookupWitness(
+        sharedContext,
         builder,
         witnessTable,
         sharedContext->zeroMethodStructKey,
@@ -1425,6 +1451,7 @@ IRInst* DifferentiableTypeConformanceContext::getDiffAddMethodFromPairType(
 {
     auto witnessTable = type->getWitness();
     return _lookupWitness(
+        sharedContext,
         builder,
         witnessTable,
         sharedContext->addMethodStructKey,
@@ -1926,6 +1953,7 @@ IRInst* DifferentiableTypeConformanceContext::buildDifferentiablePairWitness(
             // Since we are already dealing with a DiffPair<T>.Differnetial type, we know that
             // value type == diff type.
             auto innerAdd = _lookupWitness(
+                sharedContext,
                 &b,
                 innerWitness,
                 sharedContext->addMethodStructKey,
@@ -1955,6 +1983,7 @@ IRInst* DifferentiableTypeConformanceContext::buildDifferentiablePairWitness(
             zeroMethod->setFullType(b.getFuncType(0, nullptr, diffDiffPairType));
             b.emitBlock();
             auto innerZero = _lookupWitness(
+                sharedContext,
                 &b,
                 innerWitness,
                 sharedContext->zeroMethodStructKey,
@@ -2056,6 +2085,7 @@ IRInst* DifferentiableTypeConformanceContext::buildArrayWitness(
             // Since we are already dealing with a DiffPair<T>.Differnetial type, we know that
             // value type == diff type.
             auto innerAdd = _lookupWitness(
+                sharedContext,
                 &b,
                 innerWitness,
                 sharedContext->addMethodStructKey,
@@ -2088,6 +2118,7 @@ IRInst* DifferentiableTypeConformanceContext::buildArrayWitness(
             b.emitBlock();
 
             auto innerZero = _lookupWitness(
+                sharedContext,
                 &b,
                 innerWitness,
                 sharedContext->zeroMethodStructKey,
@@ -2195,6 +2226,7 @@ IRInst* DifferentiableTypeConformanceContext::buildTupleWitness(
                 else
                 {
                     auto innerAdd = _lookupWitness(
+                        sharedContext,
                         &b,
                         innerWitness,
                         sharedContext->addMethodStructKey,
@@ -2241,6 +2273,7 @@ IRInst* DifferentiableTypeConformanceContext::buildTupleWitness(
                 else
                 {
                     auto innerZero = _lookupWitness(
+                        sharedContext,
                         &b,
                         innerWitness,
                         sharedContext->zeroMethodStructKey,
@@ -3530,6 +3563,48 @@ struct AutoDiffPass : public InstPassBase
         return hasChanges;
     }
 
+    // Generate forward derivatives for `funcs` without processing any other differentiate
+    // insts. The generated bodies may still contain `ForwardDifferentiate` insts for their
+    // callees, and pair types that haven't been rewritten to user code. Both are handled by
+    // `processReferencedFunctions` once the module has been linked.
+    //
+    void precompileForwardDerivatives(List<IRFunc*> const& funcs)
+    {
+        forwardTranscriber.differentiableTypeConformanceContext.buildGlobalWitnessDictionary();
+
+        IRBuilder builder(module);
+        for (auto func : funcs)
+        {
+            builder.setInsertBefore(func);
+            forwardTranscriber.transcribe(&builder, func);
+        }
+
+        List<IRFunc*> diffFuncs;
+        while (autodiffContext->followUpFunctionsToTranscribe.getCount() != 0)
+        {
+            auto followUpWorkList = _Move(autodiffContext->followUpFunctionsToTranscribe);
+            for (auto task : followUpWorkList)
+            {
+                auto diffFunc = as<IRFunc>(task.resultFunc);
+                SLANG_ASSERT(diffFunc);
+                if (!diffFunc->getDataType())
+                    continue;
+
+                SLANG_ASSERT(task.type == FuncBodyTranscriptionTaskType::Forward);
+                auto primalFunc = as<IRFunc>(task.originalFunc);
+                forwardTranscriber.transcribeFunc(&builder, primalFunc, diffFunc);
+                diffFuncs.add(diffFunc);
+            }
+        }
+
+        for (auto diffFunc : diffFuncs)
+            stripTempDecorations(diffFunc);
+
+#if _DEBUG
+        validateIRModule(module, sink);
+#endif
+    }
+
     IRStringLit* getDerivativeFuncName(IRInst* func, const char* postFix)
     {
         IRBuilder builder(autodiffContext->moduleInst);
@@ -3676,6 +3751,66 @@ bool processAutodiffCalls(
     return modified;
 }
 
+// Can forward derivatives of `func` be generated before the module is linked?
+static bool _canPrecompileForwardDerivative(IRInst* inst)
+{
+    auto func = as<IRFunc>(inst);
+    if (!func || !func->getFirstBlock())
+        return false;
+
+    // Only functions the linker can resolve by name, and that don't have a derivative yet.
+    if (!func->findDecoration<IRExportDecoration>() ||
+        !func->findDecoration<IRForwardDifferentiableDecoration>() ||
+        func->findDecoration<IRForwardDerivativeDecoration>() ||
+        func->findDecoration<IRTreatAsDifferentiableDecoration>())
+        return false;
+
+    return true;
+}
+
+// The module needs its own copy of `IDifferentiable`, with all of its requirements, for the
+// transcriber to work before linking.
+static bool _hasDifferentiableInterface(IRModule* module)
+{
+    for (auto globalInst : module->getGlobalInsts())
+    {
+        if (auto intf = as<IRInterfaceType>(globalInst))
+        {
+            if (auto decor = intf->findDecoration<IRKnownBuiltinDecoration>())
+            {
+                if (decor->getName() == toSlice("IDifferentiable"))
+                    return intf->getRequirementCount() >=
+                           AutoDiffSharedContext::kDifferentiableInterfaceRequirementCount;
+            }
+        }
+    }
+    return false;
+}
+
+SlangResult precompileForwardDerivatives(IRModule* module, DiagnosticSink* sink)
+{
+    SLANG_PROFILE;
+
+    // Generic functions are only referenced through `specialize` and are left to the linker.
+    List<IRFunc*> funcs;
+    for (auto inst : module->getGlobalInsts())
+    {
+        if (_canPrecompileForwardDerivative(inst))
+            funcs.add(as<IRFunc>(inst));
+    }
+    if (funcs.getCount() == 0 || !_hasDifferentiableInterface(module))
+        return SLANG_OK;
+
+    AutoDiffSharedContext autodiffContext(nullptr, module->getModuleInst());
+    autodiffContext.isModuleLinked = false;
+
+    const auto errorCount = sink->getErrorCount();
+    AutoDiffPass pass(&autodiffContext, sink);
+    pass.precompileForwardDerivatives(funcs);
+
+    return sink->getErrorCount() == errorCount ? SLANG_OK : SLANG_FAIL;
+}
+
 struct RemoveDetachInstsPass : InstPassBase
 {
     RemoveDetachInstsPass(IRModule* module)
@@ -141,6 +141,17 @@ struct AutoDiffSharedContext
     bool isInterfaceAvailable = false;
     bool isPtrInterfaceAvailable = false;
 
+    // The number of requirements of IDifferentiable that are looked up by index below:
+    // `Differential`, its witness, `dzero`, `dadd` and `dmul`.
+    //
+    static const UInt kDifferentiableInterfaceRequirementCount = 5;
+
+    // False when derivatives are generated for a module that hasn't been linked, by
+    // `precompileForwardDerivatives`. Witness tables imported from other modules then
+    // have no entries, so lookups into them are left for specialization to resolve.
+    //
+    bool isModuleLinked = true;
+
     List<FuncBodyTranscriptionTask> followUpFunctionsToTranscribe;
 
     DiffTranscriberSet transcriberSet;
@@ -583,6 +594,12 @@ bool processAutodiffCalls(
 
 bool finalizeAutoDiffPass(TargetProgram* target, IRModule* module);
 
+// Generate forward derivatives for the non-generic differentiable functions with linkage in an
+// unlinked `module`, and attach them with `IRForwardDerivativeDecoration` so they are
+// serialized with the module and reused when it is linked. Errors are reported to `sink`, and
+// make this fail.
+SlangResult precompileForwardDerivatives(IRModule* module, DiagnosticSink* sink);
+
 // Utility methods
 
 void copyCheckpointHints(
@@ -1,6 +1,7 @@
 // slang-ir-dce.cpp
 #include "slang-ir-dce.h"
 
+#include "slang-ir-inst-numbering.h"
 #include "slang-ir-insts.h"
 #include "slang-ir-util.h"
 #include "slang-ir.h"
@@ -29,16 +30,45 @@ struct DeadCodeEliminationContext
     // there could be new DCE opportunities.
     bool phiRemoved = false;
 
+    // When the root is a function (or other code), which is
+    // how DCE is most often run, the instructions under it
+    // are numbered, and the live ones are tracked in sets
+    // indexed by their numbers.
+    //
+    // Only instructions under the root can be eliminated,
+    // so anything without a number is never put on the
+    // work list.
+    //
+    // The sets are taken from the module's container pool,
+    // like the work list below.
+    //
+    IRGlobalValueWithCode* numberedRoot = nullptr;
+    IRInstNumbering numbering;
+    UIntSet& liveBlocks;
+    UIntSet& liveInsts;
+    bool isRootLive = false;
+
     // Querying whether an instruction has been
     // determined to be live is easy.
-    // To speedup the test, we use the
+    // Without a numbered root, we use the
     // `scratchData` field of each inst as the marker.
     //
     bool isInstAlive(IRInst* inst)
     {
         if (!inst)
             return false;
-        return inst->scratchData != 0;
+        if (!numberedRoot)
+            return inst->scratchData != 0;
+
+        if (inst == numberedRoot)
+            return isRootLive;
+        auto block = as<IRBlock>(inst);
+        const Index index = block ? numbering.getBlockIndex(block) : numbering.getInstIndex(inst);
+
+        // An instruction without a number was added since the root was numbered, so it is kept
+        if (index == IRInstNumbering::kInvalidIndex)
+            return true;
+        return (block ? liveBlocks : liveInsts).contains(UInt(index));
     }
 
     // We are going to do an iterative analysis
@@ -53,7 +83,26 @@ struct DeadCodeEliminationContext
     // looked at their impact on other
     // instructions.
     //
-    List<IRInst*> workList;
+    // The list is taken from the module's container pool, as DCE runs on every
+    // function many times over.
+    //
+    List<IRInst*>& workList;
+
+    DeadCodeEliminationContext(IRModule* inModule, IRDeadCodeEliminationOptions const& inOptions)
+        : module(inModule)
+        , options(inOptions)
+        , liveBlocks(*inModule->getContainerPool().getUIntSet())
+        , liveInsts(*inModule->getContainerPool().getUIntSet())
+        , workList(*inModule->getContainerPool().getList<IRInst>())
+    {
+    }
+    ~DeadCodeEliminationContext()
+    {
+        auto& pool = module->getContainerPool();
+        pool.free(&workList);
+        pool.free(&liveInsts);
+        pool.free(&liveBlocks);
+    }
 
     // When we discover that an instruction seems
     // to be live, we will add it to our set,
@@ -68,6 +117,12 @@ struct DeadCodeEliminationContext
         if (!inst)
             return;
 
+        if (numberedRoot)
+        {
+            markNumberedInstAsLive(inst);
+            return;
+        }
+
         if (!inst->scratchData)
         {
             inst->scratchData = 1;
@@ -75,6 +130,35 @@ struct DeadCodeEliminationContext
         }
     }
 
+    void markNumberedInstAsLive(IRInst* inst)
+    {
+        if (inst == numberedRoot)
+        {
+            if (!isRootLive)
+            {
+                isRootLive = true;
+                workList.add(inst);
+            }
+            return;
+        }
+
+        if (auto block = as<IRBlock>(inst))
+            markNumberedAsLive(liveBlocks, numbering.getBlockIndex(block), inst);
+        else
+            markNumberedAsLive(liveInsts, numbering.getInstIndex(inst), inst);
+    }
+
+    // An instruction without a number isn't under the root, so it is left alone.
+    //
+    void markNumberedAsLive(UIntSet& liveSet, Index index, IRInst* inst)
+    {
+        if (index == IRInstNumbering::kInvalidIndex || liveSet.contains(UInt(index)))
+            return;
+
+        liveSet.add(UInt(index));
+        workList.add(inst);
+    }
+
     IRInst* getUndefInst()
     {
         if (!undefInst)
@@ -97,8 +181,20 @@ struct DeadCodeEliminationContext
 
         for (;;)
         {
-            // Clear the `alive` bits by initializing all scratchData to 0.
-            initializeScratchData(root);
+            numberedRoot = as<IRGlobalValueWithCode>(root);
+            if (numberedRoot)
+            {
+                // Number everything under the root, and start with nothing live.
+                numbering.buildForDescendants(numberedRoot);
+                liveBlocks.resizeAndClear(UInt(numbering.getBlockCount()));
+                liveInsts.resizeAndClear(UInt(numbering.getInstCount()));
+                isRootLive = false;
+            }
+            else
+            {
+                // Clear the `alive` bits by initializing all scratchData to 0.
+                initializeScratchData(root);
+            }
 
             workList.clear();
 
@@ -126,7 +222,8 @@ struct DeadCodeEliminationContext
                 auto inst = workList.getLast();
                 workList.removeLast();
 
-                if (!isChildInstOf(inst, root))
+                // With a numbered root, only instructions under it are on the work list.
+                if (!numberedRoot && !isChildInstOf(inst, root))
                     continue;
 
                 // At this point we know that `inst` is live,
@@ -257,10 +354,10 @@ struct DeadCodeEliminationContext
             // We need to cache all children in a work list to ensure they are
             // properly traversed.
             //
-            List<IRInst*> children;
+            PooledList<IRInst> children(module->getContainerPool());
             for (auto child : inst->getDecorationsAndChildren())
-                children.add(child);
-            for (IRInst* child : children)
+                children->add(child);
+            for (IRInst* child : *children)
             {
                 changed |= eliminateDeadInstsRec(child);
             }
@@ -683,17 +780,13 @@ bool isWeakReferenceOperand(IRInst* inst, UInt operandIndex)
 //
 bool eliminateDeadCode(IRModule* module, IRDeadCodeEliminationOptions const& options)
 {
-    DeadCodeEliminationContext context;
-    context.module = module;
-    context.options = options;
+    DeadCodeEliminationContext context(module, options);
     return context.processModule();
 }
 
 bool eliminateDeadCode(IRInst* root, IRDeadCodeEliminationOptions const& options)
 {
-    DeadCodeEliminationContext context;
-    context.module = root->getModule();
-    context.options = options;
+    DeadCodeEliminationContext context(root->getModule(), options);
     return context.processInst(root);
 }
 
@@ -1,6 +1,7 @@
 #include "slang-ir-glsl-liveness.h"
 
 #include "slang-ir-dominators.h"
+#include "slang-ir-inst-numbering.h"
 #include "slang-ir-insts.h"
 #include "slang-ir.h"
 
@@ -23,15 +24,17 @@ struct GLSLLivenessContext
     void processModule();
 
     GLSLLivenessContext(IRModule* module)
-        : m_module(module), m_builder(module)
+        : m_markers(module->getContainerPool()), m_module(module), m_builder(module)
     {
     }
 
     void _replaceMarker(IRLiveRangeMarker* liveMarker);
     void _addDecorations(Kind kind, IRFunc* func);
 
-    /// Process a function in the module
+    /// Replace the liveness markers in a function of the module
     void _processFunction(IRFunc* funcInst);
+    /// True if the function has any liveness markers
+    static bool _hasMarkers(IRFunc* funcInst);
 
     IRType* _getReferencedType(IRInst* referenced);
 
@@ -58,7 +61,10 @@ struct GLSLLivenessContext
         IRInst* m_spirvOpLiteral = nullptr;       ///< The SPIR-V opcode for the kind
     };
 
-    List<IRLiveRangeMarker*> m_markerInsts; ///< All of the liveness marker instrucitons found
+    List<IRFunc*> m_funcs; ///< The functions that have liveness markers
+
+    IRInstNumbering m_numbering; ///< Numbering of the function being processed
+    PooledUIntSet m_markers;     ///< Numbers of the liveness markers in that function
 
     Entry m_entries[Index(Kind::CountOf)]; /// Entry for each kind of function
 
@@ -69,20 +75,39 @@ struct GLSLLivenessContext
     IRBuilder m_builder;
 };
 
-void GLSLLivenessContext::_processFunction(IRFunc* funcInst)
+/* static */ bool GLSLLivenessContext::_hasMarkers(IRFunc* funcInst)
 {
-    // Iterate through blocks in the function, looking for variables to live track
     for (auto block = funcInst->getFirstBlock(); block; block = block->getNextBlock())
     {
         for (auto inst = block->getFirstChild(); inst; inst = inst->getNextInst())
         {
-            IRLiveRangeMarker* marker = as<IRLiveRangeMarker>(inst);
-            if (marker)
+            if (as<IRLiveRangeMarker>(inst))
             {
-                m_markerInsts.add(marker);
+                return true;
             }
         }
     }
+    return false;
+}
+
+void GLSLLivenessContext::_processFunction(IRFunc* funcInst)
+{
+    // Find all of the markers before replacing any, so the traversal isn't disturbed by the
+    // replacements. The markers are looked up through the numbering as they are replaced.
+    m_numbering.build(funcInst);
+    m_markers->resizeAndClear(UInt(m_numbering.getInstCount()));
+    for (Index i = 0; i < m_numbering.getInstCount(); ++i)
+    {
+        if (as<IRLiveRangeMarker>(m_numbering.getInst(i)))
+        {
+            m_markers->add(UInt(i));
+        }
+    }
+
+    for (auto index : *m_markers)
+    {
+        _replaceMarker(static_cast<IRLiveRangeMarker*>(m_numbering.getInst(Index(index))));
+    }
 }
 
 void GLSLLivenessContext::_addDecorations(Kind kind, IRFunc* func)
@@ -178,25 +203,23 @@ void GLSLLivenessContext::_replaceMarker(IRLiveRangeMarker* markerInst)
 
 void GLSLLivenessContext::processModule()
 {
-    // Find all of the liveness marker insts
+    // Find all of the functions with liveness marker insts
     //
     // This is done prior to processing, so we don't need to worry about traversal when
-    // instructions are replaced.
+    // functions are added to the module.
 
     IRModuleInst* moduleInst = m_module->getModuleInst();
     for (IRInst* child : moduleInst->getChildren())
     {
-        // We want to find all of the functions, and process them
-        if (auto funcInst = as<IRFunc>(child))
+        auto funcInst = as<IRFunc>(child);
+        if (funcInst && _hasMarkers(funcInst))
         {
-            // Then we want to look through their definition
-            // inserting instructions that mark the liveness start/end
-            _processFunction(funcInst);
+            m_funcs.add(funcInst);
         }
     }
 
     // If we didn't find any liveness marker instructions then we are done
-    if (!m_markerInsts.getCount())
+    if (!m_funcs.getCount())
     {
         return;
     }
@@ -229,11 +252,11 @@ void GLSLLivenessContext::processModule()
         entry.m_spirvOpLiteral = m_builder.getIntValue(m_builder.getIntType(), 257);
     }
 
-    // Iterate across instructions, replacing with a call to a generated function (one that just is
+    // Replace the markers in each function with a call to a generated function (one that just is
     // a declaration defining the SPIR-V op)
-    for (auto markerInst : m_markerInsts)
+    for (auto funcInst : m_funcs)
     {
-        _replaceMarker(markerInst);
+        _processFunction(funcInst);
     }
 }
 
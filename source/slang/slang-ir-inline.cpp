@@ -51,20 +51,20 @@ struct InliningPassBase
             bool changed = false;
 
             // Collect all the call sites in the function.
-            List<IRCall*> callsites;
+            PooledList<IRCall> callsites(m_module->getContainerPool());
             for (auto block : func->getBlocks())
             {
                 for (auto inst : block->getChildren())
                 {
                     if (auto call = as<IRCall>(inst))
                     {
-                        callsites.add(call);
+                        callsites->add(call);
                     }
                 }
             }
 
             // Consider each call site.
-            for (auto call : callsites)
+            for (auto call : *callsites)
             {
                 changed |= considerCallSite(call);
             }
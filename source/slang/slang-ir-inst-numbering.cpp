@@ -0,0 +1,44 @@
+// slang-ir-inst-numbering.cpp
+#include "slang-ir-inst-numbering.h"
+
+namespace Slang
+{
+
+void IRInstNumbering::build(IRGlobalValueWithCode* code)
+{
+    clear();
+
+    for (auto block : code->getBlocks())
+    {
+        _numberBlock(block);
+
+        for (auto inst : block->getChildren())
+        {
+            _numberInst(inst);
+        }
+    }
+}
+
+void IRInstNumbering::buildForDescendants(IRGlobalValueWithCode* code)
+{
+    clear();
+    _numberDescendants(code);
+}
+
+void IRInstNumbering::_numberDescendants(IRInst* parent)
+{
+    for (auto child : parent->getDecorationsAndChildren())
+    {
+        if (auto block = as<IRBlock>(child))
+        {
+            _numberBlock(block);
+        }
+        else
+        {
+            _numberInst(child);
+        }
+        _numberDescendants(child);
+    }
+}
+
+} // namespace Slang
@@ -0,0 +1,113 @@
+// slang-ir-inst-numbering.h
+#pragma once
+
+#include "../core/slang-basic.h"
+#include "../core/slang-uint-set.h"
+#include "slang-ir.h"
+
+namespace Slang
+{
+
+/// A dense numbering of the blocks of a function (or other code-bearing value), and of the
+/// instructions (including parameters) in those blocks.
+///
+/// Blocks are numbered from 0 in the order they appear, and so are instructions, so a pass can
+/// keep per-block or per-instruction state in arrays, and track sets of blocks or instructions
+/// as `UIntSet`s, rather than hashing pointers.
+///
+/// The number of an instruction is held in its `scratchData`, and is only trusted if the
+/// numbering maps it back to the same instruction. This means that the numbering is invalidated
+/// a piece at a time as the function is changed:
+/// * Instructions created after the numbering was built have no number.
+/// * Removed instructions keep their numbers, which are never reused.
+/// * A pass that writes `scratchData` itself invalidates the numbers of what it writes to, so
+///   a numbering shouldn't be used across code that does.
+///
+/// Rebuild the numbering if instructions that have been added need numbers.
+struct IRInstNumbering
+{
+    enum : Index
+    {
+        kInvalidIndex = -1,
+    };
+
+    /// Number the blocks of `code`, and the instructions in them, replacing any earlier numbering
+    void build(IRGlobalValueWithCode* code);
+    /// Number every descendant of `code`, replacing any earlier numbering. Blocks (including
+    /// those of nested code, such as the function inside a generic) get block numbers, and
+    /// everything else, including decorations, gets an instruction number. `code` has no number.
+    void buildForDescendants(IRGlobalValueWithCode* code);
+
+    /// Get the number of `block`, or kInvalidIndex if it is null or has no number
+    Index getBlockIndex(IRBlock* block) const
+    {
+        return block ? _getIndex(m_blocks.getBuffer(), m_blocks.getCount(), block)
+                     : kInvalidIndex;
+    }
+    /// Get the number of `inst`, or kInvalidIndex if it has no number
+    Index getInstIndex(IRInst* inst) const
+    {
+        return _getIndex(m_insts.getBuffer(), m_insts.getCount(), inst);
+    }
+
+    IRBlock* getBlock(Index index) const { return m_blocks[index]; }
+    IRInst* getInst(Index index) const { return m_insts[index]; }
+
+    Count getBlockCount() const { return m_blocks.getCount(); }
+    Count getInstCount() const { return m_insts.getCount(); }
+
+    /// Get the blocks in the order they are numbered
+    ConstArrayView<IRBlock*> getBlocks() const { return m_blocks.getArrayView(); }
+
+    /// Add `inst` to `set` by its number. Returns false if `inst` has no number.
+    bool addInst(UIntSet& set, IRInst* inst) const
+    {
+        const Index index = getInstIndex(inst);
+        if (index == kInvalidIndex)
+            return false;
+        set.add(UInt(index));
+        return true;
+    }
+    /// True if `inst` has a number that is in `set`
+    bool containsInst(const UIntSet& set, IRInst* inst) const
+    {
+        const Index index = getInstIndex(inst);
+        return index != kInvalidIndex && set.contains(UInt(index));
+    }
+
+    /// Clear the numbering, keeping the memory for reuse
+    void clear()
+    {
+        m_blocks.clear();
+        m_insts.clear();
+    }
+
+protected:
+    /// Give `block` the next block number
+    void _numberBlock(IRBlock* block)
+    {
+        m_blocks.add(block);
+        block->scratchData = UInt64(m_blocks.getCount());
+    }
+    /// Give `inst` the next instruction number
+    void _numberInst(IRInst* inst)
+    {
+        m_insts.add(inst);
+        inst->scratchData = UInt64(m_insts.getCount());
+    }
+    /// Number the decorations and children of `parent`, and all of their descendants
+    void _numberDescendants(IRInst* parent);
+
+    template<typename T>
+    static Index _getIndex(T* const* items, Count count, IRInst* inst)
+    {
+        // Numbers are stored plus one, so that the 0 a new instruction starts with is never valid
+        const Index index = Index(inst->scratchData) - 1;
+        return (UInt(index) < UInt(count) && items[index] == inst) ? index : kInvalidIndex;
+    }
+
+    List<IRBlock*> m_blocks;
+    List<IRInst*> m_insts;
+};
+
+} // namespace Slang
@@ -1610,7 +1610,7 @@ void initializeSharedSpecContext(
     RefPtr<IRModule> module = inModule;
     if (!module)
     {
-        module = IRModule::create(session);
+        module = IRModule::create(session, targetReq->getLinkage()->getMemoryAccounting());
     }
 
     sharedContext->builderStorage = IRBuilder(module);
@@ -2050,25 +2050,43 @@ LinkedIR linkIR(CodeGenContext* codeGenContext)
     //
     auto globalSession = static_cast<Session*>(linkage->getGlobalSession());
     List<IRModule*> builtinModules;
-    for (auto& m : globalSession->coreModules)
-        builtinModules.add(m->getIRModule());
+    auto sharedLinkedIR = targetProgram->getExistingSharedLinkedIR();
+    if (sharedLinkedIR)
+    {
+        // The program has already been linked for all of its entry points. That
+        // module holds a resolved definition of everything the entry points can
+        // reference, so there is no need to search the program's modules (and
+        // the builtin modules) again.
+        //
+        irModules.add(sharedLinkedIR);
+    }
+    else
+    {
+        for (auto& m : globalSession->coreModules)
+            builtinModules.add(m->getIRModule());
 
-    // Link modules in the program.
-    program->enumerateIRModules(
-        [&](IRModule* module)
-        {
-            if (module->getName() == globalSession->glslModuleName)
-                builtinModules.add(module);
-            else
-                irModules.add(module);
-        });
+        // Link modules in the program.
+        program->enumerateIRModules(
+            [&](IRModule* module)
+            {
+                if (module->getName() == globalSession->glslModuleName)
+                    builtinModules.add(module);
+                else
+                    irModules.add(module);
+            });
+    }
 
     // We will also consider the IR global symbols from the IR module
     // attached to the `TargetProgram`, since this module is
     // responsible for associating layout information to those
     // global symbols via decorations.
     //
-    auto irModuleForLayout = targetProgram->getExistingIRModuleForLayout();
+    // The shared linked IR already holds the global parameters from that
+    // module, with their layouts, so it isn't searched again. Otherwise there
+    // would be two definitions of each of those parameters to pick between.
+    //
+    auto irModuleForLayout =
+        sharedLinkedIR ? nullptr : targetProgram->getExistingIRModuleForLayout();
     if (irModuleForLayout)
         irModules.add(irModuleForLayout);
 
@@ -2135,7 +2153,16 @@ LinkedIR linkIR(CodeGenContext* codeGenContext)
     // need to operate on all the global parameters can do so.
     //
     IRVarLayout* irGlobalScopeVarLayout = nullptr;
-    if (irModuleForLayout)
+    if (sharedLinkedIR)
+    {
+        if (auto sharedGlobalScopeVarLayout =
+                targetProgram->getExistingSharedLinkedIRGlobalScopeVarLayout())
+        {
+            irGlobalScopeVarLayout =
+                cast<IRVarLayout>(cloneValue(context, sharedGlobalScopeVarLayout));
+        }
+    }
+    else if (irModuleForLayout)
     {
         if (auto irGlobalScopeLayoutDecoration =
                 irModuleForLayout->getModuleInst()->findDecoration<IRLayoutDecoration>())
@@ -1,6 +1,7 @@
 #include "slang-ir-liveness.h"
 
 #include "slang-ir-dominators.h"
+#include "slang-ir-inst-numbering.h"
 #include "slang-ir-insts.h"
 #include "slang-ir.h"
 
@@ -219,7 +220,10 @@ struct LivenessContext
     void process();
 
     LivenessContext(IRModule* module, LivenessMode mode)
-        : m_module(module), m_livenessMode(mode), m_builder(module)
+        : m_accessSet(module->getContainerPool())
+        , m_module(module)
+        , m_livenessMode(mode)
+        , m_builder(module)
     {
         // Disable warning if not used
         SLANG_UNUSED(&LivenessContext::_isAnyRunInst);
@@ -301,6 +305,14 @@ struct LivenessContext
     /// Complete the block using the run, which can *cannot* contain the current root start
     BlockResult _completeBlock(BlockIndex blockIndex, const ConstArrayView<IRInst*>& run);
 
+    /// Get the index of a block in the current function
+    BlockIndex _getBlockIndex(IRBlock* block) const
+    {
+        const Index index = m_numbering.getBlockIndex(block);
+        SLANG_ASSERT(index != IRInstNumbering::kInvalidIndex);
+        return BlockIndex(index);
+    }
+
     /// Get block info
     BlockInfo* _getBlockInfo(BlockIndex blockIndex) { return &m_blockInfos[Index(blockIndex)]; }
 
@@ -357,10 +369,11 @@ struct LivenessContext
 
     List<IRInst*> m_aliases; ///< A list of instructions that alias to the root
 
-    HashSet<IRInst*> m_accessSet; ///< If instruction is in set it is an `access` indicating it must
-                                  ///< be live at least up to this instruction
+    PooledUIntSet m_accessSet; ///< If an instruction's number is in the set it is an `access`,
+                               ///< indicating it must be live at least up to this instruction
 
-    Dictionary<IRBlock*, BlockIndex> m_blockIndexMap; ///< Map from a block to a block index
+    IRInstNumbering m_numbering; ///< Numbers the blocks and instructions of the current function.
+                                 ///< A block's number is its BlockIndex.
     List<BlockInfo> m_blockInfos; ///< Information about blocks, for the current root
     List<FixedBlockInfo>
         m_fixedBlockInfos;              ///< Information about blocks across the current function
@@ -798,7 +811,7 @@ void LivenessContext::_addInst(IRInst* inst)
     auto block = as<IRBlock>(inst->getParent());
 
     // Get the index to get the info
-    const BlockIndex blockIndex = m_blockIndexMap[block];
+    const BlockIndex blockIndex = _getBlockIndex(block);
 
     auto blockInfo = _getBlockInfo(blockIndex);
 
@@ -815,13 +828,15 @@ void LivenessContext::_addInst(IRInst* inst)
 void LivenessContext::_addAccessInst(IRInst* inst)
 {
     // If we already have it don't need to add again
-    if (m_accessSet.contains(inst))
+    if (m_numbering.containsInst(*m_accessSet, inst))
     {
         return;
     }
 
-    // Add to the access set
-    m_accessSet.add(inst);
+    // Add to the access set. Accesses are in the blocks of the function, so always have a number.
+    const bool added = m_numbering.addInst(*m_accessSet, inst);
+    SLANG_ASSERT(added);
+    SLANG_UNUSED(added);
 
     // Add the instruction to the block info
     _addInst(inst);
@@ -832,7 +847,7 @@ void LivenessContext::_findAliasesAndAccesses(IRInst* root)
     // Clear all the aliases
     m_aliases.clear();
     // Clear the access set
-    m_accessSet.clear();
+    m_accessSet->clear();
 
     // Add the root to the list of aliases, to start lookup
     m_aliases.add(root);
@@ -1006,7 +1021,7 @@ void LivenessContext::_findAndEmitRangeEnd(IRLiveRangeStart* liveRangeStart)
     // detect a loop. In most respect Visited behaves in the same manner as NotDominated.
 
     {
-        const BlockIndex rootStartBlockIndex = m_blockIndexMap[m_rootLiveStartBlock];
+        const BlockIndex rootStartBlockIndex = _getBlockIndex(m_rootLiveStartBlock);
         auto blockInfo = _getBlockInfo(rootStartBlockIndex);
         auto run = _getRun(blockInfo);
 
@@ -1054,7 +1069,7 @@ bool LivenessContext::_isNormalRunInst(IRInst* inst)
     {
         // Just because it's the right type *doesn't* mean it's an access, it has to also
         // be in the access set
-        return m_accessSet.contains(inst);
+        return m_numbering.containsInst(*m_accessSet, inst);
     }
 
     return false;
@@ -1341,15 +1356,13 @@ void LivenessContext::_processFunction(IRFunc* func)
     SLANG_ASSERT(m_rangeStarts.getCount() > 0);
 
     // Create the dominator tree, for the function
-    m_dominatorTree = computeDominatorTree(func);
+    m_dominatorTree = func->getModule()->findOrCreateDominatorTree(func);
 
     // We are going to precalculate a variety of things for blocks.
-    // Most processing is performed via BlockIndex, so we need to set up a map from the block
-    // pointer to the index By having as an index we can easily/quickly associate information with
-    // blocks with arrays
-
-    // Set up the map from blocks to indices
-    m_blockIndexMap.clear();
+    // Most processing is performed via BlockIndex, so we number the blocks (and the instructions
+    // in them, for the access set). By having as an index we can easily/quickly associate
+    // information with blocks with arrays
+    m_numbering.build(func);
 
     m_blockInfos.clear();
     m_fixedBlockInfos.clear();
@@ -1357,26 +1370,21 @@ void LivenessContext::_processFunction(IRFunc* func)
     m_rangeEnds.clear();
 
     {
-        // First we find all the blocks in the function, we add to the map
-        // and initialize the functionBlockInfos, which hold information about blocks that is
-        // constant across a function We will associate successors too, but we can only do this once
-        // we have set up the map
-        Index index = 0;
-        for (auto block : func->getChildren())
+        // First we initialize the functionBlockInfos, in the order the blocks are numbered. They
+        // hold information about blocks that is constant across a function. We will associate
+        // successors too, but we can only do this once all the blocks have an info
+        for (auto block : m_numbering.getBlocks())
         {
-            IRBlock* blockInst = as<IRBlock>(block);
-            m_blockIndexMap.add(blockInst, BlockIndex(index++));
-
             FixedBlockInfo fixedBlockInfo;
-            fixedBlockInfo.init(blockInst);
+            fixedBlockInfo.init(block);
 
             m_fixedBlockInfos.add(fixedBlockInfo);
         }
 
         // Allocate space for the root block infos
-        m_blockInfos.setCount(index);
+        m_blockInfos.setCount(m_numbering.getBlockCount());
 
-        // Now we have the map, work out the successors as BlockIndex for each block
+        // Now we have the infos, work out the successors as BlockIndex for each block
         // and add those to m_blockSuccessors. They are indexed via successorsIndex/Count in the
         // FunctionBlockInfos
         for (auto& fixedInfo : m_fixedBlockInfos)
@@ -1387,8 +1395,8 @@ void LivenessContext::_processFunction(IRFunc* func)
             if (auto loop = _getLoopTerminator(block))
             {
                 // Set the break/continue block indices
-                fixedInfo.breakBlockIndex = m_blockIndexMap[loop->getBreakBlock()];
-                fixedInfo.targetBlockIndex = m_blockIndexMap[loop->getTargetBlock()];
+                fixedInfo.breakBlockIndex = _getBlockIndex(loop->getBreakBlock());
+                fixedInfo.targetBlockIndex = _getBlockIndex(loop->getTargetBlock());
             }
 
             // Add all the successors
@@ -1406,7 +1414,7 @@ void LivenessContext::_processFunction(IRFunc* func)
 
             for (auto successor : successors)
             {
-                *dst++ = m_blockIndexMap[successor];
+                *dst++ = _getBlockIndex(successor);
             }
         }
 
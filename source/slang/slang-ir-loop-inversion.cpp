@@ -141,7 +141,8 @@ static void invertLoop(IRBuilder& builder, IRLoop* loop)
     builder.setInsertInto(loop->getParent());
 
     const auto s = as<IRBlock>(loop->getParent());
-    auto domTree = computeDominatorTree((IRGlobalValueWithCode*)s->getParent());
+    const auto func = (IRGlobalValueWithCode*)s->getParent();
+    RefPtr<IRDominatorTree> domTree = func->getModule()->findOrCreateDominatorTree(func);
     SLANG_ASSERT(s);
     const auto c1 = loop->getTargetBlock();
     const auto c1Terminator = as<IRIfElse>(c1->getTerminator());
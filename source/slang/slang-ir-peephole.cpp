@@ -34,7 +34,7 @@ struct PeepholeContext : InstPassBase
     {
         bool isAccessChainEqual = false;
         bool isAccessChainNotEqual = false;
-        List<IRInst*> chainKey;
+        InstWorkList chainKey(module);
         IRInst* chainNode = inst;
         for (;;)
         {
@@ -48,7 +48,7 @@ struct PeepholeContext : InstPassBase
             }
             break;
         }
-        chainKey.reverse();
+        chainKey.getList().reverse();
         if (auto updateInst = as<IRUpdateElement>(chainNode))
         {
             // If we see an extract(updateElement(x, accessChain, val), accessChain), then
@@ -86,7 +86,7 @@ struct PeepholeContext : InstPassBase
             }
             if (isAccessChainEqual)
             {
-                auto remainingKeys = chainKey.getArrayView(
+                auto remainingKeys = chainKey.getList().getArrayView(
                     updateInst->getAccessKeyCount(),
                     chainKey.getCount() - updateInst->getAccessKeyCount());
                 if (remainingKeys.getCount() == 0)
@@ -133,7 +133,7 @@ bool removeRedundancyInFunc(IRGlobalValueWithCode* func, bool hoistLoopInvariant
         return false;
 
     RedundancyRemovalContext context;
-    context.dom = computeDominatorTree(func);
+    context.dom = func->getModule()->findOrCreateDominatorTree(func);
     Dictionary<IRBlock*, DeduplicateContext> mapBlockToDeduplicateContext;
     for (auto block : func->getBlocks())
     {
@@ -1081,7 +1081,7 @@ struct SCCPContext
     // state. We track this as a set of the blocks that have been
     // marked as possibly executed, plus a getter and setter function.
 
-    HashSet<IRBlock*> executedBlocks;
+    HashSet<IRBlock*>& executedBlocks;
 
     bool isMarkedAsExecuted(IRBlock* block) { return executedBlocks.contains(block); }
 
@@ -1092,9 +1092,30 @@ struct SCCPContext
     // discovered might execute, and thus need to be processed,
     // and the other holds SSA nodes (instructions) that need
     // their "estimated" value to be updated.
+    //
+    // A context is created for every function in the module (and for every
+    // instruction that is constant folded on its own), so these containers
+    // are taken from the module's container pool rather than allocated anew.
+
+    List<IRBlock*>& cfgWorkList;
+    List<IRInst*>& ssaWorkList;
+
+    SCCPContext(SharedSCCPContext* inShared, IRGlobalValueWithCode* inCode)
+        : shared(inShared)
+        , code(inCode)
+        , executedBlocks(*inShared->module->getContainerPool().getHashSet<IRBlock>())
+        , cfgWorkList(*inShared->module->getContainerPool().getList<IRBlock>())
+        , ssaWorkList(*inShared->module->getContainerPool().getList<IRInst>())
+    {
+    }
 
-    List<IRBlock*> cfgWorkList;
-    List<IRInst*> ssaWorkList;
+    ~SCCPContext()
+    {
+        auto& pool = shared->module->getContainerPool();
+        pool.free(&executedBlocks);
+        pool.free(&cfgWorkList);
+        pool.free(&ssaWorkList);
+    }
 
     // A key operation is to take an IR instruction and update
     // its "estimated" value on the lattice. This might happen when
@@ -1385,7 +1406,7 @@ struct SCCPContext
 
         bool changed = false;
         // Replace the insts with their values.
-        List<IRInst*> instsToRemove;
+        PooledList<IRInst> instsToRemove(shared->module->getContainerPool());
         for (auto child : scopeInst->getChildren())
         {
             if (!isEvaluableOpCode(child->getOp()))
@@ -1395,14 +1416,14 @@ struct SCCPContext
             if (latticeVal.flavor == LatticeVal::Flavor::Constant && latticeVal.value != child)
             {
                 child->replaceUsesWith(latticeVal.value);
-                instsToRemove.add(child);
+                instsToRemove->add(child);
             }
         }
 
-        if (instsToRemove.getCount())
+        if (instsToRemove->getCount())
         {
             changed = true;
-            for (auto inst : instsToRemove)
+            for (auto inst : *instsToRemove)
                 inst->removeAndDeallocate();
         }
         return changed;
@@ -1541,7 +1562,7 @@ struct SCCPContext
         // First, we will walk through all the code and replace instructions
         // with constants where it is possible.
         //
-        List<IRInst*> instsToRemove;
+        PooledList<IRInst> instsToRemove(shared->module->getContainerPool());
         for (auto block : code->getBlocks())
         {
             for (auto inst : block->getDecorationsAndChildren())
@@ -1572,19 +1593,19 @@ struct SCCPContext
                 {
                     // Don't delete phi parameters, they will be cleaned up in CFG simplification.
                     if (inst->getOp() != kIROp_Param)
-                        instsToRemove.add(inst);
+                        instsToRemove->add(inst);
                 }
             }
         }
 
-        if (instsToRemove.getCount() != 0)
+        if (instsToRemove->getCount() != 0)
             changed = true;
 
         // Once we've replaced the uses of instructions that evaluate
         // to constants, we make a second pass to remove the instructions
         // themselves (or at least those without side effects).
         //
-        for (auto inst : instsToRemove)
+        for (auto inst : *instsToRemove)
         {
             inst->removeAndDeallocate();
         }
@@ -1773,9 +1794,7 @@ static bool applySparseConditionalConstantPropagationRec(
     {
         if (code->getFirstBlock())
         {
-            SCCPContext context;
-            context.shared = globalContext.shared;
-            context.code = code;
+            SCCPContext context(globalContext.shared, code);
             context.mapInstToLatticeVal = globalContext.mapInstToLatticeVal;
             changed |= context.apply();
         }
@@ -1808,9 +1827,7 @@ bool applySparseConditionalConstantPropagation(IRModule* module, DiagnosticSink*
     shared.sink = sink;
 
     // First we fold constants at global scope.
-    SCCPContext globalContext;
-    globalContext.shared = &shared;
-    globalContext.code = nullptr;
+    SCCPContext globalContext(&shared, nullptr);
     bool changed = globalContext.applyOnGlobalScope(module);
 
     // Now run recursive SCCP passes on each child code block.
@@ -1827,9 +1844,7 @@ bool applySparseConditionalConstantPropagationForGlobalScope(IRModule* module, D
     SharedSCCPContext shared;
     shared.module = module;
     shared.sink = sink;
-    SCCPContext globalContext;
-    globalContext.shared = &shared;
-    globalContext.code = nullptr;
+    SCCPContext globalContext(&shared, nullptr);
     bool changed = globalContext.applyOnGlobalScope(module);
     return changed;
 }
@@ -1843,9 +1858,7 @@ bool applySparseConditionalConstantPropagation(IRInst* func, DiagnosticSink* sin
     shared.module = func->getModule();
     shared.sink = sink;
 
-    SCCPContext globalContext;
-    globalContext.shared = &shared;
-    globalContext.code = nullptr;
+    SCCPContext globalContext(&shared, nullptr);
 
     // Run recursive SCCP passes on each child code block.
     return applySparseConditionalConstantPropagationRec(globalContext, func);
@@ -1855,9 +1868,7 @@ IRInst* tryConstantFoldInst(IRModule* module, IRInst* inst)
 {
     SharedSCCPContext shared;
     shared.module = module;
-    SCCPContext instContext;
-    instContext.shared = &shared;
-    instContext.code = nullptr;
+    SCCPContext instContext(&shared, nullptr);
     instContext.builderStorage = IRBuilder(module);
     auto foldResult = instContext.interpretOverLattice(inst);
     if (!foldResult.value)
@@ -1,7 +1,10 @@
 // slang-ir-ssa.cpp
 #include "slang-ir-ssa.h"
 
+#include "../core/slang-performance-profiler.h"
 #include "slang-ir-clone.h"
+#include "slang-ir-dominators.h"
+#include "slang-ir-inst-numbering.h"
 #include "slang-ir-insts.h"
 #include "slang-ir-util.h"
 #include "slang-ir-validate.h"
@@ -10,16 +13,23 @@
 namespace Slang
 {
 
+struct SSAVarInfo;
+
 // Track information on a phi node we are in
 // the process of constructing.
-struct PhiInfo : RefObject
+//
+// Like the other records used while constructing SSA
+// form for a function, these are allocated from the
+// scratch arena of the module's container pool, and
+// are all released together once construction is done.
+struct PhiInfo
 {
     // The phi node will be represented as a parameter
     // to a (non-entry) basic block.
     IRParam* phi;
 
     // The original variable that this phi will be replacing.
-    IRVar* var;
+    SSAVarInfo* varInfo;
 
     // The operands to the phi will be stored as uses here,
     // because our IR parameters don't have operands.
@@ -28,26 +38,31 @@ struct PhiInfo : RefObject
     // we will turn this into argument in predecessor blocks
     // that branch to this one.
     //
-    // The order of elements in this list must match the
+    // The order of elements in this array must match the
     // order in which the predecessor blocks get enumerated.
-    List<IRUse> operands;
+    IRUse* operands = nullptr;
+    Count operandCount = 0;
 
     // If this phi ended up being removed as trivial, then
     // this will be the value that we replaced it with.
     IRInst* replacement = nullptr;
+
+    // The next phi created for the same block, in the
+    // order they were created.
+    PhiInfo* nextInBlock = nullptr;
 };
 
 // Information about a basic block that we generate/use
 // during SSA construction.
-struct SSABlockInfo : RefObject
+struct SSABlockInfo
 {
-    // Map a promotable variable to the value to
-    // use for that variable
-    Dictionary<IRVar*, IRInst*> valueForVar;
-
     // The underlying basic block.
     IRBlock* block;
 
+    // The number of the block, used to find the values of
+    // variables in the block in the context's value table.
+    Index index;
+
     // Have we processed all the instructions in the
     // body of this block (so that we would have
     // found any stores to SSA variables)?
@@ -62,12 +77,61 @@ struct SSABlockInfo : RefObject
     // stuff in the context of this block
     IRBuilder builder;
 
-    // Phi nodes we are creating for this block.
-    List<PhiInfo*> phis;
+    // Phi nodes we are creating for this block, in the
+    // order they were created.
+    PhiInfo* firstPhi = nullptr;
+    PhiInfo* lastPhi = nullptr;
 
     // Arguments that this block needs to pass along
     // to the phi nodes defined by is sucessor
-    List<IRInst*> successorArgs;
+    IRInst** successorArgs = nullptr;
+    Count successorArgCount = 0;
+};
+
+// How the value of a promotable variable is found where
+// it is loaded.
+enum class SSAVarKind
+{
+    // All the loads and stores of the variable are in the
+    // block that declares it, so its value can be tracked
+    // while that block is processed, and no phis are needed.
+    SingleBlock,
+
+    // The variable is stored to once, and the store dominates
+    // all the loads, so each load is replaced with the
+    // stored value.
+    SingleStore,
+
+    // Any other variable, whose value is found with the
+    // general algorithm, which may introduce phis.
+    General,
+};
+
+// Information about a variable being promoted to SSA form.
+struct SSAVarInfo
+{
+    IRVar* var;
+
+    SSAVarKind kind = SSAVarKind::General;
+
+    // For a `SingleBlock` variable, its value at the point
+    // its block has been processed up to.
+    IRInst* currentValue = nullptr;
+
+    // For a `SingleStore` variable, the store. The stored
+    // value is read from it when needed (rather than kept here),
+    // so that it is up to date if the value is replaced.
+    IRStore* store = nullptr;
+
+    // For a `General` variable, its index among the general
+    // variables, used to find its values in the value table.
+    Index generalIndex = -1;
+
+    // For a `General` variable when the context has no value
+    // table, its values in each block. The values are held in
+    // chunks of consecutive blocks, indexed by block number,
+    // which are only allocated once a value in them is set.
+    IRInst*** valueChunks = nullptr;
 };
 
 // State for constructing SSA form for a global value
@@ -78,30 +142,148 @@ struct ConstructSSAContext
     // (usually an IR function)
     IRGlobalValueWithCode* globalVal;
 
+    IRModule* module;
+
+    // The records below are allocated from here, and freed
+    // when the context is destroyed.
+    ScratchArenaScope arenaScope;
+    MemoryArena& getArena() { return arenaScope.getArena(); }
+
+    // Numbers the blocks of `globalVal`, once critical edges have been broken
+    IRInstNumbering numbering;
+
     // Variables that we've identified for promotion
     // to SSA values.
-    List<IRVar*> promotableVars;
+    //
+    // The `scratchData` of a promoted variable holds its
+    // index in this list plus one, so that its information
+    // can be found without a lookup in a map.
+    List<SSAVarInfo*>& promotableVars;
 
-    // Information about each basic block
-    Dictionary<IRBlock*, RefPtr<SSABlockInfo>> blockInfos;
+    // The number of promotable variables that are `SSAVarKind::General`
+    Count generalVarCount = 0;
 
-    IRModule* module;
+    // Information about each basic block, indexed by its number
+    SSABlockInfo* blockInfos = nullptr;
+
+    // The value to use for each general variable in each
+    // block, if one has been found yet.
+    //
+    // If there are few enough blocks and variables the values
+    // are held in a dense table, indexed by the block and
+    // variable. Otherwise each variable holds its own values,
+    // in chunks that are allocated as they are needed (see
+    // `SSAVarInfo::valueChunks`).
+    IRInst** valueTable = nullptr;
+
+    enum
+    {
+        // The most entries to hold in `valueTable`
+        kMaxValueTableSize = 64 * 1024,
+
+        // The number of blocks each chunk of `SSAVarInfo::valueChunks` holds values for
+        kValueChunkShift = 6,
+        kValueChunkSize = 1 << kValueChunkShift,
+    };
 
     // Instructions to remove during cleanup
-    List<IRInst*> instsToRemove;
+    List<IRInst*>& instsToRemove;
 
     IRBuilder builder;
     IRBuilder* getBuilder() { return &builder; }
 
+    // Every phi created, in the order they were created.
+    //
+    // The `scratchData` of a phi holds its index in this
+    // list plus one, in the same way as for variables.
+    List<PhiInfo*>& phiInfos;
+
+    // The dominator tree, if it has been needed
+    IRDominatorTree* dominatorTree = nullptr;
+
+    ConstructSSAContext(IRModule* inModule, IRGlobalValueWithCode* inGlobalVal)
+        : globalVal(inGlobalVal)
+        , module(inModule)
+        , arenaScope(inModule->getContainerPool())
+        , promotableVars(*inModule->getContainerPool().getList<SSAVarInfo>())
+        , instsToRemove(*inModule->getContainerPool().getList<IRInst>())
+        , builder(inModule)
+        , phiInfos(*inModule->getContainerPool().getList<PhiInfo>())
+    {
+        builder.setInsertInto(inModule);
+    }
+
+    ~ConstructSSAContext()
+    {
+        auto& pool = module->getContainerPool();
+        pool.free(&promotableVars);
+        pool.free(&instsToRemove);
+        pool.free(&phiInfos);
+    }
+
+    IRDominatorTree* getDominatorTree()
+    {
+        if (!dominatorTree)
+            dominatorTree = module->findOrCreateDominatorTree(globalVal);
+        return dominatorTree;
+    }
+
+    SSABlockInfo* getBlockInfo(IRBlock* block)
+    {
+        const Index index = numbering.getBlockIndex(block);
+        SLANG_ASSERT(index != IRInstNumbering::kInvalidIndex);
+        return &blockInfos[index];
+    }
 
-    Dictionary<IRParam*, RefPtr<PhiInfo>> phiInfos;
+    // Get the information for `var` if it is being promoted, else nullptr
+    SSAVarInfo* getVarInfo(IRVar* var)
+    {
+        const Index index = Index(var->scratchData) - 1;
+        if (UInt(index) < UInt(promotableVars.getCount()) && promotableVars[index]->var == var)
+            return promotableVars[index];
+        return nullptr;
+    }
 
     PhiInfo* getPhiInfo(IRParam* phi)
     {
-        if (auto found = phiInfos.tryGetValue(phi))
-            return *found;
+        const Index index = Index(phi->scratchData) - 1;
+        if (UInt(index) < UInt(phiInfos.getCount()) && phiInfos[index]->phi == phi)
+            return phiInfos[index];
         return nullptr;
     }
+
+    // Get the slot in the value table for a general variable in a block
+    IRInst** getValueTableSlot(SSABlockInfo* blockInfo, SSAVarInfo* varInfo)
+    {
+        SLANG_ASSERT(valueTable && varInfo->kind == SSAVarKind::General);
+        return &valueTable[blockInfo->index * generalVarCount + varInfo->generalIndex];
+    }
+
+    // Get the slot in the value chunks of a general variable for a block. If the chunk
+    // doesn't exist it is created if `create` is set, otherwise nullptr is returned.
+    IRInst** getValueChunkSlot(SSABlockInfo* blockInfo, SSAVarInfo* varInfo, bool create)
+    {
+        SLANG_ASSERT(!valueTable && varInfo->kind == SSAVarKind::General);
+
+        const Index chunkIndex = blockInfo->index >> kValueChunkShift;
+        if (!varInfo->valueChunks)
+        {
+            if (!create)
+                return nullptr;
+            const Count chunkCount =
+                (numbering.getBlockCount() + kValueChunkSize - 1) >> kValueChunkShift;
+            varInfo->valueChunks = getArena().allocateAndZeroArray<IRInst**>(chunkCount);
+        }
+
+        IRInst**& chunk = varInfo->valueChunks[chunkIndex];
+        if (!chunk)
+        {
+            if (!create)
+                return nullptr;
+            chunk = getArena().allocateAndZeroArray<IRInst*>(kValueChunkSize);
+        }
+        return &chunk[blockInfo->index & (kValueChunkSize - 1)];
+    }
 };
 
 /// Do all uses of this instruction lead to a `load`?
@@ -144,7 +326,7 @@ bool allUsesLeadToLoads(IRInst* inst)
 }
 
 // Is the given variable one that we can promote to SSA form?
-bool isPromotableVar(ConstructSSAContext* /*context*/, IRVar* var, HashSet<IRBlock*>& knownBlocks)
+bool isPromotableVar(ConstructSSAContext* context, IRVar* var)
 {
     // We want to identify variables such that we can always
     // determine what they will contain at a point in the
@@ -225,8 +407,8 @@ bool isPromotableVar(ConstructSSAContext* /*context*/, IRVar* var, HashSet<IRBlo
             break;
         }
 
-        // If the use is outside of known blocks, then we can't promote it.
-        if (!knownBlocks.contains(getBlock(user)))
+        // If the use is outside of the blocks of the function, then we can't promote it.
+        if (context->numbering.getBlockIndex(getBlock(user)) == IRInstNumbering::kInvalidIndex)
             return false;
     }
 
@@ -236,15 +418,121 @@ bool isPromotableVar(ConstructSSAContext* /*context*/, IRVar* var, HashSet<IRBlo
     return true;
 }
 
-// Identify local variables that can be promoted to SSA form
-void identifyPromotableVars(ConstructSSAContext* context)
+// The loads and stores of a promotable variable, found by `findVarAccesses`
+struct SSAVarAccesses
 {
-    HashSet<IRBlock*> knownBlocks;
-    for (auto bb = context->globalVal->getFirstBlock(); bb; bb = bb->getNextBlock())
+    SSAVarAccesses(List<IRInst*>& inLoads)
+        : loads(inLoads)
+    {
+    }
+
+    // Loads of the variable, directly or through an access chain
+    List<IRInst*>& loads;
+
+    // The number of stores to the variable, and the last one found
+    Count storeCount = 0;
+    IRStore* store = nullptr;
+
+    // Are all the loads, stores and access chains in the block that declares the variable?
+    bool allInVarBlock = true;
+};
+
+// Find the loads and stores of a promotable variable, or of an access
+// chain based on one. As the variable is promotable, all the stores
+// are to the variable itself.
+static void findVarAccesses(IRInst* ptr, IRBlock* varBlock, SSAVarAccesses& ioAccesses)
+{
+    for (auto u = ptr->firstUse; u; u = u->nextUse)
+    {
+        auto user = u->getUser();
+        if (user->getParent() != varBlock)
+            ioAccesses.allInVarBlock = false;
+
+        switch (user->getOp())
+        {
+        default:
+            break;
+
+        case kIROp_Load:
+            ioAccesses.loads.add(user);
+            break;
+
+        case kIROp_Store:
+            ioAccesses.storeCount++;
+            ioAccesses.store = (IRStore*)user;
+            break;
+
+        case kIROp_GetElementPtr:
+        case kIROp_FieldAddress:
+            findVarAccesses(user, varBlock, ioAccesses);
+            break;
+        }
+    }
+}
+
+// Decide how the value of a promotable variable will be found at its loads
+static void classifyPromotableVar(ConstructSSAContext* context, SSAVarInfo* varInfo)
+{
+    auto var = varInfo->var;
+
+    PooledList<IRInst> loads(context->module->getContainerPool());
+    SSAVarAccesses accesses(*loads);
+    findVarAccesses(var, as<IRBlock>(var->getParent()), accesses);
+
+    if (accesses.allInVarBlock)
+    {
+        varInfo->kind = SSAVarKind::SingleBlock;
+        return;
+    }
+
+    varInfo->kind = SSAVarKind::General;
+    if (accesses.storeCount != 1)
+        return;
+
+    // For the stored value to be usable at every load, the store has to
+    // dominate all of them. Within the store's block, that means coming
+    // after the store, which we can tell from the instruction numbers.
+    //
+    // A load or store without a number was moved into its block from
+    // somewhere else (such as an `asm` block), so we leave it to the
+    // general algorithm.
+    //
+    auto store = accesses.store;
+    auto storeBlock = as<IRBlock>(store->getParent());
+    const Index storeIndex = context->numbering.getInstIndex(store);
+    if (storeIndex == IRInstNumbering::kInvalidIndex)
+        return;
+
+    for (auto load : *loads)
     {
-        knownBlocks.add(bb);
+        const Index loadIndex = context->numbering.getInstIndex(load);
+        if (loadIndex == IRInstNumbering::kInvalidIndex)
+            return;
+
+        auto loadBlock = as<IRBlock>(load->getParent());
+        if (loadBlock == storeBlock)
+        {
+            if (loadIndex < storeIndex)
+                return;
+        }
+        else
+        {
+            auto dominatorTree = context->getDominatorTree();
+            if (dominatorTree->isUnreachable(loadBlock) ||
+                !dominatorTree->properlyDominates(storeBlock, loadBlock))
+                return;
+        }
     }
 
+    varInfo->kind = SSAVarKind::SingleStore;
+    varInfo->store = store;
+}
+
+// Identify local variables that can be promoted to SSA form
+void identifyPromotableVars(ConstructSSAContext* context)
+{
+    context->numbering.build(context->globalVal);
+
     for (auto bb = context->globalVal->getFirstBlock(); bb; bb = bb->getNextBlock())
     {
         for (auto ii = bb->getFirstInst(); ii; ii = ii->getNextInst())
@@ -254,30 +542,36 @@ void identifyPromotableVars(ConstructSSAContext* context)
 
             IRVar* var = (IRVar*)ii;
 
-            if (isPromotableVar(context, var, knownBlocks))
+            if (isPromotableVar(context, var))
             {
-                context->promotableVars.add(var);
+                auto varInfo = new (context->getArena()) SSAVarInfo();
+                varInfo->var = var;
+                classifyPromotableVar(context, varInfo);
+                if (varInfo->kind == SSAVarKind::General)
+                    varInfo->generalIndex = context->generalVarCount++;
+
+                context->promotableVars.add(varInfo);
+
+                // Nothing needs the number of the variable itself, so its
+                // `scratchData` can be used to find its information instead.
+                var->scratchData = UInt64(context->promotableVars.getCount());
             }
         }
     }
 }
 
-/// If `value` is a promotable variable, then cast and return it.
-IRVar* asPromotableVar(ConstructSSAContext* context, IRInst* value)
+/// If `value` is a promotable variable, then return its information.
+SSAVarInfo* asPromotableVar(ConstructSSAContext* context, IRInst* value)
 {
     if (value->getOp() != kIROp_Var)
         return nullptr;
 
-    IRVar* var = (IRVar*)value;
-    if (!context->promotableVars.contains(var))
-        return nullptr;
-
-    return var;
+    return context->getVarInfo((IRVar*)value);
 }
 
 /// If `value` is a promotable variable or an access chain
-/// based on one, then cast and return the variable.
-IRVar* asPromotableVarAccessChain(ConstructSSAContext* context, IRInst* value)
+/// based on one, then return the variable's information.
+SSAVarInfo* asPromotableVarAccessChain(ConstructSSAContext* context, IRInst* value)
 {
     switch (value->getOp())
     {
@@ -352,7 +646,7 @@ IRInst* applyAccessChain(
 // that value will be used. If not, this all
 // may recursively work its way up through
 // the predecessors of the block.
-IRInst* readVar(ConstructSSAContext* context, SSABlockInfo* blockInfo, IRVar* var);
+IRInst* readVar(ConstructSSAContext* context, SSABlockInfo* blockInfo, SSAVarInfo* varInfo);
 
 /// Try to copy any relevant decorations from `var` over to `val`.
 ///
@@ -395,8 +689,9 @@ static void cloneRelevantDecorations(IRVar* var, IRInst* val)
 }
 
 // Add a phi node to represent the given variable
-PhiInfo* addPhi(ConstructSSAContext* context, SSABlockInfo* blockInfo, IRVar* var)
+PhiInfo* addPhi(ConstructSSAContext* context, SSABlockInfo* blockInfo, SSAVarInfo* varInfo)
 {
+    auto var = varInfo->var;
     auto builder = &blockInfo->builder;
 
     auto valueType = var->getDataType()->getValueType();
@@ -407,14 +702,19 @@ PhiInfo* addPhi(ConstructSSAContext* context, SSABlockInfo* blockInfo, IRVar* va
     IRParam* phi = builder->emitParam(valueType);
     cloneRelevantDecorations(var, phi);
 
-    RefPtr<PhiInfo> phiInfo = new PhiInfo();
-    context->phiInfos.add(phi, phiInfo);
+    auto phiInfo = new (context->getArena()) PhiInfo();
+    context->phiInfos.add(phiInfo);
+    phi->scratchData = UInt64(context->phiInfos.getCount());
 
     phi->sourceLoc = var->sourceLoc;
     phiInfo->phi = phi;
-    phiInfo->var = var;
+    phiInfo->varInfo = varInfo;
 
-    blockInfo->phis.add(phiInfo);
+    if (blockInfo->lastPhi)
+        blockInfo->lastPhi->nextInBlock = phiInfo;
+    else
+        blockInfo->firstPhi = phiInfo;
+    blockInfo->lastPhi = phiInfo;
 
     return phiInfo;
 }
@@ -428,9 +728,9 @@ IRInst* tryRemoveTrivialPhi(ConstructSSAContext* context, PhiInfo* phiInfo)
     // to the phi itself.
 
     IRInst* same = nullptr;
-    for (auto u : phiInfo->operands)
+    for (Index i = 0; i < phiInfo->operandCount; ++i)
     {
-        auto usedVal = u.get();
+        auto usedVal = phiInfo->operands[i].get();
         SLANG_ASSERT(usedVal);
 
         if (usedVal == same || usedVal == phi)
@@ -474,7 +774,7 @@ IRInst* tryRemoveTrivialPhi(ConstructSSAContext* context, PhiInfo* phiInfo)
     // Removing this phi as trivial may make other phi nodes
     // become trivial. We will recognize such candidates
     // by looking for phi nodes that use this node.
-    List<PhiInfo*> otherPhis;
+    PooledList<PhiInfo> otherPhis(context->module->getContainerPool());
     for (auto u = phi->firstUse; u; u = u->nextUse)
     {
         auto user = u->user;
@@ -488,7 +788,7 @@ IRInst* tryRemoveTrivialPhi(ConstructSSAContext* context, PhiInfo* phiInfo)
             auto maybeOtherPhi = (IRParam*)user;
             if (auto otherPhiInfo = context->getPhiInfo(maybeOtherPhi))
             {
-                otherPhis.add(otherPhiInfo);
+                otherPhis->add(otherPhiInfo);
             }
         }
     }
@@ -500,9 +800,9 @@ IRInst* tryRemoveTrivialPhi(ConstructSSAContext* context, PhiInfo* phiInfo)
 
     // Clear out the operands to the phi, since they won't
     // actually get used in the program any more.
-    for (auto& u : phiInfo->operands)
+    for (Index i = 0; i < phiInfo->operandCount; ++i)
     {
-        u.clear();
+        phiInfo->operands[i].clear();
     }
 
     // We will record the value that was used to replace this
@@ -511,7 +811,7 @@ IRInst* tryRemoveTrivialPhi(ConstructSSAContext* context, PhiInfo* phiInfo)
 
     // Now that we've cleaned up this phi, we need to consider
     // other phis that might have become  trivial.
-    for (auto otherPhi : otherPhis)
+    for (auto otherPhi : *otherPhis)
     {
         // It is possible that between when we added a phi
         // node to `otherPhis` and here it might have been
@@ -531,11 +831,11 @@ IRInst* tryRemoveTrivialPhi(ConstructSSAContext* context, PhiInfo* phiInfo)
 
 IRInst* addPhiOperands(ConstructSSAContext* context, SSABlockInfo* blockInfo, PhiInfo* phiInfo)
 {
-    auto var = phiInfo->var;
+    auto varInfo = phiInfo->varInfo;
 
     auto block = blockInfo->block;
 
-    List<IRInst*> operandValues;
+    PooledList<IRInst> operandValues(context->module->getContainerPool());
     auto predecessorCount = block->getPredecessors().getCount();
     for (auto predBlock : block->getPredecessors())
     {
@@ -544,32 +844,63 @@ IRInst* addPhiOperands(ConstructSSAContext* context, SSABlockInfo* blockInfo, Ph
         //
         SLANG_RELEASE_ASSERT(predecessorCount <= 1 || predBlock->getSuccessors().getCount() == 1);
 
-        auto predInfo = *context->blockInfos.tryGetValue(predBlock);
+        auto predInfo = context->getBlockInfo(predBlock);
 
-        auto phiOperand = readVar(context, predInfo, var);
+        auto phiOperand = readVar(context, predInfo, varInfo);
         SLANG_ASSERT(phiOperand != nullptr);
 
-        operandValues.add(phiOperand);
+        operandValues->add(phiOperand);
     }
 
     // The `IRUse`  type needs to stay at a stable location
     // since they get threaded into lists. We allocate the
-    // list with its final size so that we can preserve the
+    // array with its final size so that we can preserve the
     // required invariant.
 
-    UInt operandCount = operandValues.getCount();
-    phiInfo->operands.setCount(operandCount);
-    for (UInt ii = 0; ii < operandCount; ++ii)
+    const Count operandCount = operandValues->getCount();
+    phiInfo->operands = context->getArena().allocateAndZeroArray<IRUse>(operandCount);
+    phiInfo->operandCount = operandCount;
+    for (Index ii = 0; ii < operandCount; ++ii)
     {
-        phiInfo->operands[ii].init(phiInfo->phi, operandValues[ii]);
+        phiInfo->operands[ii].init(phiInfo->phi, (*operandValues)[ii]);
     }
 
     return tryRemoveTrivialPhi(context, phiInfo);
 }
 
-void writeVar(ConstructSSAContext* /*context*/, SSABlockInfo* blockInfo, IRVar* var, IRInst* val)
+void writeVar(
+    ConstructSSAContext* context,
+    SSABlockInfo* blockInfo,
+    SSAVarInfo* varInfo,
+    IRInst* val)
+{
+    switch (varInfo->kind)
+    {
+    case SSAVarKind::SingleBlock:
+        varInfo->currentValue = val;
+        break;
+
+    case SSAVarKind::SingleStore:
+        // The value is always read from the store.
+        break;
+
+    case SSAVarKind::General:
+        if (context->valueTable)
+            *context->getValueTableSlot(blockInfo, varInfo) = val;
+        else
+            *context->getValueChunkSlot(blockInfo, varInfo, true) = val;
+        break;
+    }
+}
+
+// Find the value of a general variable that has been recorded for a block, or nullptr
+IRInst* findValueForVar(ConstructSSAContext* context, SSABlockInfo* blockInfo, SSAVarInfo* varInfo)
 {
-    blockInfo->valueForVar[var] = val;
+    if (context->valueTable)
+        return *context->getValueTableSlot(blockInfo, varInfo);
+
+    auto slot = context->getValueChunkSlot(blockInfo, varInfo, false);
+    return slot ? *slot : nullptr;
 }
 
 void maybeSealBlock(ConstructSSAContext* context, SSABlockInfo* blockInfo)
@@ -582,7 +913,7 @@ void maybeSealBlock(ConstructSSAContext* context, SSABlockInfo* blockInfo)
     // have been filled.
     for (auto pp : blockInfo->block->getPredecessors())
     {
-        auto predInfo = *context->blockInfos.tryGetValue(pp);
+        auto predInfo = context->getBlockInfo(pp);
         if (!predInfo->isFilled)
             return;
     }
@@ -592,12 +923,11 @@ void maybeSealBlock(ConstructSSAContext* context, SSABlockInfo* blockInfo)
     // We will loop over any incomplete phis that have been recoreded
     // for this block, and complete them here.
     //
-    // Note that we are doing the "inefficient" loop where we compute
-    // the count on each iteration to account for the possibility that
-    // new incomplete phis will get added while we are working.
-    for (Index ii = 0; ii < blockInfo->phis.getCount(); ++ii)
+    // Note that new incomplete phis may get added to the end of the
+    // list while we are working, and the loop will reach them too.
+    for (auto incompletePhi = blockInfo->firstPhi; incompletePhi;
+         incompletePhi = incompletePhi->nextInBlock)
     {
-        auto incompletePhi = blockInfo->phis[ii];
         addPhiOperands(context, blockInfo, incompletePhi);
     }
 
@@ -624,8 +954,8 @@ IRInst* maybeGetPhiReplacement(ConstructSSAContext* context, IRInst* inVal)
     {
         // The value is a parameter, but is it a phi?
         IRParam* maybePhi = (IRParam*)val;
-        RefPtr<PhiInfo> phiInfo = nullptr;
-        if (!context->phiInfos.tryGetValue(maybePhi, phiInfo))
+        PhiInfo* phiInfo = context->getPhiInfo(maybePhi);
+        if (!phiInfo)
             break;
 
         // Okay, this is indeed a phi we are adding, but
@@ -641,8 +971,9 @@ IRInst* maybeGetPhiReplacement(ConstructSSAContext* context, IRInst* inVal)
     return val;
 }
 
-IRInst* readVarRec(ConstructSSAContext* context, SSABlockInfo* blockInfo, IRVar* var)
+IRInst* readVarRec(ConstructSSAContext* context, SSABlockInfo* blockInfo, SSAVarInfo* varInfo)
 {
+    auto var = varInfo->var;
     IRInst* val = nullptr;
     if (!blockInfo->isSealed)
     {
@@ -651,7 +982,7 @@ IRInst* readVarRec(ConstructSSAContext* context, SSABlockInfo* blockInfo, IRVar*
         // This phi may get removed later, once
         // we are able to seal this block.
 
-        PhiInfo* phiInfo = addPhi(context, blockInfo, var);
+        PhiInfo* phiInfo = addPhi(context, blockInfo, varInfo);
         val = phiInfo->phi;
     }
     else
@@ -702,8 +1033,8 @@ IRInst* readVarRec(ConstructSSAContext* context, SSABlockInfo* blockInfo, IRVar*
             // so there is no need to insert a phi. Instead, we
             // just perform the lookup step recursively in
             // the predecessor.
-            auto predInfo = *context->blockInfos.tryGetValue(firstPred);
-            val = readVar(context, predInfo, var);
+            auto predInfo = context->getBlockInfo(firstPred);
+            val = readVar(context, predInfo, varInfo);
         }
         else
         {
@@ -714,11 +1045,11 @@ IRInst* readVarRec(ConstructSSAContext* context, SSABlockInfo* blockInfo, IRVar*
             // that drive the phi.
 
             // Create the phi node for the given variable
-            PhiInfo* phiInfo = addPhi(context, blockInfo, var);
+            PhiInfo* phiInfo = addPhi(context, blockInfo, varInfo);
 
             // Mark the phi as the value for the variable inside
             // this block
-            writeVar(context, blockInfo, var, phiInfo->phi);
+            writeVar(context, blockInfo, varInfo, phiInfo->phi);
 
             // Now add operands to the phi and maybe simplify
             // it, based on what gets found.
@@ -729,7 +1060,7 @@ IRInst* readVarRec(ConstructSSAContext* context, SSABlockInfo* blockInfo, IRVar*
 
     // Whatever value we find, we need to mark it as the
     // value for the given variable in this block
-    writeVar(context, blockInfo, var, val);
+    writeVar(context, blockInfo, varInfo, val);
 
     // If `val` represents a phi node (block parameter) then
     // it is possible that some of the operations above might
@@ -737,7 +1068,7 @@ IRInst* readVarRec(ConstructSSAContext* context, SSABlockInfo* blockInfo, IRVar*
     // and in that case we had better not return it to
     // be referenced in user code.
     //
-    // Note: it is okay for the `valueForVar` map that
+    // Note: it is okay for the values that
     // we update in `writeVar` to use the old value, so long
     // as we do this replacement logic anywhere we might read
     // from that map.
@@ -748,13 +1079,26 @@ IRInst* readVarRec(ConstructSSAContext* context, SSABlockInfo* blockInfo, IRVar*
 }
 
 
-IRInst* readVar(ConstructSSAContext* context, SSABlockInfo* blockInfo, IRVar* var)
+IRInst* readVar(ConstructSSAContext* context, SSABlockInfo* blockInfo, SSAVarInfo* varInfo)
 {
+    auto var = varInfo->var;
+
+    // A variable that is only stored to once, by a store
+    // that dominates all its loads, always has the
+    // stored value.
+    if (varInfo->kind == SSAVarKind::SingleStore)
+        return varInfo->store->getVal();
+
     // In the easy case, there will be a preceeding
     // store in the same block, so we can use
     // that local value.
-    IRInst* val = nullptr;
-    if (blockInfo->valueForVar.tryGetValue(var, val))
+    //
+    // A variable that is only accessed in its own block
+    // is always in this case, or the next one.
+    IRInst* val = varInfo->kind == SSAVarKind::SingleBlock
+                      ? varInfo->currentValue
+                      : findValueForVar(context, blockInfo, varInfo);
+    if (val)
     {
         // Hooray, we found a value to use, and we
         // can proceed without too many complications.
@@ -778,13 +1122,14 @@ IRInst* readVar(ConstructSSAContext* context, SSABlockInfo* blockInfo, IRVar* va
         auto type = var->getDataType()->getValueType();
         val = blockInfo->builder.emitUndefined(type);
         cloneRelevantDecorations(var, val);
-        writeVar(context, blockInfo, var, val);
+        writeVar(context, blockInfo, varInfo, val);
         return val;
     }
 
     // Otherwise we need to try to non-trivial/recursive
     // case of lookup.
-    return readVarRec(context, blockInfo, var);
+    SLANG_ASSERT(varInfo->kind == SSAVarKind::General);
+    return readVarRec(context, blockInfo, varInfo);
 }
 
 void collectInstsToRemove(ConstructSSAContext* context, IRBlock* block)
@@ -824,11 +1169,11 @@ void processBlock(ConstructSSAContext* context, IRBlock* block, SSABlockInfo* bl
     // leave them as-is, or replace them with a value
     // that we look up with local/global value numbering
 
-    List<IRInst*> workList;
+    PooledList<IRInst> workList(context->module->getContainerPool());
     for (auto ii = block->getFirstInst(); ii; ii = ii->getNextInst())
-        workList.add(ii);
+        workList->add(ii);
 
-    for (auto& ii : workList)
+    for (auto& ii : *workList)
     {
         // Any new instructions we create to represent
         // the new value will get inserted before whatever
@@ -847,13 +1192,19 @@ void processBlock(ConstructSSAContext* context, IRBlock* block, SSABlockInfo* bl
                 auto ptrArg = storeInst->ptr.get();
                 auto valArg = storeInst->val.get();
 
-                if (auto var = asPromotableVar(context, ptrArg))
+                if (auto varInfo = asPromotableVar(context, ptrArg))
                 {
+                    // The only store to a `SingleStore` variable
+                    // is where its loads read the value from, so
+                    // it is left in place until we are done.
+                    if (varInfo->kind == SSAVarKind::SingleStore)
+                        break;
+
                     // We are storing to a promotable variable,
                     // so we want to register the value being
                     // stored as the value for the given SSA
                     // variable.
-                    writeVar(context, blockInfo, var, valArg);
+                    writeVar(context, blockInfo, varInfo, valArg);
 
                     // Also eliminate the store instruction,
                     // since it is no longer needed.
@@ -867,14 +1218,14 @@ void processBlock(ConstructSSAContext* context, IRBlock* block, SSABlockInfo* bl
                 IRLoad* loadInst = (IRLoad*)ii;
                 auto ptrArg = loadInst->ptr.get();
 
-                if (auto var = asPromotableVarAccessChain(context, ptrArg))
+                if (auto varInfo = asPromotableVarAccessChain(context, ptrArg))
                 {
                     // We are loading from a promotable variable.
                     // Look up the value in the context of this
                     // block.
-                    auto val = readVar(context, blockInfo, var);
+                    auto val = readVar(context, blockInfo, varInfo);
 
-                    cloneRelevantDecorations(var, val);
+                    cloneRelevantDecorations(varInfo->var, val);
 
                     val = applyAccessChain(context, &blockInfo->builder, ptrArg, val);
 
@@ -905,7 +1256,7 @@ void processBlock(ConstructSSAContext* context, IRBlock* block, SSABlockInfo* bl
     // of its successor(s)
     for (auto ss : block->getSuccessors())
     {
-        auto successorInfo = *context->blockInfos.tryGetValue(ss);
+        auto successorInfo = context->getBlockInfo(ss);
         maybeSealBlock(context, successorInfo);
     }
 }
@@ -1063,15 +1414,28 @@ bool constructSSA(ConstructSSAContext* context)
     // and stores of promotable variables with simple values.
 
     auto globalVal = context->globalVal;
-    for (auto bb : globalVal->getBlocks())
+    auto& arena = context->getArena();
+
+    const Count blockCount = context->numbering.getBlockCount();
+    context->blockInfos = arena.allocateArray<SSABlockInfo>(blockCount);
+    for (Index i = 0; i < blockCount; ++i)
     {
-        auto blockInfo = new SSABlockInfo();
+        auto bb = context->numbering.getBlock(i);
+
+        auto blockInfo = new (&context->blockInfos[i]) SSABlockInfo();
         blockInfo->block = bb;
+        blockInfo->index = i;
 
         blockInfo->builder = IRBuilder(context->module);
         blockInfo->builder.setInsertBefore(bb->getLastInst());
+    }
 
-        context->blockInfos.add(bb, blockInfo);
+    // The values of general variables are only needed if there are any.
+    if (context->generalVarCount &&
+        blockCount * context->generalVarCount <= ConstructSSAContext::kMaxValueTableSize)
+    {
+        context->valueTable =
+            arena.allocateAndZeroArray<IRInst*>(blockCount * context->generalVarCount);
     }
 
     for (auto bb : globalVal->getBlocks())
@@ -1079,26 +1443,51 @@ bool constructSSA(ConstructSSAContext* context)
 
     for (auto bb : globalVal->getBlocks())
     {
-        auto blockInfo = *context->blockInfos.tryGetValue(bb);
+        auto blockInfo = context->getBlockInfo(bb);
         processBlock(context, bb, blockInfo);
     }
 
     // We need to transfer the logical arguments to our phi nodes
     // from the phi nodes back to the predecessor blocks that will
     // pass them in.
+    //
+    // We first count the arguments each block will pass, so that
+    // they can be stored in arrays of the right size.
+    for (auto bb : globalVal->getBlocks())
+    {
+        auto blockInfo = context->getBlockInfo(bb);
+        for (auto phiInfo = blockInfo->firstPhi; phiInfo; phiInfo = phiInfo->nextInBlock)
+        {
+            if (phiInfo->replacement)
+                continue;
+
+            for (auto pp : bb->getPredecessors())
+                context->getBlockInfo(pp)->successorArgCount++;
+        }
+    }
+    for (Index i = 0; i < blockCount; ++i)
+    {
+        auto& blockInfo = context->blockInfos[i];
+        if (blockInfo.successorArgCount)
+        {
+            blockInfo.successorArgs = arena.allocateArray<IRInst*>(blockInfo.successorArgCount);
+            blockInfo.successorArgCount = 0;
+        }
+    }
+
     for (auto bb : globalVal->getBlocks())
     {
-        auto blockInfo = *context->blockInfos.tryGetValue(bb);
+        auto blockInfo = context->getBlockInfo(bb);
 
         // First remove phis from their parent blocks.
-        for (auto phiInfo : blockInfo->phis)
+        for (auto phiInfo = blockInfo->firstPhi; phiInfo; phiInfo = phiInfo->nextInBlock)
             if (!phiInfo->replacement)
                 phiInfo->phi->removeFromParent();
 
         // Then, add them back in a consistent order, and add predecessor
         // args in the same order.
         //
-        for (auto phiInfo : blockInfo->phis)
+        for (auto phiInfo = blockInfo->firstPhi; phiInfo; phiInfo = phiInfo->nextInBlock)
         {
             // If we replaced this phi with another value,
             // then we had better not include it in the result.
@@ -1113,13 +1502,13 @@ bool constructSSA(ConstructSSAContext* context)
             for (auto pp : bb->getPredecessors())
             {
                 UInt predIndex = predCounter++;
-                auto predInfo = *context->blockInfos.tryGetValue(pp);
+                auto predInfo = context->getBlockInfo(pp);
 
                 IRInst* operandVal = phiInfo->operands[predIndex].get();
 
                 phiInfo->operands[predIndex].clear();
 
-                predInfo->successorArgs.add(operandVal);
+                predInfo->successorArgs[predInfo->successorArgCount++] = operandVal;
             }
         }
     }
@@ -1128,7 +1517,7 @@ bool constructSSA(ConstructSSAContext* context)
     // which have been stored into the `SSABlockInfo::successorArgs` field.
     for (auto bb : globalVal->getBlocks())
     {
-        auto blockInfo = *context->blockInfos.tryGetValue(bb);
+        auto blockInfo = context->getBlockInfo(bb);
 
         // Sanity check: all blocks should be filled and sealed.
         SLANG_ASSERT(blockInfo->isSealed);
@@ -1136,7 +1525,7 @@ bool constructSSA(ConstructSSAContext* context)
 
         // Don't do any work for blocks that don't need to pass along
         // values to the sucessor block.
-        auto addedArgCount = blockInfo->successorArgs.getCount();
+        auto addedArgCount = blockInfo->successorArgCount;
         if (addedArgCount == 0)
             continue;
 
@@ -1151,21 +1540,21 @@ bool constructSSA(ConstructSSAContext* context)
         auto oldArgCount = oldTerminator->getOperandCount();
         auto newArgCount = oldArgCount + addedArgCount;
 
-        List<IRInst*> newArgs;
+        IRInst** newArgs = arena.allocateArray<IRInst*>(newArgCount);
         for (UInt aa = 0; aa < oldArgCount; ++aa)
         {
-            newArgs.add(oldTerminator->getOperand(aa));
+            newArgs[aa] = oldTerminator->getOperand(aa);
         }
         for (Index aa = 0; aa < addedArgCount; ++aa)
         {
-            newArgs.add(blockInfo->successorArgs[aa]);
+            newArgs[oldArgCount + aa] = blockInfo->successorArgs[aa];
         }
 
         IRTerminatorInst* newTerminator = (IRTerminatorInst*)blockInfo->builder.emitIntrinsicInst(
             oldTerminator->getFullType(),
             oldTerminator->getOp(),
             newArgCount,
-            newArgs.getBuffer());
+            newArgs);
 
         // Transfer decorations (a terminator should have no children) over to the new instruction.
         //
@@ -1183,6 +1572,14 @@ bool constructSSA(ConstructSSAContext* context)
         oldTerminator->removeAndDeallocate();
     }
 
+    // The stores to `SingleStore` variables were left in place
+    // for their loads to read from, and can now go.
+    for (auto varInfo : context->promotableVars)
+    {
+        if (varInfo->kind == SSAVarKind::SingleStore)
+            varInfo->store->removeAndDeallocate();
+    }
+
     // Remove all the instructions we marked for deletion along
     // the way.
     //
@@ -1199,9 +1596,9 @@ bool constructSSA(ConstructSSAContext* context)
 
     // Now we should be able to go through and remove
     // of of the variables
-    for (auto var : context->promotableVars)
+    for (auto varInfo : context->promotableVars)
     {
-        var->removeAndDeallocate();
+        varInfo->var->removeAndDeallocate();
     }
     return true;
 }
@@ -1211,11 +1608,9 @@ bool constructSSA(ConstructSSAContext* context)
 //
 bool constructSSA(IRModule* module, IRGlobalValueWithCode* globalVal)
 {
-    ConstructSSAContext context;
-    context.globalVal = globalVal;
-    context.module = module;
-    context.builder = IRBuilder(module);
-    context.builder.setInsertInto(module);
+    SLANG_PROFILE;
+
+    ConstructSSAContext context(module, globalVal);
     return constructSSA(&context);
 }
 
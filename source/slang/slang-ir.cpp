@@ -4750,10 +4750,18 @@ IRInst* IRBuilder::addIntermediateContextFieldDifferentialTypeDecoration(
     return addDecoration(target, kIROp_IntermediateContextFieldDifferentialTypeDecoration, witness);
 }
 
-RefPtr<IRModule> IRModule::create(Session* session)
+RefPtr<IRModule> IRModule::create(Session* session, MemoryAccounting* accounting)
 {
     RefPtr<IRModule> module = new IRModule(session);
 
+    if (accounting)
+    {
+        module->m_memoryArena.setAccounting(accounting, MemoryAccounting::Category::IRArena);
+        module->m_containerPool.m_scratchArena.setAccounting(
+            accounting,
+            MemoryAccounting::Category::IRArena);
+    }
+
     auto moduleInst = module->_allocateInst<IRModuleInst>(kIROp_Module, 0);
 
     module->m_moduleInst = moduleInst;
@@ -4774,20 +4782,81 @@ void IRModule::buildMangledNameToGlobalInstMap()
     }
 }
 
+// The signature of a control flow graph lists each block in order, followed by its
+// successors and a null separator. Two graphs with the same signature have the same
+// dominator tree.
+static void _calcCFGSignature(IRGlobalValueWithCode* func, List<IRInst*>& outSignature)
+{
+    outSignature.clear();
+    for (auto block : func->getBlocks())
+    {
+        outSignature.add(block);
+        for (auto successor : block->getSuccessors())
+            outSignature.add(successor);
+        outSignature.add(nullptr);
+    }
+}
+
+static bool _isCFGSignatureEqual(IRGlobalValueWithCode* func, const List<IRInst*>& signature)
+{
+    Index i = 0;
+    const Index count = signature.getCount();
+    for (auto block : func->getBlocks())
+    {
+        if (i >= count || signature[i++] != block)
+            return false;
+        for (auto successor : block->getSuccessors())
+        {
+            if (i >= count || signature[i++] != successor)
+                return false;
+        }
+        if (i >= count || signature[i++] != nullptr)
+            return false;
+    }
+    return i == count;
+}
+
+IRDominatorTree* IRModule::findDominatorTree(IRGlobalValueWithCode* func)
+{
+    IRAnalysis* analysis = m_mapInstToAnalysis.tryGetValue(func);
+    if (analysis && analysis->domTree && _isCFGSignatureEqual(func, analysis->cfgSignature))
+        return analysis->getDominatorTree();
+    return nullptr;
+}
+
 IRDominatorTree* IRModule::findOrCreateDominatorTree(IRGlobalValueWithCode* func)
 {
     IRAnalysis* analysis = m_mapInstToAnalysis.tryGetValue(func);
     if (analysis)
-        return analysis->getDominatorTree();
+    {
+        if (analysis->domTree && _isCFGSignatureEqual(func, analysis->cfgSignature))
+        {
+            m_analysisStats.dominatorTreeReusedCount++;
+            return analysis->getDominatorTree();
+        }
+
+        // The control flow has changed since the tree was computed. The stale tree may
+        // still be referenced by its user, so keep it alive for now.
+        if (analysis->domTree)
+            m_retiredAnalyses.add(_Move(analysis->domTree));
+    }
     else
     {
         m_mapInstToAnalysis[func] = IRAnalysis();
         analysis = m_mapInstToAnalysis.tryGetValue(func);
     }
+
+    m_analysisStats.dominatorTreeComputedCount++;
     analysis->domTree = computeDominatorTree(func);
+    _calcCFGSignature(func, analysis->cfgSignature);
     return analysis->getDominatorTree();
 }
 
+void IRModule::invalidateAnalysisForInst(IRGlobalValueWithCode* func)
+{
+    m_mapInstToAnalysis.remove(func);
+}
+
 IRInst* IRBuilder::addDifferentiableTypeDictionaryDecoration(IRInst* target)
 {
     return addDecoration(target, kIROp_DifferentiableTypeDictionaryDecoration);
@@ -2386,6 +2386,26 @@ struct IRAnalysis
 {
     RefPtr<RefObject> domTree;
     IRDominatorTree* getDominatorTree();
+
+    /// The control flow graph the analysis was computed for: each block of the function in
+    /// order, followed by its successors and a null separator. A cached analysis is only
+    /// reused while the function still has the same control flow graph.
+    List<IRInst*> cfgSignature;
+};
+
+/// Counts of the dominator trees an IR module computed and reused, reported by
+/// `-report-perf-benchmark`
+struct IRAnalysisStats
+{
+    Count dominatorTreeComputedCount = 0; ///< Trees computed, because none was cached
+    Count dominatorTreeReusedCount = 0;   ///< Cached trees returned instead of computing them
+
+    IRAnalysisStats& operator+=(const IRAnalysisStats& rhs)
+    {
+        dominatorTreeComputedCount += rhs.dominatorTreeComputedCount;
+        dominatorTreeReusedCount += rhs.dominatorTreeReusedCount;
+        return *this;
+    }
 };
 
 struct IRModule : RefObject
@@ -2396,7 +2416,9 @@ public:
         kMemoryArenaBlockSize = 16 * 1024, ///< Use 16k block size for memory arena
     };
 
-    static RefPtr<IRModule> create(Session* session);
+    /// Create an empty module. If accounting is set, the memory of the module's instructions, and
+    /// the scratch memory of passes over it, is allocated through it.
+    static RefPtr<IRModule> create(Session* session, MemoryAccounting* accounting = nullptr);
 
     SLANG_FORCE_INLINE Session* getSession() const { return m_session; }
     SLANG_FORCE_INLINE IRModuleInst* getModuleInst() const { return m_moduleInst; }
@@ -2422,19 +2444,35 @@ public:
 
     IRDeduplicationContext* getDeduplicationContext() const { return &m_deduplicationContext; }
 
-    IRDominatorTree* findDominatorTree(IRGlobalValueWithCode* func)
-    {
-        IRAnalysis* analysis = m_mapInstToAnalysis.tryGetValue(func);
-        if (analysis)
-            return analysis->getDominatorTree();
-        return nullptr;
-    }
+    /// Find a cached dominator tree for `func` that is still valid, or nullptr
+    IRDominatorTree* findDominatorTree(IRGlobalValueWithCode* func);
+
+    /// Get the dominator tree for `func`.
+    ///
+    /// Dominator trees are cached per function, and a cached tree is reused for as long as the
+    /// control flow graph of the function is unchanged, so passes that don't modify the
+    /// control flow don't cause recomputation. Whether the graph has changed is checked on
+    /// each call, so passes don't have to invalidate analyses for correctness.
+    ///
+    /// The returned tree remains alive at least until the next `invalidateAnalysisForInst` for
+    /// `func` or `invalidateAllAnalysis`, even if it is replaced by a recomputed tree. Hold a
+    /// `RefPtr` to keep it longer.
     IRDominatorTree* findOrCreateDominatorTree(IRGlobalValueWithCode* func);
-    void invalidateAnalysisForInst(IRGlobalValueWithCode* func)
+
+    /// Discard the cached analyses of `func`, for when it has been changed or is about to
+    /// be deallocated
+    void invalidateAnalysisForInst(IRGlobalValueWithCode* func);
+
+    /// Discard all cached analyses, including those replaced by recomputation. DCE and
+    /// peephole optimization call this when they start, so analyses aren't held across the
+    /// passes of the optimization loop.
+    void invalidateAllAnalysis()
     {
-        m_mapInstToAnalysis.remove(func);
+        m_mapInstToAnalysis.clear();
+        m_retiredAnalyses.clear();
     }
-    void invalidateAllAnalysis() { m_mapInstToAnalysis.clear(); }
+
+    const IRAnalysisStats& getAnalysisStats() const { return m_analysisStats; }
 
     IRInstListBase getGlobalInsts() const { return getModuleInst()->getChildren(); }
 
@@ -2512,6 +2550,12 @@ private:
 
     Dictionary<IRInst*, IRAnalysis> m_mapInstToAnalysis;
 
+    /// Analyses that have been replaced because their function changed, kept alive until
+    /// `invalidateAllAnalysis` so that raw pointers handed out earlier stay valid.
+    List<RefPtr<RefObject>> m_retiredAnalyses;
+
+    IRAnalysisStats m_analysisStats;
+
     Dictionary<ImmutableHashedString, List<IRInst*>> m_mapMangledNameToGlobalInst;
 };
 
@@ -11920,9 +11920,56 @@ static void lowerProgramEntryPointToIR(
     }
 }
 
+/// Can lowering of `decl` be skipped until something refers to it, when lowering lazily?
+///
+/// Only function definitions are deferred. Anything that could make a function
+/// significant without a reference from other code (an attribute like `[shader]` or
+/// `[ForwardDerivativeOf]`, being exported, or being `public` and so callable from
+/// modules that import this one) makes it lowered up front, as do all other kinds of
+/// declaration, so that global parameters, types and conformances are the same as for
+/// a non-lazy lowering.
+///
+static bool _canLowerLazily(Decl* decl)
+{
+    if (!isPlainFunctionDefinition(decl))
+        return false;
+
+    if (auto genericDecl = as<GenericDecl>(decl))
+        decl = genericDecl->inner;
+    return !decl->hasModifier<PublicModifier>();
+}
+
+/// Was the body of function `decl` left unchecked, because nothing can reach it?
+///
+/// With `LazyImportedBodyChecking` an imported module only has the function bodies that
+/// the code being compiled can reach checked, and the others are not lowered at all.
+///
+static bool _hasUncheckedBody(Decl* decl)
+{
+    if (auto genericDecl = as<GenericDecl>(decl))
+        decl = genericDecl->inner;
+
+    auto funcDecl = as<FunctionDeclBase>(decl);
+    return funcDecl && funcDecl->body && !funcDecl->isChecked(DeclCheckState::DefinitionChecked);
+}
+
 /// Ensure that `decl` and all relevant declarations under it get emitted.
-static void ensureAllDeclsRec(IRGenContext* context, Decl* decl)
+///
+/// `skipUncheckedBodies` is only set for modules checked with `LazyImportedBodyChecking`.
+/// Otherwise a function with an unchecked body (such as one synthesized by the checker) is
+/// lowered as usual.
+///
+static void ensureAllDeclsRec(
+    IRGenContext* context,
+    Decl* decl,
+    bool lowerLazily,
+    bool skipUncheckedBodies)
 {
+    if (lowerLazily && _canLowerLazily(decl))
+        return;
+    if (skipUncheckedBodies && _hasUncheckedBody(decl))
+        return;
+
     ensureDecl(context, decl);
 
     // Note: We are checking here for aggregate type declarations, and
@@ -11938,26 +11985,26 @@ static void ensureAllDeclsRec(IRGenContext* context, Decl* decl)
     {
         for (auto memberDecl : containerDecl->getDirectMemberDecls())
         {
-            ensureAllDeclsRec(context, memberDecl);
+            ensureAllDeclsRec(context, memberDecl, lowerLazily, skipUncheckedBodies);
         }
     }
     else if (auto namespaceDecl = as<NamespaceDecl>(decl))
     {
         for (auto memberDecl : namespaceDecl->getDirectMemberDecls())
         {
-            ensureAllDeclsRec(context, memberDecl);
+            ensureAllDeclsRec(context, memberDecl, lowerLazily, skipUncheckedBodies);
         }
     }
     else if (auto fileDecl = as<FileDecl>(decl))
     {
         for (auto memberDecl : fileDecl->getDirectMemberDecls())
         {
-            ensureAllDeclsRec(context, memberDecl);
+            ensureAllDeclsRec(context, memberDecl, lowerLazily, skipUncheckedBodies);
         }
     }
     else if (auto genericDecl = as<GenericDecl>(decl))
     {
-        ensureAllDeclsRec(context, genericDecl->inner);
+        ensureAllDeclsRec(context, genericDecl->inner, lowerLazily, skipUncheckedBodies);
     }
 }
 
@@ -11983,7 +12030,7 @@ RefPtr<IRModule> generateIRForTranslationUnit(
     IRGenContext contextStorage(sharedContext, astBuilder);
     IRGenContext* context = &contextStorage;
 
-    RefPtr<IRModule> module = IRModule::create(session);
+    RefPtr<IRModule> module = IRModule::create(session, linkage->getMemoryAccounting());
 
     module->setName(translationUnit->getModuleDecl()->getName());
 
@@ -12027,9 +12074,29 @@ RefPtr<IRModule> generateIRForTranslationUnit(
     //
     // Next, ensure that all other global declarations have
     // been emitted.
+    //
+    // With `LazyIRLowering`, functions that only exist to be called are
+    // skipped here, and are lowered when lowering the entry points (or
+    // anything else) first refers to them. A module without entry points is
+    // a library, and so gets everything lowered.
+    //
+    // Only the translation units being compiled are lowered lazily. A module
+    // that was loaded into the linkage (by `import` or `loadModule`) can be
+    // imported by other code later, which may call any of its functions.
+    //
+    RefPtr<LoadedModule> loadedModule;
+    const bool isLoadedModule =
+        translationUnit->moduleName &&
+        linkage->mapNameToLoadedModules.tryGetValue(translationUnit->moduleName, loadedModule) &&
+        loadedModule == translationUnit->getModule();
+    const bool lowerLazily =
+        translationUnit->compileRequest->optionSet.getBoolOption(
+            CompilerOptionName::LazyIRLowering) &&
+        translationUnit->getEntryPoints().getCount() != 0 && !isLoadedModule;
+    const bool skipUncheckedBodies = translationUnit->getModule()->shouldCheckBodiesOnDemand();
     for (auto decl : translationUnit->getModuleDecl()->getDirectMemberDecls())
     {
-        ensureAllDeclsRec(context, decl);
+        ensureAllDeclsRec(context, decl, lowerLazily, skipUncheckedBodies);
     }
 
     // Build a global instruction to hold all the string
@@ -12311,6 +12378,9 @@ RefPtr<IRModule> generateIRForTranslationUnit(
 
     module->buildMangledNameToGlobalInstMap();
 
+    linkage->m_containerPoolStats += module->getContainerPool().getStats();
+    linkage->m_irAnalysisStats += module->getAnalysisStats();
+
     return module;
 }
 
@@ -12338,7 +12408,7 @@ struct SpecializedComponentTypeIRGenContext : ComponentTypeVisitor
         IRGenContext contextStorage(sharedContext, linkage->getASTBuilder());
         context = &contextStorage;
 
-        RefPtr<IRModule> module = IRModule::create(session);
+        RefPtr<IRModule> module = IRModule::create(session, linkage->getMemoryAccounting());
 
         IRBuilder builderStorage(module);
         builder = &builderStorage;
@@ -12487,7 +12557,7 @@ struct TypeConformanceIRGenContext
         IRGenContext contextStorage(sharedContext, linkage->getASTBuilder());
         context = &contextStorage;
 
-        RefPtr<IRModule> module = IRModule::create(session);
+        RefPtr<IRModule> module = IRModule::create(session, linkage->getMemoryAccounting());
 
         IRBuilder builderStorage(module);
         builder = &builderStorage;
@@ -12843,7 +12913,7 @@ RefPtr<IRModule> TargetProgram::createIRModuleForLayout(DiagnosticSink* sink)
     IRLayoutGenContext contextStorage(sharedContext, astBuilder);
     auto context = &contextStorage;
 
-    RefPtr<IRModule> irModule = IRModule::create(session);
+    RefPtr<IRModule> irModule = IRModule::create(session, linkage->getMemoryAccounting());
 
     IRBuilder builderStorage(irModule);
     auto builder = &builderStorage;
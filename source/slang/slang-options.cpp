@@ -401,6 +401,30 @@ void initCommandOptions(CommandOptions& options)
          "-minimum-slang-optimization",
          nullptr,
          "Perform minimum code optimization in Slang to favor compilation time."},
+        {OptionKind::LazyIRLowering,
+         "-lazy-ir-lowering",
+         nullptr,
+         "Only generate IR for the functions of a module that its entry points use, instead of "
+         "every function. Has no effect on modules without entry points. The generated module "
+         "should not be reused as a library."},
+        {OptionKind::LazyImportedBodyChecking,
+         "-lazy-imported-body-checking",
+         nullptr,
+         "Only check the bodies of functions in imported modules that the code being compiled "
+         "can reach. Diagnostics inside functions that are never used are not reported."},
+        {OptionKind::MemoryLimit,
+         "-memory-limit",
+         "-memory-limit <megabytes>",
+         "Abort compilation with an error once the AST, IR and container memory taken by a "
+         "compile exceeds the limit. Memory already held by the session when the compile starts "
+         "doesn't count. "
+         "The limit is checked between compilation phases, so it can be exceeded by the work of "
+         "one phase."},
+        {OptionKind::PrefetchImports,
+         "-prefetch-imports",
+         nullptr,
+         "Read the files of imported modules on worker threads while the modules that import "
+         "them are checked. Has no effect when the application provides a file system."},
         {OptionKind::DisableNonEssentialValidations,
          "-disable-non-essential-validations",
          nullptr,
@@ -536,8 +560,12 @@ void initCommandOptions(CommandOptions& options)
          "Include additional type conformance during linking for dynamic dispatch."},
         {OptionKind::EmitReflectionJSON,
          "-reflection-json",
-         "reflection-json <path>",
-         "Emit reflection data in JSON format to a file."}};
+         "-reflection-json <path>",
+         "Emit reflection data in JSON format to a file."},
+        {OptionKind::EmitReflectionBinary,
+         "-reflection-binary",
+         "-reflection-binary <path>",
+         "Emit reflection data in binary format to a file."}};
 
     _addOptions(makeConstArrayView(generalOpts), options);
 
@@ -2194,6 +2222,9 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
         case OptionKind::IgnoreCapabilities:
         case OptionKind::RestrictiveCapabilityCheck:
         case OptionKind::MinimumSlangOptimization:
+        case OptionKind::LazyIRLowering:
+        case OptionKind::LazyImportedBodyChecking:
+        case OptionKind::PrefetchImports:
         case OptionKind::DisableNonEssentialValidations:
         case OptionKind::DisableSourceMap:
         case OptionKind::DefaultImageFormatUnknown:
@@ -2773,6 +2804,16 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
                 linkage->m_optionSet.set(CompilerOptionName::EmitReflectionJSON, outputPath.value);
                 break;
             }
+        case OptionKind::EmitReflectionBinary:
+            {
+                CommandLineArg outputPath;
+                SLANG_RETURN_ON_FAIL(m_reader.expectArg(outputPath));
+
+                linkage->m_optionSet.set(
+                    CompilerOptionName::EmitReflectionBinary,
+                    outputPath.value);
+                break;
+            }
         case OptionKind::DepFile:
             {
                 CommandLineArg dependencyPath;
@@ -3001,6 +3042,13 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
                 linkage->m_optionSet.add(OptionKind::BindlessSpaceIndex, (int)index);
                 break;
             }
+        case OptionKind::MemoryLimit:
+            {
+                Int megabytes = 0;
+                SLANG_RETURN_ON_FAIL(_expectInt(arg, megabytes));
+                linkage->m_optionSet.add(OptionKind::MemoryLimit, (int)megabytes);
+                break;
+            }
         case OptionKind::DumpModule:
             {
                 CommandLineArg fileName;
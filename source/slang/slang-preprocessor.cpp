@@ -12,9 +12,11 @@
 // to another.
 
 #include "../compiler-core/slang-lexer.h"
+#include "../core/slang-free-list.h"
 #include "slang-compiler.h"
 #include "slang-diagnostics.h"
 
+#include <algorithm>
 #include <assert.h>
 
 namespace Slang
@@ -198,6 +200,8 @@ struct InputStream
 
     void setParent(InputStream* parent) { m_parent = parent; }
 
+    Preprocessor* getPreprocessor() { return m_preprocessor; }
+
     MacroInvocation* getFirstBusyMacroInvocation() { return m_firstBusyMacroInvocation; }
 
     virtual SourceLoc findNextLineEndImpl(SourceLoc from, UInt& lineCount) const = 0;
@@ -268,12 +272,14 @@ struct SingleUseInputStream : PretokenizedInputStream
 {
     typedef PretokenizedInputStream Super;
 
-    SingleUseInputStream(Preprocessor* preprocessor, TokenList const& lexedTokens)
-        : Super(preprocessor), m_lexedTokens(lexedTokens)
+    SingleUseInputStream(Preprocessor* preprocessor, TokenList&& lexedTokens)
+        : Super(preprocessor), m_lexedTokens(_Move(lexedTokens))
     {
         m_tokenReader = TokenReader(m_lexedTokens);
     }
 
+    ~SingleUseInputStream();
+
     /// A list of raw tokens that will provide input
     TokenList m_lexedTokens;
 };
@@ -282,11 +288,15 @@ struct SingleUseInputStream : PretokenizedInputStream
 // we end up needing to track multiple active input streams, and this is most
 // easily done by having a distinct type to represent a stack of input streams.
 
+/// Destroy an input stream that was created with `Preprocessor::createInputStream()`
+static void destroyInputStream(InputStream* stream);
+
 /// A stack of input streams, that will always read the next available token from the top-most
 /// stream
 ///
 /// An input stream stack assumes ownership of all streams pushed onto it, and will clean them
-/// up when they are no longer active or when the stack gets destructed.
+/// up (with `destroyInputStream()`) when they are no longer active or when the stack gets
+/// destructed.
 ///
 struct InputStreamStack
 {
@@ -311,7 +321,7 @@ struct InputStreamStack
         for (InputStream* s = m_top; s; s = parent)
         {
             parent = s->getParent();
-            delete s;
+            destroyInputStream(s);
         }
         m_top = nullptr;
     }
@@ -343,10 +353,10 @@ struct InputStreamStack
             if (parent)
             {
                 // This stack has taken ownership of the streams,
-                // and must therefore delete the top stream before
+                // and must therefore destroy the top stream before
                 // popping it.
                 //
-                delete m_top;
+                destroyInputStream(m_top);
                 m_top = parent;
                 continue;
             }
@@ -705,6 +715,8 @@ struct MacroInvocation : InputStream
         SourceLoc macroInvocationLoc,
         SourceLoc initiatingMacroInvocationLoc);
 
+    ~MacroInvocation();
+
     /// Prime the input stream
     ///
     /// This operation *must* be called before the first `readToken()` or `peekToken()`
@@ -732,6 +744,17 @@ struct MacroInvocation : InputStream
 
     MacroDefinition* getMacroDefinition() { return m_macro; }
 
+    /// A single argument to the macro invocation
+    ///
+    /// Each argument is represented as a begin/end pair of indices
+    /// into the sequence of tokens that make up the macro arguments.
+    ///
+    struct Arg
+    {
+        Index beginTokenIndex = 0;
+        Index endTokenIndex = 0;
+    };
+
     virtual SourceLoc findNextLineEndImpl(SourceLoc from, UInt& lineCount) const SLANG_OVERRIDE
     {
         // There are no actual lines inside of a macro invocation
@@ -750,17 +773,6 @@ private:
     /// The macro being expanded
     MacroDefinition* m_macro;
 
-    /// A single argument to the macro invocation
-    ///
-    /// Each argument is represented as a begin/end pair of indices
-    /// into the sequence of tokens that make up the macro arguments.
-    ///
-    struct Arg
-    {
-        Index beginTokenIndex = 0;
-        Index endTokenIndex = 0;
-    };
-
     /// Tokens that make up the macro arguments, in case of function-like macro expansion
     List<Token> m_argTokens;
 
@@ -935,6 +947,29 @@ private:
 // the same abstraction due to all the special-case handling that directives
 // and conditionals require.
 
+/// How far detection of an include guard has got for an input file.
+///
+/// A file is guarded when, ignoring whitespace and comments, it consists of a single
+/// `#ifndef NAME` ... `#endif` conditional without any `#else` or `#elif` branches.
+/// Including such a file again while `NAME` is defined produces no tokens, so the
+/// preprocessor can skip the file without reading it, in the same way as a file
+/// with `#pragma once`.
+///
+enum class IncludeGuardState
+{
+    /// Nothing other than whitespace or comments has been seen yet
+    Start,
+
+    /// The file started with an `#ifndef`, and that conditional is still open
+    InsideGuard,
+
+    /// The `#ifndef` conditional has been closed, and nothing has been seen after it
+    AfterGuard,
+
+    /// The file is not guarded
+    NotGuarded,
+};
+
 /// An input file being processed by the preprocessor.
 ///
 /// An input file manages both the expansion of lexed tokens
@@ -979,6 +1014,52 @@ struct InputFile
 
     bool isIncludedFile() { return m_parent != nullptr; }
 
+    /// Note that the conditional opened by an `#ifndef name` directive has just been pushed
+    void noteIfNDefConditional(Name* name)
+    {
+        if (m_includeGuardState != IncludeGuardState::Start || m_conditional->parent)
+            return;
+        m_includeGuardState = IncludeGuardState::InsideGuard;
+        m_includeGuardName = name;
+        m_includeGuardConditional = m_conditional;
+    }
+
+    /// Note that a token or directive has been seen outside of any conditional
+    void noteTopLevelContent()
+    {
+        // The `#ifndef` that opens the guard is the only top-level content a guarded file
+        // can have.
+        if (m_includeGuardState != IncludeGuardState::InsideGuard)
+            m_includeGuardState = IncludeGuardState::NotGuarded;
+    }
+
+    /// Note that `conditional` has an `#else` or `#elif` branch
+    void noteConditionalBranch(Conditional* conditional)
+    {
+        if (conditional != m_includeGuardConditional)
+            return;
+        m_includeGuardState = IncludeGuardState::NotGuarded;
+        m_includeGuardConditional = nullptr;
+    }
+
+    /// Note that `conditional` is about to be closed by an `#endif`
+    void noteConditionalEnd(Conditional* conditional)
+    {
+        if (conditional != m_includeGuardConditional)
+            return;
+        m_includeGuardState = IncludeGuardState::AfterGuard;
+        m_includeGuardConditional = nullptr;
+    }
+
+    /// Get the name of the macro guarding the whole file, or nullptr if the file isn't guarded.
+    ///
+    /// Only meaningful once the whole file has been read.
+    Name* getIncludeGuardName()
+    {
+        return m_includeGuardState == IncludeGuardState::AfterGuard ? m_includeGuardName
+                                                                      : nullptr;
+    }
+
 private:
     friend struct Preprocessor;
 
@@ -1000,6 +1081,15 @@ private:
 
     /// An input stream that applies macro expansion to `m_lexerStream`
     ExpansionInputStream* m_expansionStream;
+
+    /// How far include guard detection has got for this file
+    IncludeGuardState m_includeGuardState = IncludeGuardState::Start;
+
+    /// The macro named by the `#ifndef` that started the file, if any
+    Name* m_includeGuardName = nullptr;
+
+    /// The conditional opened by that `#ifndef`, while it is still open
+    Conditional* m_includeGuardConditional = nullptr;
 };
 
 enum class PragmaWarningSpecifier
@@ -1257,6 +1347,20 @@ struct WarningStateTracker : SourceWarningStateTrackerBase
     }
 };
 
+/// The size and alignment of the memory for an input stream, large enough for any type of stream
+static constexpr size_t kInputStreamSize = std::max(
+    {sizeof(LexerInputStream),
+     sizeof(PretokenizedInputStream),
+     sizeof(SingleUseInputStream),
+     sizeof(MacroInvocation),
+     sizeof(ExpansionInputStream)});
+static constexpr size_t kInputStreamAlignment = std::max(
+    {alignof(LexerInputStream),
+     alignof(PretokenizedInputStream),
+     alignof(SingleUseInputStream),
+     alignof(MacroInvocation),
+     alignof(ExpansionInputStream)});
+
 /// State of the preprocessor
 struct Preprocessor
 {
@@ -1284,10 +1388,36 @@ struct Preprocessor
     /// Callback handlers
     PreprocessorHandler* handler = nullptr;
 
+    /// Memory for all of the input streams created during preprocessing.
+    ///
+    /// An input stream is created for every macro invocation, and for every parameter
+    /// reference, pasted token and builtin within its expansion, so their memory is
+    /// recycled through a free list rather than going to the heap for each one.
+    FreeList inputStreamFreeList{kInputStreamSize, kInputStreamAlignment, 64};
+
+    /// Token and macro argument lists of destroyed input streams, kept so that new input
+    /// streams can reuse their storage
+    List<List<Token>> spareTokenLists;
+    List<List<MacroInvocation::Arg>> spareMacroArgLists;
+
+    /// Create an input stream of type `T`, which should be destroyed with
+    /// `destroyInputStream()`
+    template<typename T, typename... Args>
+    T* createInputStream(Args&&... args)
+    {
+        static_assert(sizeof(T) <= kInputStreamSize, "input stream is too large");
+        static_assert(alignof(T) <= kInputStreamAlignment, "input stream is over-aligned");
+        return new (inputStreamFreeList.allocate()) T(this, std::forward<Args>(args)...);
+    }
+
     /// The unique identities of any paths that have issued `#pragma once` directives to
     /// stop them from being included again.
     HashSet<String> pragmaOnceUniqueIdentities;
 
+    /// The guard macro of each file (by unique identity) found to be wrapped in an include
+    /// guard. Such a file is not included again while its guard macro is defined.
+    Dictionary<String, Name*> includeGuardNames;
+
     WarningStateTracker* warningStateTracker = nullptr;
 
     /// Name pool to use when creating `Name`s from strings
@@ -1371,6 +1501,40 @@ static void reportIncludeFileForContentAssist(Preprocessor* preprocessor, Token
 
 // static Token AdvanceToken(Preprocessor* preprocessor);
 
+static void destroyInputStream(InputStream* stream)
+{
+    Preprocessor* preprocessor = stream->getPreprocessor();
+    stream->~InputStream();
+    preprocessor->inputStreamFreeList.deallocate(stream);
+}
+
+/// Take a list from `spareLists`, if there is one, so that its storage can be reused by `outList`
+template<typename T>
+static void _takeSpareList(List<List<T>>& spareLists, List<T>& outList)
+{
+    SLANG_ASSERT(outList.getCapacity() == 0);
+    if (spareLists.getCount())
+    {
+        outList.swapWith(spareLists.getLast());
+        spareLists.removeLast();
+    }
+}
+
+/// Add the storage of `list` to `spareLists` so that it can be reused
+template<typename T>
+static void _addSpareList(List<List<T>>& spareLists, List<T>& list)
+{
+    if (list.getCapacity() == 0)
+        return;
+    list.clear();
+    spareLists.add(_Move(list));
+}
+
+SingleUseInputStream::~SingleUseInputStream()
+{
+    _addSpareList(m_preprocessor->spareTokenLists, m_lexedTokens.m_tokens);
+}
+
 // Convenience routine to access the diagnostic sink
 static DiagnosticSink* GetSink(Preprocessor* preprocessor)
 {
@@ -1398,8 +1562,8 @@ InputFile::InputFile(Preprocessor* preprocessor, SourceView* sourceView)
 {
     m_preprocessor = preprocessor;
 
-    m_lexerStream = new LexerInputStream(preprocessor, sourceView);
-    m_expansionStream = new ExpansionInputStream(preprocessor, m_lexerStream);
+    m_lexerStream = preprocessor->createInputStream<LexerInputStream>(sourceView);
+    m_expansionStream = preprocessor->createInputStream<ExpansionInputStream>(m_lexerStream);
 }
 
 InputFile::~InputFile()
@@ -1416,11 +1580,11 @@ InputFile::~InputFile()
         delete conditional;
     }
 
-    // Note: We only delete the expansion strema here because the lexer
+    // Note: We only destroy the expansion strema here because the lexer
     // stream is being used as the "base" stream of the expansion stream,
-    // and the expansion stream takes responsibility for deleting it.
+    // and the expansion stream takes responsibility for destroying it.
     //
-    delete m_expansionStream;
+    destroyInputStream(m_expansionStream);
 }
 
 //
@@ -1463,6 +1627,15 @@ MacroInvocation::MacroInvocation(
     m_firstBusyMacroInvocation = this;
     m_macroInvocationLoc = macroInvocationLoc;
     m_initiatingMacroInvocationLoc = initiatingMacroInvocationLoc;
+
+    _takeSpareList(preprocessor->spareTokenLists, m_argTokens);
+    _takeSpareList(preprocessor->spareMacroArgLists, m_args);
+}
+
+MacroInvocation::~MacroInvocation()
+{
+    _addSpareList(m_preprocessor->spareTokenLists, m_argTokens);
+    _addSpareList(m_preprocessor->spareMacroArgLists, m_args);
 }
 
 void MacroInvocation::prime(MacroInvocation* nextBusyMacroInvocation)
@@ -1741,8 +1914,7 @@ void ExpansionInputStream::_maybeBeginMacroInvocation()
                 // are all those that were busy at the time we read the name of the macro
                 // to be expanded.
                 //
-                MacroInvocation* invocation = new MacroInvocation(
-                    preprocessor,
+                MacroInvocation* invocation = preprocessor->createInputStream<MacroInvocation>(
                     macro,
                     token.loc,
                     m_initiatingMacroInvocationLoc);
@@ -1798,8 +1970,7 @@ void ExpansionInputStream::_maybeBeginMacroInvocation()
                 // If we saw an opening `(`, then we know we are starting some kind of
                 // macro invocation, although we don't yet know if it is well-formed.
                 //
-                MacroInvocation* invocation = new MacroInvocation(
-                    preprocessor,
+                MacroInvocation* invocation = preprocessor->createInputStream<MacroInvocation>(
                     macro,
                     token.loc,
                     m_initiatingMacroInvocationLoc);
@@ -1852,6 +2023,7 @@ void ExpansionInputStream::_maybeBeginMacroInvocation()
                                 Diagnostics::wrongNumberOfArgumentsToMacro,
                                 paramCount,
                                 argCount);
+                        destroyInputStream(invocation);
                         return;
                     }
                 }
@@ -1871,6 +2043,7 @@ void ExpansionInputStream::_maybeBeginMacroInvocation()
                                 Diagnostics::wrongNumberOfArgumentsToMacro,
                                 requiredArgCount,
                                 argCount);
+                        destroyInputStream(invocation);
                         return;
                     }
                 }
@@ -2202,7 +2375,7 @@ Token MacroInvocation::_readTokenImpl()
                 // right-hand-side op, which is consistent with `m_macroOpIndex`.
                 //
                 SingleUseInputStream* inputStream =
-                    new SingleUseInputStream(m_preprocessor, lexedTokens);
+                    m_preprocessor->createInputStream<SingleUseInputStream>(_Move(lexedTokens));
                 m_currentOpStreams.push(inputStream);
 
                 // There's one final detail to cover before we move on. *If* we used `token` as part
@@ -2257,6 +2430,7 @@ void MacroInvocation::_pushSingleTokenStream(
     token.loc = tokenLoc;
 
     TokenList lexedTokens;
+    _takeSpareList(m_preprocessor->spareTokenLists, lexedTokens.m_tokens);
     lexedTokens.add(token);
 
     // Every token list needs to be terminated with an EOF,
@@ -2269,7 +2443,8 @@ void MacroInvocation::_pushSingleTokenStream(
     eofToken.flags = TokenFlag::AfterWhitespace | TokenFlag::AtStartOfLine;
     lexedTokens.add(eofToken);
 
-    SingleUseInputStream* inputStream = new SingleUseInputStream(m_preprocessor, lexedTokens);
+    SingleUseInputStream* inputStream =
+        m_preprocessor->createInputStream<SingleUseInputStream>(_Move(lexedTokens));
     m_currentOpStreams.push(inputStream);
 }
 
@@ -2412,7 +2587,7 @@ void MacroInvocation::_initCurrentOpStream()
             auto tokenReader =
                 TokenReader(tokenBuffer + beginTokenIndex, tokenBuffer + endTokenIndex);
             PretokenizedInputStream* stream =
-                new PretokenizedInputStream(m_preprocessor, tokenReader);
+                m_preprocessor->createInputStream<PretokenizedInputStream>(tokenReader);
             m_currentOpStreams.push(stream);
         }
         break;
@@ -2437,7 +2612,7 @@ void MacroInvocation::_initCurrentOpStream()
             // play back those tokens exactly as they appeared in the argument list.
             //
             PretokenizedInputStream* stream =
-                new PretokenizedInputStream(m_preprocessor, tokenReader);
+                m_preprocessor->createInputStream<PretokenizedInputStream>(tokenReader);
             m_currentOpStreams.push(stream);
         }
         break;
@@ -2451,13 +2626,14 @@ void MacroInvocation::_initCurrentOpStream()
             Index paramIndex = op.index1;
             auto tokenReader = _getArgTokens(paramIndex);
             PretokenizedInputStream* stream =
-                new PretokenizedInputStream(m_preprocessor, tokenReader);
+                m_preprocessor->createInputStream<PretokenizedInputStream>(tokenReader);
 
             // The only interesting addition to the unexpanded case is that we wrap
             // the stream that "plays back" the argument tokens with a stream that
             // applies macro expansion to them.
             //
-            ExpansionInputStream* expansion = new ExpansionInputStream(m_preprocessor, stream);
+            ExpansionInputStream* expansion =
+                m_preprocessor->createInputStream<ExpansionInputStream>(stream);
             expansion->setInitiatingMacroSourceLoc(m_initiatingMacroInvocationLoc);
             m_currentOpStreams.push(expansion);
         }
@@ -3286,6 +3462,8 @@ static void HandleIfNDefDirective(PreprocessorDirectiveContext* context)
 
     // Check if the name is defined.
     beginConditional(context, LookupMacro(context, name) == NULL);
+
+    getInputFile(context)->noteIfNDefConditional(name);
 }
 
 // Handle a `#else` directive
@@ -3316,6 +3494,7 @@ static void HandleElseDirective(PreprocessorDirectiveContext* context)
         return;
     }
     conditional->elseToken = context->m_directiveToken;
+    inputFile->noteConditionalBranch(conditional);
 
     switch (conditional->state)
     {
@@ -3380,6 +3559,8 @@ static void HandleElifDirective(PreprocessorDirectiveContext* context)
         return;
     }
 
+    inputFile->noteConditionalBranch(conditional);
+
     switch (conditional->state)
     {
     case Conditional::State::Before:
@@ -3427,6 +3608,7 @@ static void HandleEndIfDirective(PreprocessorDirectiveContext* context)
         return;
     }
 
+    inputFile->noteConditionalEnd(conditional);
     inputFile->popConditional();
 
     updateLexerFlagsForConditionals(inputFile);
@@ -3577,6 +3759,16 @@ static void HandleIncludeDirective(PreprocessorDirectiveContext* context)
         return;
     }
 
+    // Check whether we've previously included this file and found that it is wrapped in an
+    // include guard whose macro is still defined. If so the file would expand to nothing, so
+    // there is no need to read it again.
+    if (auto includeGuardName =
+            context->m_preprocessor->includeGuardNames.tryGetValue(filePathInfo.uniqueIdentity))
+    {
+        if (LookupMacro(context, *includeGuardName))
+            return;
+    }
+
     // Simplify the path
     filePathInfo.foundPath = includeSystem->simplifyPath(filePathInfo.foundPath);
 
@@ -4619,6 +4811,19 @@ void Preprocessor::popInputFile()
             conditional->ifToken.getContent());
     }
 
+    // If the whole file turned out to be wrapped in an include guard, remember its macro
+    // so that later `#include`s of the file can be skipped while the macro is defined.
+    //
+    if (auto includeGuardName = inputFile->getIncludeGuardName())
+    {
+        SourceFile* sourceFile = inputFile->getLexer()->m_sourceView->getSourceFile();
+        const PathInfo& pathInfo = sourceFile->getPathInfo();
+        if (pathInfo.hasUniqueIdentity())
+        {
+            includeGuardNames[pathInfo.uniqueIdentity] = includeGuardName;
+        }
+    }
+
     {
         SourceView* sourceView = inputFile->getLexer()->m_sourceView;
         auto lastSegment = sourceView->getLastSegment();
@@ -4685,7 +4890,10 @@ static Token ReadToken(Preprocessor* preprocessor)
             directiveContext.m_inputFile = inputFile;
 
             // Parse and handle the directive
+            const bool isTopLevel = inputFile->getInnerMostConditional() == nullptr;
             HandleDirective(&directiveContext);
+            if (isTopLevel)
+                inputFile->noteTopLevelContent();
             continue;
         }
 
@@ -4696,6 +4904,13 @@ static Token ReadToken(Preprocessor* preprocessor)
             continue;
         }
 
+        // Anything other than a line break outside of a conditional means that the file isn't
+        // wrapped in an include guard.
+        if (token.type != TokenType::NewLine && !inputFile->getInnerMostConditional())
+        {
+            inputFile->noteTopLevelContent();
+        }
+
         token = expansionStream->peekToken();
         if (token.type == TokenType::EndOfFile)
         {
@@ -4825,7 +5040,7 @@ Result findMacroValue(
         return SLANG_FAIL;
 
     MacroInvocation* invocation =
-        new MacroInvocation(preprocessor, macro, SourceLoc(), SourceLoc());
+        preprocessor->createInputStream<MacroInvocation>(macro, SourceLoc(), SourceLoc());
 
     // Note: Since we are only expanding the one macro, we should not treat any
     // other macros as "busy" at the start of expansion.
@@ -4844,7 +5059,7 @@ Result findMacroValue(
         value.append(token.getContent());
     }
 
-    delete invocation;
+    destroyInputStream(invocation);
 
     outValue = value;
     outLoc = macro->getLoc();
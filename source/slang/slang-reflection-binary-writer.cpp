@@ -0,0 +1,301 @@
+#include "slang-reflection-binary-writer.h"
+
+#include "../core/slang-blob.h"
+#include "../core/slang-dictionary.h"
+#include "slang-reflection-binary.h"
+
+namespace Slang
+{
+
+namespace ReflectionBinary = slang::reflection_binary;
+
+namespace
+{ // anonymous
+
+struct ReflectionBinaryWriter
+{
+    typedef ReflectionBinary::Index Index;
+
+    ReflectionBinaryWriter()
+    {
+        // Offset 0 is the empty string
+        m_strings.add(0);
+    }
+
+    ReflectionBinary::StringOffset addString(const char* text)
+    {
+        if (!text)
+            return ReflectionBinary::kNullIndex;
+        if (*text == 0)
+            return 0;
+
+        String string(text);
+        if (auto offset = m_stringMap.tryGetValue(string))
+            return *offset;
+
+        const auto offset = ReflectionBinary::StringOffset(m_strings.getCount());
+        m_strings.addRange(text, string.getLength() + 1);
+        m_stringMap.add(string, offset);
+        return offset;
+    }
+
+    static uint32_t toSize(size_t size)
+    {
+        return size == SLANG_UNBOUNDED_SIZE ? ReflectionBinary::kUnboundedSize : uint32_t(size);
+    }
+
+    ReflectionBinary::Range addIndices(const List<Index>& indices)
+    {
+        ReflectionBinary::Range range;
+        range.begin = uint32_t(m_indices.getCount());
+        range.count = uint32_t(indices.getCount());
+        m_indices.addRange(indices);
+        return range;
+    }
+
+    Index addType(slang::TypeReflection* type)
+    {
+        if (!type)
+            return ReflectionBinary::kNullIndex;
+        if (auto index = m_typeMap.tryGetValue(type))
+            return *index;
+
+        // Reserve the slot before visiting what the type references, so recursive
+        // references (e.g. through pointers) resolve to it.
+        const Index index = Index(m_types.getCount());
+        m_types.add(ReflectionBinary::Type{});
+        m_typeMap.add(type, index);
+
+        ReflectionBinary::Type entry = {};
+        entry.kind = uint32_t(type->getKind());
+        entry.name = addString(type->getName());
+        entry.scalarType = uint32_t(type->getScalarType());
+        entry.rowCount = type->getRowCount();
+        entry.columnCount = type->getColumnCount();
+        entry.elementCount = toSize(type->getElementCount());
+        entry.elementType = addType(type->getElementType());
+        entry.resourceShape = uint32_t(type->getResourceShape());
+        entry.resourceAccess = uint32_t(type->getResourceAccess());
+        entry.resourceResultType = addType(type->getResourceResultType());
+
+        List<Index> fields;
+        const auto fieldCount = type->getFieldCount();
+        for (unsigned int i = 0; i < fieldCount; ++i)
+            fields.add(addVariable(type->getFieldByIndex(i)));
+        entry.fields = addIndices(fields);
+
+        m_types[index] = entry;
+        return index;
+    }
+
+    Index addVariable(slang::VariableReflection* var)
+    {
+        if (!var)
+            return ReflectionBinary::kNullIndex;
+        if (auto index = m_variableMap.tryGetValue(var))
+            return *index;
+
+        const Index index = Index(m_variables.getCount());
+        m_variables.add(ReflectionBinary::Variable{});
+        m_variableMap.add(var, index);
+
+        ReflectionBinary::Variable entry;
+        entry.name = addString(var->getName());
+        entry.type = addType(var->getType());
+
+        m_variables[index] = entry;
+        return index;
+    }
+
+    Index addTypeLayout(slang::TypeLayoutReflection* typeLayout)
+    {
+        if (!typeLayout)
+            return ReflectionBinary::kNullIndex;
+        if (auto index = m_typeLayoutMap.tryGetValue(typeLayout))
+            return *index;
+
+        const Index index = Index(m_typeLayouts.getCount());
+        m_typeLayouts.add(ReflectionBinary::TypeLayout{});
+        m_typeLayoutMap.add(typeLayout, index);
+
+        ReflectionBinary::TypeLayout entry = {};
+        entry.type = addType(typeLayout->getType());
+        entry.kind = uint32_t(typeLayout->getKind());
+        entry.parameterCategory = uint32_t(typeLayout->getParameterCategory());
+        entry.uniformAlignment = uint32_t(typeLayout->getAlignment());
+        entry.uniformStride = toSize(typeLayout->getStride());
+
+        entry.sizes.begin = uint32_t(m_categorySizes.getCount());
+        const auto categoryCount = typeLayout->getCategoryCount();
+        for (unsigned int i = 0; i < categoryCount; ++i)
+        {
+            const auto category = typeLayout->getCategoryByIndex(i);
+            ReflectionBinary::CategorySize size;
+            size.category = uint32_t(category);
+            size.size = toSize(typeLayout->getSize(category));
+            m_categorySizes.add(size);
+        }
+        entry.sizes.count = uint32_t(categoryCount);
+
+        entry.elementTypeLayout = addTypeLayout(typeLayout->getElementTypeLayout());
+        entry.elementVarLayout = addVariableLayout(typeLayout->getElementVarLayout());
+        entry.containerVarLayout = addVariableLayout(typeLayout->getContainerVarLayout());
+
+        List<Index> fields;
+        const auto fieldCount = typeLayout->getFieldCount();
+        for (unsigned int i = 0; i < fieldCount; ++i)
+            fields.add(addVariableLayout(typeLayout->getFieldByIndex(i)));
+        entry.fields = addIndices(fields);
+
+        m_typeLayouts[index] = entry;
+        return index;
+    }
+
+    Index addVariableLayout(slang::VariableLayoutReflection* varLayout)
+    {
+        if (!varLayout)
+            return ReflectionBinary::kNullIndex;
+        if (auto index = m_variableLayoutMap.tryGetValue(varLayout))
+            return *index;
+
+        const Index index = Index(m_variableLayouts.getCount());
+        m_variableLayouts.add(ReflectionBinary::VariableLayout{});
+        m_variableLayoutMap.add(varLayout, index);
+
+        ReflectionBinary::VariableLayout entry = {};
+        entry.variable = addVariable(varLayout->getVariable());
+        entry.typeLayout = addTypeLayout(varLayout->getTypeLayout());
+        entry.stage = uint32_t(varLayout->getStage());
+        entry.semanticName = addString(varLayout->getSemanticName());
+        entry.semanticIndex = uint32_t(varLayout->getSemanticIndex());
+
+        entry.bindings.begin = uint32_t(m_bindings.getCount());
+        const auto categoryCount = varLayout->getCategoryCount();
+        for (unsigned int i = 0; i < categoryCount; ++i)
+        {
+            const auto category = varLayout->getCategoryByIndex(i);
+            ReflectionBinary::Binding binding = {};
+            binding.category = uint32_t(category);
+            binding.offset = toSize(varLayout->getOffset(category));
+            binding.space = toSize(varLayout->getBindingSpace(category));
+            m_bindings.add(binding);
+        }
+        entry.bindings.count = uint32_t(categoryCount);
+
+        m_variableLayouts[index] = entry;
+        return index;
+    }
+
+    void addEntryPoint(slang::EntryPointReflection* entryPoint)
+    {
+        ReflectionBinary::EntryPoint entry = {};
+        entry.name = addString(entryPoint->getName());
+        entry.stage = uint32_t(entryPoint->getStage());
+
+        SlangUInt threadGroupSize[3] = {};
+        entryPoint->getComputeThreadGroupSize(3, threadGroupSize);
+        for (int i = 0; i < 3; ++i)
+            entry.threadGroupSize[i] = uint32_t(threadGroupSize[i]);
+
+        List<Index> params;
+        const auto paramCount = entryPoint->getParameterCount();
+        for (unsigned int i = 0; i < paramCount; ++i)
+            params.add(addVariableLayout(entryPoint->getParameterByIndex(i)));
+        entry.params = addIndices(params);
+
+        entry.resultVarLayout = addVariableLayout(entryPoint->getResultVarLayout());
+        entry.varLayout = addVariableLayout(entryPoint->getVarLayout());
+
+        m_entryPoints.add(entry);
+    }
+
+    template<typename T>
+    void writeSection(
+        ReflectionBinary::SectionKind kind,
+        const List<T>& items,
+        ReflectionBinary::Header& header,
+        List<uint8_t>& out)
+    {
+        // Keep every section 4 byte aligned
+        while (out.getCount() & 3)
+            out.add(0);
+
+        auto& section = header.sections[uint32_t(kind)];
+        section.offset = uint32_t(out.getCount());
+        section.count = uint32_t(items.getCount());
+        out.addRange((const uint8_t*)items.getBuffer(), items.getCount() * sizeof(T));
+    }
+
+    void write(slang::ShaderReflection* reflection, List<uint8_t>& out)
+    {
+        ReflectionBinary::Header header = {};
+        header.magic = ReflectionBinary::kMagic;
+        header.version = ReflectionBinary::kVersion;
+
+        List<Index> globalParams;
+        const auto paramCount = reflection->getParameterCount();
+        for (unsigned int i = 0; i < paramCount; ++i)
+            globalParams.add(addVariableLayout(reflection->getParameterByIndex(i)));
+        header.globalParams = addIndices(globalParams);
+        header.globalParamsVarLayout = addVariableLayout(reflection->getGlobalParamsVarLayout());
+
+        const auto entryPointCount = reflection->getEntryPointCount();
+        for (SlangUInt i = 0; i < entryPointCount; ++i)
+            addEntryPoint(reflection->getEntryPointByIndex(i));
+
+        out.setCount(sizeof(header));
+        writeSection(ReflectionBinary::SectionKind::Strings, m_strings, header, out);
+        writeSection(ReflectionBinary::SectionKind::Types, m_types, header, out);
+        writeSection(ReflectionBinary::SectionKind::TypeLayouts, m_typeLayouts, header, out);
+        writeSection(ReflectionBinary::SectionKind::Variables, m_variables, header, out);
+        writeSection(
+            ReflectionBinary::SectionKind::VariableLayouts,
+            m_variableLayouts,
+            header,
+            out);
+        writeSection(ReflectionBinary::SectionKind::EntryPoints, m_entryPoints, header, out);
+        writeSection(ReflectionBinary::SectionKind::Bindings, m_bindings, header, out);
+        writeSection(ReflectionBinary::SectionKind::CategorySizes, m_categorySizes, header, out);
+        writeSection(ReflectionBinary::SectionKind::Indices, m_indices, header, out);
+
+        header.totalSize = uint32_t(out.getCount());
+        ::memcpy(out.getBuffer(), &header, sizeof(header));
+    }
+
+    List<char> m_strings;
+    Dictionary<String, ReflectionBinary::StringOffset> m_stringMap;
+
+    List<ReflectionBinary::Type> m_types;
+    Dictionary<slang::TypeReflection*, Index> m_typeMap;
+
+    List<ReflectionBinary::Variable> m_variables;
+    Dictionary<slang::VariableReflection*, Index> m_variableMap;
+
+    List<ReflectionBinary::TypeLayout> m_typeLayouts;
+    Dictionary<slang::TypeLayoutReflection*, Index> m_typeLayoutMap;
+
+    List<ReflectionBinary::VariableLayout> m_variableLayouts;
+    Dictionary<slang::VariableLayoutReflection*, Index> m_variableLayoutMap;
+
+    List<ReflectionBinary::EntryPoint> m_entryPoints;
+    List<ReflectionBinary::Binding> m_bindings;
+    List<ReflectionBinary::CategorySize> m_categorySizes;
+    List<Index> m_indices;
+};
+
+} // namespace
+
+SlangResult writeReflectionBinary(slang::ShaderReflection* reflection, ComPtr<ISlangBlob>& outBlob)
+{
+    if (!reflection)
+        return SLANG_E_INVALID_ARG;
+
+    ReflectionBinaryWriter writer;
+    List<uint8_t> data;
+    writer.write(reflection, data);
+
+    outBlob = ListBlob::moveCreate(data);
+    return SLANG_OK;
+}
+
+} // namespace Slang
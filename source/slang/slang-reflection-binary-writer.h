@@ -0,0 +1,18 @@
+#ifndef SLANG_REFLECTION_BINARY_WRITER_H
+#define SLANG_REFLECTION_BINARY_WRITER_H
+
+#include "../core/slang-basic.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+
+namespace Slang
+{
+
+/// Write the reflection for `reflection` in the binary format described in the public
+/// `slang-reflection-binary.h` header. Types, type layouts and variables are interned,
+/// so that each is written once however many times it is referenced.
+SlangResult writeReflectionBinary(slang::ShaderReflection* reflection, ComPtr<ISlangBlob>& outBlob);
+
+} // namespace Slang
+
+#endif
@@ -593,7 +593,8 @@ SlangResult decodeModuleIR(
     RefPtr<IRModule>& outIRModule,
     IRModuleChunk const* chunk,
     Session* session,
-    SerialSourceLocReader* sourceLocReader)
+    SerialSourceLocReader* sourceLocReader,
+    MemoryAccounting* accounting)
 {
     // IR serialization still uses the older approach, where
     // data gets deserialized from the RIFF into an intermediate
@@ -615,7 +616,8 @@ SlangResult decodeModuleIR(
     // information from the provided `sourceLocReader`.
     //
     IRSerialReader reader;
-    SLANG_RETURN_ON_FAIL(reader.read(serialData, session, sourceLocReader, outIRModule));
+    SLANG_RETURN_ON_FAIL(
+        reader.read(serialData, session, sourceLocReader, outIRModule, accounting));
 
     return SLANG_OK;
 }
@@ -123,11 +123,14 @@ SlangResult readSourceLocationsFromDebugChunk(
     SourceManager* sourceManager,
     RefPtr<SerialSourceLocReader>& outReader);
 
+/// Decode the IR module in chunk. If accounting is set, the memory of the module's instructions is
+/// allocated through it.
 SlangResult decodeModuleIR(
     RefPtr<IRModule>& outIRModule,
     IRModuleChunk const* chunk,
     Session* session,
-    SerialSourceLocReader* sourceLocReader);
+    SerialSourceLocReader* sourceLocReader,
+    MemoryAccounting* accounting = nullptr);
 
 } // namespace Slang
 
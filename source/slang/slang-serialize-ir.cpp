@@ -482,14 +482,15 @@ Result IRSerialReader::read(
     const IRSerialData& data,
     Session* session,
     SerialSourceLocReader* sourceLocReader,
-    RefPtr<IRModule>& outModule)
+    RefPtr<IRModule>& outModule,
+    MemoryAccounting* accounting)
 {
     // Only used in debug builds
     [[maybe_unused]] typedef Ser::Inst::PayloadType PayloadType;
 
     m_serialData = &data;
 
-    auto module = IRModule::create(session);
+    auto module = IRModule::create(session, accounting);
     outModule = module;
     m_module = module;
 
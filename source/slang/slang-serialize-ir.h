@@ -98,12 +98,14 @@ struct IRSerialReader
     /// Read a stream to fill in dataOut IRSerialData
     static Result readFrom(IRModuleChunk const* irModuleChunk, IRSerialData* outData);
 
-    /// Read a module from serial data
+    /// Read a module from serial data. If accounting is set, the memory of the module's
+    /// instructions is allocated through it.
     Result read(
         const IRSerialData& data,
         Session* session,
         SerialSourceLocReader* sourceLocReader,
-        RefPtr<IRModule>& outModule);
+        RefPtr<IRModule>& outModule,
+        MemoryAccounting* accounting = nullptr);
 
     IRSerialReader()
         : m_serialData(nullptr), m_module(nullptr), m_stringTable(StringSlicePool::Style::Default)
@@ -134,6 +134,12 @@ StringBuilder& operator<<(StringBuilder& sb, VMOp op)
     case VMOp::Or:
         sb << "or";
         break;
+    case VMOp::BitAnd:
+        sb << "bitand";
+        break;
+    case VMOp::BitOr:
+        sb << "bitor";
+        break;
     case VMOp::BitXor:
         sb << "bitxor";
         break;
@@ -104,6 +104,7 @@ enum class VMOp : uint32_t
     CallExt,
     Call,
     Print,
+    CountOf,
 };
 
 // Represents an operand in the VM bytecode.
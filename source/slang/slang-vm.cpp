@@ -1,6 +1,8 @@
 #include "slang-vm.h"
 
 #include "core/slang-blob.h"
+#include "core/slang-process.h"
+#include "core/slang-string-escape-util.h"
 #include "slang-vm-inst-impl.h"
 
 namespace Slang
@@ -88,6 +90,11 @@ SlangResult ByteCodeInterpreter::prepareModuleForExecution()
         }
     }
 
+    if (m_profilingEnabled)
+    {
+        m_profile.init(m_moduleView, m_functions);
+    }
+
     return SLANG_OK;
 }
 
@@ -149,6 +156,7 @@ ByteCodeInterpreter::selectFunctionByIndex(uint32_t functionIndex)
         return SLANG_FAIL;
     }
     auto func = m_moduleView.getFunction(functionIndex);
+    m_currentFunctionIndex = functionIndex;
     m_currentFuncCode = m_functions[functionIndex].m_codeBuffer.getBuffer();
     m_currentInst = reinterpret_cast<VMExecInstHeader*>(m_currentFuncCode);
     m_workingSetBuffer.setCount(func.header->workingSetSizeInBytes / sizeof(uint64_t));
@@ -181,6 +189,11 @@ ByteCodeInterpreter::execute(void* argumentData, size_t argumentSize)
         memcpy(m_currentWorkingSet, argumentData, argumentSize);
     }
     m_returnValSize = 0;
+    if (m_profilingEnabled)
+    {
+        executeWithProfiling();
+        return SLANG_OK;
+    }
     while (m_currentInst)
     {
         auto nextInst = m_currentInst->getNextInst();
@@ -191,6 +204,234 @@ ByteCodeInterpreter::execute(void* argumentData, size_t argumentSize)
     return SLANG_OK;
 }
 
+void ByteCodeInterpreter::executeWithProfiling()
+{
+    auto& profile = m_profile;
+
+    uint32_t functionIndex = m_currentFunctionIndex;
+    Index depth = m_stack.getCount();
+
+    profile.functions[functionIndex].callCount++;
+    profile.currentStack.clear();
+    profile.currentStack.add(profile.getStackNode(-1, functionIndex));
+
+    while (m_currentInst)
+    {
+        auto& function = profile.functions[functionIndex];
+        auto currentInst = m_currentInst;
+        const auto offset = (uint8_t*)currentInst - (uint8_t*)m_currentFuncCode;
+        const auto instIndex = function.instIndexByWord[offset / sizeof(uint64_t)];
+
+        m_currentInst = currentInst->getNextInst();
+        const uint64_t startTick = Process::getClockTick();
+        currentInst->functionPtr(this, currentInst, m_extInstHandlerUserData);
+        const uint64_t ticks = Process::getClockTick() - startTick;
+
+        // Ticks of a call instruction only cover setting up the call, the callee's
+        // instructions are counted on their own.
+        function.insts[instIndex].add(ticks);
+        function.total.add(ticks);
+        profile.opcodes[Index(function.instOpcodes[instIndex])].add(ticks);
+        profile.stackNodes[profile.currentStack.getLast()].self.add(ticks);
+
+        // A call or return changes the function being executed
+        if (m_stack.getCount() > depth)
+        {
+            functionIndex = profile.functionIndexByCode[m_currentFuncCode];
+            profile.functions[functionIndex].callCount++;
+            profile.currentStack.add(
+                profile.getStackNode(profile.currentStack.getLast(), functionIndex));
+        }
+        else if (m_stack.getCount() < depth)
+        {
+            profile.currentStack.removeLast();
+            functionIndex = profile.stackNodes[profile.currentStack.getLast()].functionIndex;
+        }
+        depth = m_stack.getCount();
+    }
+}
+
+SLANG_NO_THROW SlangResult SLANG_MCALL
+ByteCodeInterpreter::getProfile(ByteCodeProfileFormat format, slang::IBlob** outBlob)
+{
+    if (!m_profilingEnabled)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    StringBuilder sb;
+    switch (format)
+    {
+    case ByteCodeProfileFormat::JSON:
+        m_profile.writeJSON(m_moduleView, sb);
+        break;
+    case ByteCodeProfileFormat::CollapsedStacks:
+        m_profile.writeCollapsedStacks(m_moduleView, sb);
+        break;
+    default:
+        return SLANG_E_INVALID_ARG;
+    }
+    *outBlob = StringBlob::moveCreate(sb.produceString()).detach();
+    return SLANG_OK;
+}
+
+SLANG_NO_THROW void SLANG_MCALL ByteCodeInterpreter::resetProfile()
+{
+    m_profile.reset();
+}
+
+void ByteCodeProfile::init(VMModuleView& moduleView, List<ExecutableFunction>& executableFunctions)
+{
+    functions.clear();
+    functionIndexByCode.clear();
+    functions.setCount(executableFunctions.getCount());
+
+    for (Index i = 0; i < executableFunctions.getCount(); i++)
+    {
+        auto& executableFunction = executableFunctions[i];
+        auto& function = functions[i];
+        auto code = (uint8_t*)executableFunction.m_codeBuffer.getBuffer();
+        auto originalCode = moduleView.getFunction(i).functionCode;
+
+        functionIndexByCode[code] = uint32_t(i);
+        function.instIndexByWord.setCount(executableFunction.m_codeBuffer.getCount());
+
+        for (auto inst : executableFunction)
+        {
+            const auto offset = uint32_t((uint8_t*)inst - code);
+            const auto originalInst = reinterpret_cast<VMInstHeader*>(originalCode + offset);
+
+            function.instIndexByWord[offset / sizeof(uint64_t)] =
+                uint32_t(function.instOffsets.getCount());
+            function.instOffsets.add(offset);
+            function.instOpcodes.add(originalInst->opcode);
+        }
+        function.insts.setCount(function.instOffsets.getCount());
+    }
+
+    reset();
+}
+
+void ByteCodeProfile::reset()
+{
+    for (auto& counter : opcodes)
+    {
+        counter = Counter();
+    }
+    for (auto& function : functions)
+    {
+        function.callCount = 0;
+        function.total = Counter();
+        for (auto& counter : function.insts)
+        {
+            counter = Counter();
+        }
+    }
+    stackNodes.clear();
+    stackNodeByParentAndFunction.clear();
+    currentStack.clear();
+}
+
+Index ByteCodeProfile::getStackNode(Index parent, uint32_t functionIndex)
+{
+    const uint64_t key = (uint64_t(parent + 1) << 32) | functionIndex;
+    if (auto node = stackNodeByParentAndFunction.tryGetValue(key))
+    {
+        return *node;
+    }
+
+    StackNode node;
+    node.parent = parent;
+    node.functionIndex = functionIndex;
+    const Index nodeIndex = stackNodes.getCount();
+    stackNodes.add(node);
+    stackNodeByParentAndFunction[key] = nodeIndex;
+    return nodeIndex;
+}
+
+static void _appendCounter(StringBuilder& out, ByteCodeProfile::Counter const& counter)
+{
+    out << "\"executionCount\": " << counter.executionCount << ", \"ticks\": " << counter.ticks;
+}
+
+void ByteCodeProfile::writeJSON(VMModuleView& moduleView, StringBuilder& out)
+{
+    auto handler = StringEscapeUtil::getHandler(StringEscapeUtil::Style::JSON);
+
+    out << "{\n";
+    out << "  \"clockFrequency\": " << Process::getClockFrequency() << ",\n";
+
+    // Only opcodes that were executed are listed
+    out << "  \"opcodes\": [";
+    bool isFirst = true;
+    for (Index i = 0; i < Index(VMOp::CountOf); i++)
+    {
+        if (opcodes[i].executionCount == 0)
+            continue;
+
+        StringBuilder name;
+        name << VMOp(i);
+        out << (isFirst ? "\n" : ",\n") << "    {\"opcode\": \"" << name << "\", ";
+        _appendCounter(out, opcodes[i]);
+        out << "}";
+        isFirst = false;
+    }
+    out << "\n  ],\n";
+
+    out << "  \"functions\": [";
+    for (Index i = 0; i < functions.getCount(); i++)
+    {
+        auto& function = functions[i];
+
+        out << (i == 0 ? "\n" : ",\n") << "    {\"name\": ";
+        StringEscapeUtil::appendQuoted(
+            handler,
+            UnownedStringSlice(moduleView.getFunction(i).name),
+            out);
+        out << ", \"callCount\": " << function.callCount << ", ";
+        _appendCounter(out, function.total);
+        out << ",\n      \"instructions\": [";
+
+        // Instructions are identified by their byte offset from the start of the function
+        for (Index j = 0; j < function.insts.getCount(); j++)
+        {
+            StringBuilder name;
+            name << function.instOpcodes[j];
+            out << (j == 0 ? "\n" : ",\n") << "        {\"offset\": " << function.instOffsets[j]
+                << ", \"opcode\": \"" << name << "\", ";
+            _appendCounter(out, function.insts[j]);
+            out << "}";
+        }
+        out << "\n      ]}";
+    }
+    out << "\n  ]\n";
+    out << "}\n";
+}
+
+void ByteCodeProfile::writeCollapsedStacks(VMModuleView& moduleView, StringBuilder& out)
+{
+    List<uint32_t> path;
+    for (auto& node : stackNodes)
+    {
+        if (node.self.executionCount == 0)
+            continue;
+
+        path.clear();
+        for (Index n = Index(&node - stackNodes.getBuffer()); n >= 0; n = stackNodes[n].parent)
+        {
+            path.add(stackNodes[n].functionIndex);
+        }
+
+        // Outermost function first
+        for (Index i = path.getCount() - 1; i >= 0; i--)
+        {
+            out << moduleView.getFunction(path[i]).name;
+            out << (i == 0 ? " " : ";");
+        }
+        out << node.self.ticks << "\n";
+    }
+}
+
 ByteCodeInterpreter::ByteCodeInterpreter()
 {
     m_printCallback = defaultPrintCallback;
@@ -233,8 +474,15 @@ SLANG_EXTERN_C SLANG_API SlangResult slang_createByteCodeRunner(
     const slang::ByteCodeRunnerDesc* desc,
     slang::IByteCodeRunner** outByteCodeRunner)
 {
-    SLANG_UNUSED(desc);
     Slang::RefPtr<Slang::ByteCodeInterpreter> runner = new Slang::ByteCodeInterpreter();
+
+    // `enableProfiling` was added after `structSize`, so check the caller's desc has it
+    if (desc && desc->structSize >= offsetof(slang::ByteCodeRunnerDesc, enableProfiling) +
+                                        sizeof(desc->enableProfiling))
+    {
+        runner->m_profilingEnabled = desc->enableProfiling;
+    }
+
     *outByteCodeRunner = static_cast<slang::IByteCodeRunner*>(runner.detach());
     return SLANG_OK;
 }
@@ -32,6 +32,64 @@ public:
     InstIterator end();
 };
 
+// Execution counters collected by a `ByteCodeInterpreter` that has profiling enabled.
+struct ByteCodeProfile
+{
+    struct Counter
+    {
+        uint64_t executionCount = 0;
+        uint64_t ticks = 0;
+
+        void add(uint64_t inTicks)
+        {
+            executionCount++;
+            ticks += inTicks;
+        }
+    };
+
+    struct Function
+    {
+        uint64_t callCount = 0;
+        Counter total;
+
+        // Counters, opcodes and code offsets of the instructions, in code order
+        List<Counter> insts;
+        List<VMOp> instOpcodes;
+        List<uint32_t> instOffsets;
+
+        // Index of the instruction at each 8 byte word of the code
+        List<uint32_t> instIndexByWord;
+    };
+
+    // A node in the tree of call stacks seen during execution
+    struct StackNode
+    {
+        Index parent;
+        uint32_t functionIndex;
+
+        // Instructions executed by the function itself at this stack
+        Counter self;
+    };
+
+    Counter opcodes[Index(VMOp::CountOf)];
+    List<Function> functions;
+    Dictionary<void*, uint32_t> functionIndexByCode;
+
+    List<StackNode> stackNodes;
+    Dictionary<uint64_t, Index> stackNodeByParentAndFunction;
+
+    // Stack nodes of the functions being executed, innermost last
+    List<Index> currentStack;
+
+    void init(VMModuleView& moduleView, List<ExecutableFunction>& executableFunctions);
+    void reset();
+
+    Index getStackNode(Index parent, uint32_t functionIndex);
+
+    void writeJSON(VMModuleView& moduleView, StringBuilder& out);
+    void writeCollapsedStacks(VMModuleView& moduleView, StringBuilder& out);
+};
+
 struct StackFrame
 {
     VMExecInstHeader* m_currentInst = nullptr;
@@ -90,6 +148,12 @@ public:
     VMPrintFunc m_printCallback = nullptr;
     void* m_printCallbackUserData = nullptr;
 
+    bool m_profilingEnabled = false;
+    ByteCodeProfile m_profile;
+    uint32_t m_currentFunctionIndex = 0;
+
+    void executeWithProfiling();
+
     template<typename... Args>
     void reportError(const char* format, Args... args)
     {
@@ -133,6 +197,10 @@ public:
 
     virtual SLANG_NO_THROW SlangResult SLANG_MCALL
     setPrintCallback(VMPrintFunc callback, void* userData) override;
+
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL
+    getProfile(ByteCodeProfileFormat format, IBlob** outBlob) override;
+    virtual SLANG_NO_THROW void SLANG_MCALL resetProfile() override;
 };
 
 } // namespace Slang
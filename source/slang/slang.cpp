@@ -24,6 +24,7 @@
 #include "slang-check.h"
 #include "slang-doc-ast.h"
 #include "slang-doc-markdown-writer.h"
+#include "slang-import-prefetch.h"
 #include "slang-lookup.h"
 #include "slang-lower-to-ir.h"
 #include "slang-mangle.h"
@@ -32,6 +33,7 @@
 #include "slang-parameter-binding.h"
 #include "slang-parser.h"
 #include "slang-preprocessor.h"
+#include "slang-reflection-binary-writer.h"
 #include "slang-reflection-json.h"
 #include "slang-repro.h"
 #include "slang-serialize-ast.h"
@@ -409,6 +411,35 @@ TypeCheckingCache* Session::getTypeCheckingCache()
     return static_cast<TypeCheckingCache*>(m_typeCheckingCache.get());
 }
 
+SlangResult Session::freeze()
+{
+    if (m_isFrozen)
+    {
+        return SLANG_OK;
+    }
+
+    // There is nothing worth sharing without the core module, and the lazily created types
+    // depend on it.
+    if (coreModules.getCount() == 0)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    SLANG_AST_BUILDER_RAII(m_builtinLinkage->getASTBuilder());
+
+    // Do the initialization that would otherwise happen during the first compiles now, so it
+    // happens once, and before the state is shared.
+    m_sharedASTBuilder->createLazyTypes();
+    getSPIRVCoreGrammarInfo();
+
+    // Names created from now on are kept apart from the builtin names, so the builtin names
+    // are never written to again.
+    rootNamePool.freeze();
+
+    m_isFrozen = true;
+    return SLANG_OK;
+}
+
 Session::BuiltinModuleInfo Session::getBuiltinModuleInfo(slang::BuiltinModuleName name)
 {
     Session::BuiltinModuleInfo result;
@@ -451,6 +482,12 @@ SlangResult Session::compileBuiltinModule(
         fprintf(stderr, "Compiling core module on debug build, this can take a while.\n");
     }
 #endif
+    // The builtin linkage can't be changed once frozen
+    if (m_isFrozen)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
     BuiltinModuleInfo builtinModuleInfo = getBuiltinModuleInfo(moduleName);
     auto moduleNameObj = m_builtinLinkage->getNamePool()->getName(builtinModuleInfo.name);
     if (m_builtinLinkage->mapNameToLoadedModules.tryGetValue(moduleNameObj))
@@ -531,6 +568,12 @@ SlangResult Session::loadBuiltinModule(
     SLANG_PROFILE;
 
 
+    // The builtin linkage can't be changed once frozen
+    if (m_isFrozen)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
     SLANG_AST_BUILDER_RAII(m_builtinLinkage->getASTBuilder());
 
     BuiltinModuleInfo builtinModuleInfo = getBuiltinModuleInfo(moduleName);
@@ -868,7 +911,12 @@ Session::createSession(slang::SessionDesc const& inDesc, slang::ISession** outSe
     RefPtr<ASTBuilder> astBuilder(new ASTBuilder(m_sharedASTBuilder, "Session::astBuilder"));
     slang::SessionDesc desc = makeFromSizeVersioned<slang::SessionDesc>((uint8_t*)&inDesc);
 
-    RefPtr<Linkage> linkage = new Linkage(this, astBuilder, getBuiltinLinkage());
+    RefPtr<MemoryAllocator> memoryAllocator;
+    if (desc.allocator)
+        memoryAllocator = new ComMemoryAllocator(desc.allocator);
+
+    RefPtr<Linkage> linkage =
+        new Linkage(this, astBuilder, getBuiltinLinkage(), memoryAllocator);
 
     if (desc.skipSPIRVValidation)
     {
@@ -909,6 +957,11 @@ Session::createSession(slang::SessionDesc const& inDesc, slang::ISession** outSe
 
     linkage->m_optionSet.load(desc.compilerOptionEntryCount, desc.compilerOptionEntries);
 
+    if (linkage->m_optionSet.getBoolOption(CompilerOptionName::EnableConcurrentSessionAccess))
+    {
+        linkage->m_sessionAccessMutex = std::make_shared<std::recursive_mutex>();
+    }
+
     if (!linkage->m_optionSet.hasOption(CompilerOptionName::MatrixLayoutColumn) &&
         !linkage->m_optionSet.hasOption(CompilerOptionName::MatrixLayoutRow))
         linkage->setMatrixLayoutMode(desc.defaultMatrixLayoutMode);
@@ -1363,7 +1416,11 @@ Profile getEffectiveProfile(EntryPoint* entryPoint, TargetRequest* target)
 
 //
 
-Linkage::Linkage(Session* session, ASTBuilder* astBuilder, Linkage* builtinLinkage)
+Linkage::Linkage(
+    Session* session,
+    ASTBuilder* astBuilder,
+    Linkage* builtinLinkage,
+    MemoryAllocator* memoryAllocator)
     : m_session(session)
     , m_retainedSession(session)
     , m_sourceManager(&m_defaultSourceManager)
@@ -1384,6 +1441,80 @@ Linkage::Linkage(Session* session, ASTBuilder* astBuilder, Linkage* builtinLinka
     }
 
     m_semanticsForReflection = new SharedSemanticsContext(this, nullptr, nullptr);
+
+    // The built in linkage uses the session's shared AST builder, which isn't counted
+    m_memoryAccounting.reset(
+        new MemoryAccounting(memoryAllocator ? memoryAllocator : session->getMemoryAllocator()));
+    if (builtinLinkage)
+    {
+        astBuilder->getMemoryArena().setAccounting(
+            m_memoryAccounting.get(),
+            MemoryAccounting::Category::ASTArena);
+    }
+}
+
+Linkage::MemoryLimitScope::MemoryLimitScope(Linkage* linkage)
+    : m_linkage(linkage)
+{
+    if (linkage->m_memoryLimitScopeDepth++ == 0)
+    {
+        linkage->m_memoryAtCompileStart = linkage->m_memoryAccounting->getSnapshot();
+    }
+}
+
+Linkage::MemoryLimitScope::~MemoryLimitScope()
+{
+    m_linkage->m_memoryLimitScopeDepth--;
+}
+
+Linkage::ImportPrefetchScope::ImportPrefetchScope(Linkage* linkage)
+    : m_linkage(linkage)
+{
+    linkage->m_importPrefetchScopeDepth++;
+}
+
+Linkage::ImportPrefetchScope::~ImportPrefetchScope()
+{
+    if (--m_linkage->m_importPrefetchScopeDepth == 0)
+    {
+        m_linkage->m_importPrefetcher.setNull();
+    }
+}
+
+void Linkage::checkMemoryLimit(DiagnosticSink* sink)
+{
+    const Int limitInMegabytes = m_optionSet.getIntOption(CompilerOptionName::MemoryLimit);
+    if (limitInMegabytes <= 0 || m_memoryLimitScopeDepth == 0)
+    {
+        return;
+    }
+
+    // Only the memory taken since the compile started counts, so that what earlier compiles
+    // with the linkage left loaded doesn't count against later ones. Container memory is that
+    // taken on this thread, which a compile runs on.
+    const size_t megabyte = 1024 * 1024;
+    const auto& atStart = m_memoryAtCompileStart;
+    const size_t containersUsed = MemoryAccounting::getContainersUsedSince(atStart);
+    if (m_memoryAccounting->getTotalUsedSince(atStart) + containersUsed <=
+        size_t(limitInMegabytes) * megabyte)
+    {
+        return;
+    }
+
+    auto toMegabytes = [&](size_t sizeInBytes)
+    { return uint64_t((sizeInBytes + megabyte - 1) / megabyte); };
+    auto getUsedInMegabytes = [&](MemoryAccounting::Category category)
+    { return toMegabytes(m_memoryAccounting->getUsedSince(atStart, category)); };
+
+    // Fatal, so this will abort the compilation
+    sink->diagnose(
+        SourceLoc(),
+        Diagnostics::memoryLimitExceeded,
+        uint64_t(limitInMegabytes),
+        getUsedInMegabytes(MemoryAccounting::Category::ASTArena),
+        getUsedInMegabytes(MemoryAccounting::Category::IRArena),
+        toMegabytes(containersUsed),
+        getUsedInMegabytes(MemoryAccounting::Category::Other));
 }
 
 SharedSemanticsContext* Linkage::getSemanticsForReflection()
@@ -1401,14 +1532,15 @@ ISlangUnknown* Linkage::getInterface(const Guid& guid)
 
 Linkage::~Linkage()
 {
-    // Upstream type checking cache.
+    // Upstream type checking cache. A frozen global session keeps the cache it was frozen with.
     if (m_typeCheckingCache)
     {
         auto globalSession = getSessionImpl();
         std::lock_guard<std::mutex> lock(globalSession->m_typeCheckingCacheMutex);
-        if (!globalSession->m_typeCheckingCache ||
-            globalSession->getTypeCheckingCache()->resolvedOperatorOverloadCache.getCount() <
-                getTypeCheckingCache()->resolvedOperatorOverloadCache.getCount())
+        if (!globalSession->isFrozen() &&
+            (!globalSession->m_typeCheckingCache ||
+             globalSession->getTypeCheckingCache()->resolvedOperatorOverloadCache.getCount() <
+                 getTypeCheckingCache()->resolvedOperatorOverloadCache.getCount()))
         {
             globalSession->m_typeCheckingCache = m_typeCheckingCache;
             getTypeCheckingCache()->version++;
@@ -1510,6 +1642,7 @@ static void outputExceptionDiagnostic(DiagnosticSink& sink, slang::IBlob** outDi
 SLANG_NO_THROW slang::IModule* SLANG_MCALL
 Linkage::loadModule(const char* moduleName, slang::IBlob** outDiagnostics)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     SLANG_AST_BUILDER_RAII(getASTBuilder());
 
     DiagnosticSink sink(getSourceManager(), Lexer::sourceLocationLexer);
@@ -1626,6 +1759,7 @@ SLANG_NO_THROW slang::IModule* SLANG_MCALL Linkage::loadModuleFromSource(
     slang::IBlob* source,
     slang::IBlob** outDiagnostics)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     return loadModuleFromBlob(moduleName, path, source, ModuleBlobType::Source, outDiagnostics);
 }
 
@@ -1635,6 +1769,7 @@ SLANG_NO_THROW slang::IModule* SLANG_MCALL Linkage::loadModuleFromSourceString(
     const char* source,
     slang::IBlob** outDiagnostics)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     auto sourceBlob = StringBlob::create(UnownedStringSlice(source));
     return loadModuleFromSource(moduleName, path, sourceBlob.get(), outDiagnostics);
 }
@@ -1645,6 +1780,7 @@ SLANG_NO_THROW slang::IModule* SLANG_MCALL Linkage::loadModuleFromIRBlob(
     slang::IBlob* source,
     slang::IBlob** outDiagnostics)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     return loadModuleFromBlob(moduleName, path, source, ModuleBlobType::IR, outDiagnostics);
 }
 
@@ -1654,6 +1790,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Linkage::createCompositeComponentType(
     slang::IComponentType** outCompositeComponentType,
     ISlangBlob** outDiagnostics)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     if (outCompositeComponentType == nullptr)
         return SLANG_E_INVALID_ARG;
 
@@ -1693,6 +1830,7 @@ SLANG_NO_THROW slang::TypeReflection* SLANG_MCALL Linkage::specializeType(
     SlangInt specializationArgCount,
     ISlangBlob** outDiagnostics)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     SLANG_AST_BUILDER_RAII(getASTBuilder());
 
     auto unspecializedType = asInternal(inUnspecializedType);
@@ -1874,6 +2012,7 @@ SLANG_NO_THROW slang::TypeLayoutReflection* SLANG_MCALL Linkage::getTypeLayout(
     slang::LayoutRules rules,
     ISlangBlob** outDiagnostics)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     SLANG_AST_BUILDER_RAII(getASTBuilder());
 
     auto type = asInternal(inType);
@@ -1906,6 +2045,7 @@ SLANG_NO_THROW slang::TypeReflection* SLANG_MCALL Linkage::getContainerType(
     slang::ContainerType containerType,
     ISlangBlob** outDiagnostics)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     SLANG_AST_BUILDER_RAII(getASTBuilder());
 
     auto type = asInternal(inType);
@@ -1957,6 +2097,7 @@ SLANG_NO_THROW slang::TypeReflection* SLANG_MCALL Linkage::getContainerType(
 
 SLANG_NO_THROW slang::TypeReflection* SLANG_MCALL Linkage::getDynamicType()
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     SLANG_AST_BUILDER_RAII(getASTBuilder());
 
     return asExternal(getASTBuilder()->getSharedASTBuilder()->getDynamicType());
@@ -1965,6 +2106,7 @@ SLANG_NO_THROW slang::TypeReflection* SLANG_MCALL Linkage::getDynamicType()
 SLANG_NO_THROW SlangResult SLANG_MCALL
 Linkage::getTypeRTTIMangledName(slang::TypeReflection* type, ISlangBlob** outNameBlob)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     SLANG_AST_BUILDER_RAII(getASTBuilder());
 
     auto internalType = asInternal(type);
@@ -1983,6 +2125,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Linkage::getTypeConformanceWitnessMangled
     slang::TypeReflection* interfaceType,
     ISlangBlob** outNameBlob)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     SLANG_AST_BUILDER_RAII(getASTBuilder());
 
     auto subType = asInternal(type);
@@ -1998,6 +2141,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Linkage::getTypeConformanceWitnessSequent
     slang::TypeReflection* interfaceType,
     uint32_t* outId)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     SLANG_AST_BUILDER_RAII(getASTBuilder());
 
     auto subType = asInternal(type);
@@ -2035,6 +2179,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Linkage::getDynamicObjectRTTIBytes(
     uint32_t* outBuffer,
     uint32_t bufferSize)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     // Slang RTTI header format:
     // byte 0-7: pointer to RTTI struct describing the type. (not used for now, set to 1 for valid
     // types, and 0 to represent null).
@@ -2061,6 +2206,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Linkage::createTypeConformanceComponentTy
     SlangInt conformanceIdOverride,
     ISlangBlob** outDiagnostics)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     if (outConformanceComponentType == nullptr)
         return SLANG_E_INVALID_ARG;
 
@@ -2096,6 +2242,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Linkage::createTypeConformanceComponentTy
 SLANG_NO_THROW SlangResult SLANG_MCALL
 Linkage::createCompileRequest(SlangCompileRequest** outCompileRequest)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     auto compileRequest = new EndToEndCompileRequest(this);
     compileRequest->addRef();
     *outCompileRequest = asExternal(compileRequest);
@@ -2104,11 +2251,13 @@ Linkage::createCompileRequest(SlangCompileRequest** outCompileRequest)
 
 SLANG_NO_THROW SlangInt SLANG_MCALL Linkage::getLoadedModuleCount()
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     return loadedModulesList.getCount();
 }
 
 SLANG_NO_THROW slang::IModule* SLANG_MCALL Linkage::getLoadedModule(SlangInt index)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     if (index >= 0 && index < loadedModulesList.getCount())
         return loadedModulesList[index].get();
     return nullptr;
@@ -3571,6 +3720,14 @@ void FrontEndCompileRequest::checkAllTranslationUnits()
     if (additionalLoadedModules)
         loadedModules = *additionalLoadedModules;
 
+    // Start reading the files of all imported modules up front, so that the
+    // reads overlap with checking.
+    for (auto& translationUnit : translationUnits)
+    {
+        if (!translationUnit->isChecked)
+            getLinkage()->prefetchImports(translationUnit->getModule()->getModuleDecl());
+    }
+
     // Iterate over all translation units and
     // apply the semantic checking logic.
     for (auto& translationUnit : translationUnits)
@@ -3579,6 +3736,7 @@ void FrontEndCompileRequest::checkAllTranslationUnits()
             continue;
 
         checkTranslationUnit(translationUnit.Ptr(), loadedModules);
+        getLinkage()->checkMemoryLimit(getSink());
 
         // Add the checked module to list of loadedModules so that they can be
         // discovered by `findOrImportModule` when processing future `import` decls.
@@ -3618,6 +3776,7 @@ void FrontEndCompileRequest::generateIR()
         /// Generate IR for translation unit.
         RefPtr<IRModule> irModule(
             generateIRForTranslationUnit(getLinkage()->getASTBuilder(), translationUnit));
+        getLinkage()->checkMemoryLimit(getSink());
 
         if (verifyDebugSerialization)
         {
@@ -3655,7 +3814,12 @@ void FrontEndCompileRequest::generateIR()
             {
                 // Read IR back from serialData
                 IRSerialReader reader;
-                reader.read(serialData, getSession(), nullptr, irReadModule);
+                reader.read(
+                    serialData,
+                    getSession(),
+                    nullptr,
+                    irReadModule,
+                    getLinkage()->getMemoryAccounting());
             }
 
             // Set irModule to the read module
@@ -3696,6 +3860,8 @@ SlangResult FrontEndCompileRequest::executeActionsInner()
 {
     SLANG_PROFILE_SECTION(frontEndExecute);
     SLANG_AST_BUILDER_RAII(getLinkage()->getASTBuilder());
+    Linkage::MemoryLimitScope memoryLimitScope(getLinkage());
+    Linkage::ImportPrefetchScope importPrefetchScope(getLinkage());
 
     for (TranslationUnitRequest* translationUnit : translationUnits)
     {
@@ -3719,10 +3885,37 @@ SlangResult FrontEndCompileRequest::executeActionsInner()
     if (getSink()->getErrorCount() != 0)
         return SLANG_FAIL;
 
+    // Modules imported with `LazyImportedBodyChecking` are only usable by this
+    // request, so they are taken out of the linkage when it is done, however it ends.
+    //
+    struct ForgetImportsWithUncheckedBodies
+    {
+        Linkage* linkage;
+        ~ForgetImportsWithUncheckedBodies()
+        {
+            linkage->m_checkImportedBodiesOnDemand = false;
+            linkage->forgetImportsWithUncheckedBodies();
+        }
+    } forgetImportsWithUncheckedBodies{getLinkage()};
+
     // Perform semantic checking on the whole collection
     {
         SLANG_PROFILE_SECTION(SemanticChecking);
+
+        // With `LazyImportedBodyChecking`, modules imported along the way only
+        // get the function bodies that the translation units need checked.
+        //
+        auto linkage = getLinkage();
+        const bool checkImportedBodiesOnDemand =
+            optionSet.getBoolOption(CompilerOptionName::LazyImportedBodyChecking) &&
+            !linkage->isInLanguageServer();
+
+        linkage->m_checkImportedBodiesOnDemand = checkImportedBodiesOnDemand;
         checkAllTranslationUnits();
+        linkage->m_checkImportedBodiesOnDemand = false;
+
+        if (checkImportedBodiesOnDemand)
+            linkage->checkImportedFunctionBodiesOnDemand(this);
     }
 
     if (getSink()->getErrorCount() != 0)
@@ -3792,6 +3985,7 @@ EndToEndCompileRequest::EndToEndCompileRequest(Linkage* linkage)
 SLANG_NO_THROW SlangResult SLANG_MCALL
 EndToEndCompileRequest::queryInterface(SlangUUID const& uuid, void** outObject)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     if (uuid == EndToEndCompileRequest::getTypeGuid())
     {
         // Special case to cast directly into internal type
@@ -3828,6 +4022,9 @@ void EndToEndCompileRequest::init()
 SlangResult EndToEndCompileRequest::executeActionsInner()
 {
     SLANG_PROFILE_SECTION(endToEndActions);
+    Linkage::MemoryLimitScope memoryLimitScope(getLinkage());
+    Linkage::ImportPrefetchScope importPrefetchScope(getLinkage());
+
     // If no code-generation target was specified, then try to infer one from the source language,
     // just to make sure we can do something reasonable when invoked from the command line.
     //
@@ -4149,6 +4346,8 @@ void Linkage::loadParsedModule(
     Name* name,
     const PathInfo& pathInfo)
 {
+    MemoryLimitScope memoryLimitScope(this);
+
     // Note: we add the loaded module to our name->module listing
     // before doing semantic checking, so that if it tries to
     // recursively `import` itself, we can detect it.
@@ -4164,6 +4363,9 @@ void Linkage::loadParsedModule(
 
     auto sink = translationUnit->compileRequest->getSink();
 
+    if (m_checkImportedBodiesOnDemand)
+        loadedModule->setCheckBodiesOnDemand(true);
+
     int errorCountBefore = sink->getErrorCount();
     compileRequest->checkAllTranslationUnits();
     int errorCountAfter = sink->getErrorCount();
@@ -4187,7 +4389,15 @@ void Linkage::loadParsedModule(
         {
             // If we didn't run into any errors, then try to generate
             // IR code for the imported module.
-            if (errorCountAfter == 0)
+            //
+            // A module with function bodies left unchecked gets its IR once
+            // we know which of those bodies are used.
+            //
+            if (loadedModule->shouldCheckBodiesOnDemand())
+            {
+                m_importsWithUncheckedBodies.add(compileRequest);
+            }
+            else if (errorCountAfter == 0)
             {
                 loadedModule->setIRModule(
                     generateIRForTranslationUnit(getASTBuilder(), translationUnit));
@@ -4195,6 +4405,64 @@ void Linkage::loadParsedModule(
         }
     }
     loadedModulesList.add(loadedModule);
+
+    checkMemoryLimit(sink);
+}
+
+void Linkage::checkImportedFunctionBodiesOnDemand(FrontEndCompileRequest* compileRequest)
+{
+    if (m_importsWithUncheckedBodies.getCount() == 0)
+        return;
+
+    List<RefPtr<TranslationUnitRequest>> imports;
+    for (auto importRequest : m_importsWithUncheckedBodies)
+        imports.addRange(importRequest->translationUnits);
+
+    auto sink = compileRequest->getSink();
+    checkReachableFunctionBodies(compileRequest->translationUnits, imports);
+
+    // Each module was added to the list after the modules it imports, so
+    // generating IR in list order is fine.
+    //
+    if (sink->getErrorCount() != 0)
+        return;
+    for (auto translationUnit : imports)
+    {
+        translationUnit->getModule()->setIRModule(
+            generateIRForTranslationUnit(getASTBuilder(), translationUnit));
+        checkMemoryLimit(sink);
+    }
+}
+
+void Linkage::forgetImportsWithUncheckedBodies()
+{
+    auto importRequests = _Move(m_importsWithUncheckedBodies);
+    for (auto importRequest : importRequests)
+    {
+        for (auto translationUnit : importRequest->translationUnits)
+        {
+            RefPtr<Module> module = translationUnit->getModule();
+            module->setCheckBodiesOnDemand(false);
+
+            RefPtr<LoadedModule> loadedModule;
+            if (mapNameToLoadedModules.tryGetValue(translationUnit->moduleName, loadedModule) &&
+                loadedModule == module)
+            {
+                mapNameToLoadedModules.remove(translationUnit->moduleName);
+            }
+
+            List<String> paths;
+            for (const auto& [path, pathModule] : mapPathToLoadedModule)
+            {
+                if (pathModule == module)
+                    paths.add(path);
+            }
+            for (const auto& path : paths)
+                mapPathToLoadedModule.remove(path);
+
+            loadedModulesList.remove(module);
+        }
+    }
 }
 
 RefPtr<Module> Linkage::findOrLoadSerializedModuleForModuleLibrary(
@@ -4381,6 +4649,8 @@ RefPtr<Module> Linkage::loadModuleImpl(
     const LoadedModuleDictionary* additionalLoadedModules,
     ModuleBlobType blobType)
 {
+    ImportPrefetchScope importPrefetchScope(this);
+
     switch (blobType)
     {
     case ModuleBlobType::IR:
@@ -4476,6 +4746,9 @@ RefPtr<Module> Linkage::loadSourceModuleImpl(
         return nullptr;
     }
 
+    // Start reading the modules this one imports while it is being checked.
+    prefetchImports(module->getModuleDecl());
+
     try
     {
         loadParsedModule(frontEndReq, translationUnit, name, filePathInfo);
@@ -4521,25 +4794,62 @@ bool Linkage::isBeingImported(Module* module)
 // For example, `foo_bar` becomes `foo-bar.slang`.
 String getFileNameFromModuleName(Name* name, bool translateUnderScore)
 {
-    String fileName;
-    if (!getText(name).getUnownedSlice().endsWithCaseInsensitive(".slang"))
+    return getFileNameFromModuleName(getText(name).getUnownedSlice(), translateUnderScore);
+}
+
+void Linkage::prefetchImports(ModuleDecl* moduleDecl)
+{
+    // The prefetcher uses the file system from other threads, so it is only used when the
+    // linkage reads from the OS file system, rather than one the application provides.
+    // The language server works from in-memory documents, so gains nothing from it.
+    if (!moduleDecl || !m_optionSet.getBoolOption(CompilerOptionName::PrefetchImports) ||
+        m_fileSystem || isInLanguageServer())
+        return;
+
+    for (auto importDecl : moduleDecl->getMembersOfType<ImportDecl>())
     {
-        StringBuilder sb;
-        for (auto c : getText(name))
-        {
-            if (translateUnderScore && c == '_')
-                c = '-';
+        auto moduleName = importDecl->moduleNameAndLoc.name;
+        if (!moduleName || moduleName == getSessionImpl()->glslModuleName ||
+            mapNameToLoadedModules.containsKey(moduleName))
+            continue;
 
-            sb.append(c);
+        if (!m_importPrefetcher)
+        {
+            m_importPrefetcher = new ImportPrefetcher(
+                OSFileSystem::getExtSingleton(),
+                ImportPrefetcher::getDefaultWorkerCount());
         }
-        sb.append(".slang");
-        fileName = sb.produceString();
+
+        // Files are found relative to the importing file, as in `findOrImportModule`
+        PathInfo requestingPathInfo = getSourceManager()->getPathInfo(
+            importDecl->moduleNameAndLoc.loc,
+            SourceLocType::Actual);
+
+        m_importPrefetcher->prefetch(
+            getText(moduleName).getUnownedSlice(),
+            requestingPathInfo.foundPath,
+            getSearchDirectories());
     }
-    else
+}
+
+SlangResult Linkage::_loadImportedModuleFile(
+    IncludeSystem& includeSystem,
+    const PathInfo& pathInfo,
+    ComPtr<ISlangBlob>& outBlob)
+{
+    // If the source manager already has the file, it must be used so that the contents
+    // are consistent with any earlier use of it.
+    auto sourceManager = getSourceManager();
+    if (m_importPrefetcher && !sourceManager->findSourceFileRecursively(pathInfo.uniqueIdentity) &&
+        m_importPrefetcher->takeFile(pathInfo.foundPath, outBlob))
     {
-        fileName = getText(name);
+        // Register the file, as `IncludeSystem::loadFile` would have done
+        auto sourceFile = sourceManager->createSourceFileWithBlob(pathInfo, outBlob);
+        sourceManager->addSourceFile(pathInfo.uniqueIdentity, sourceFile);
+        return SLANG_OK;
     }
-    return fileName;
+
+    return includeSystem.loadFile(pathInfo, outBlob);
 }
 
 RefPtr<Module> Linkage::findOrImportModule(
@@ -4748,7 +5058,7 @@ RefPtr<Module> Linkage::findOrImportModule(
             // using whatever other candidate file names are left.
             //
             ComPtr<ISlangBlob> fileContents;
-            if (SLANG_FAILED(includeSystem.loadFile(filePathInfo, fileContents)))
+            if (SLANG_FAILED(_loadImportedModuleFile(includeSystem, filePathInfo, fileContents)))
             {
                 continue;
             }
@@ -4869,6 +5179,7 @@ bool Linkage::isBinaryModuleUpToDate(String fromPath, RIFF::ListChunk const* bas
 SLANG_NO_THROW bool SLANG_MCALL
 Linkage::isBinaryModuleUpToDate(const char* modulePath, slang::IBlob* binaryModuleBlob)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     auto rootChunk = RIFF::RootChunk::getFromBlob(binaryModuleBlob);
     if (!rootChunk)
         return false;
@@ -5107,6 +5418,7 @@ void Module::buildHash(DigestBuilder<SHA1>& builder)
 
 slang::DeclReflection* Module::getModuleReflection()
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     return (slang::DeclReflection*)m_moduleDecl;
 }
 
@@ -5294,6 +5606,10 @@ NodeBase* Module::findExportFromMangledName(const UnownedStringSlice& slice)
 ComponentType::ComponentType(Linkage* linkage)
     : m_linkage(linkage)
 {
+    if (linkage)
+    {
+        m_sessionAccessMutex = linkage->getSessionAccessMutex();
+    }
 }
 
 ComponentType* asInternal(slang::IComponentType* inComponentType)
@@ -5332,6 +5648,7 @@ SLANG_NO_THROW slang::ISession* SLANG_MCALL ComponentType::getSession()
 SLANG_NO_THROW slang::ProgramLayout* SLANG_MCALL
 ComponentType::getLayout(Int targetIndex, slang::IBlob** outDiagnostics)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     auto linkage = getLinkage();
     if (targetIndex < 0 || targetIndex >= linkage->targets.getCount())
         return nullptr;
@@ -5382,6 +5699,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getResultAsFileSystem(
     Int targetIndex,
     ISlangMutableFileSystem** outFileSystem)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     ComPtr<ISlangBlob> diagnostics;
     ComPtr<ISlangBlob> code;
 
@@ -5457,6 +5775,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getEntryPointCode(
     slang::IBlob** outCode,
     slang::IBlob** outDiagnostics)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     auto linkage = getLinkage();
     if (targetIndex < 0 || targetIndex >= linkage->targets.getCount())
         return SLANG_E_INVALID_ARG;
@@ -5482,6 +5801,7 @@ SLANG_NO_THROW void SLANG_MCALL ComponentType::getEntryPointHash(
     SlangInt targetIndex,
     slang::IBlob** outHash)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     DigestBuilder<SHA1> builder;
 
     // A note on enums that may be hashed in as part of the following two function calls:
@@ -5516,6 +5836,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getEntryPointHostCallable(
     ISlangSharedLibrary** outSharedLibrary,
     slang::IBlob** outDiagnostics)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     auto linkage = getLinkage();
     if (targetIndex < 0 || targetIndex >= linkage->targets.getCount())
         return SLANG_E_INVALID_ARG;
@@ -5541,6 +5862,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getEntryPointMetadata(
     slang::IMetadata** outMetadata,
     slang::IBlob** outDiagnostics)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     auto linkage = getLinkage();
     if (targetIndex < 0 || targetIndex >= linkage->targets.getCount())
         return SLANG_E_INVALID_ARG;
@@ -5597,6 +5919,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::specialize(
     slang::IComponentType** outSpecializedComponentType,
     ISlangBlob** outDiagnostics)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     DiagnosticSink sink(getLinkage()->getSourceManager(), Lexer::sourceLocationLexer);
 
     // First let's check if the number of arguments given matches
@@ -5646,6 +5969,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::specialize(
 SLANG_NO_THROW SlangResult SLANG_MCALL
 ComponentType::renameEntryPoint(const char* newName, IComponentType** outEntryPoint)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     RefPtr<RenamedEntryPointComponentType> result =
         new RenamedEntryPointComponentType(this, newName);
     *outEntryPoint = result.detach();
@@ -5657,6 +5981,7 @@ RefPtr<ComponentType> fillRequirements(ComponentType* inComponentType);
 SLANG_NO_THROW SlangResult SLANG_MCALL
 ComponentType::link(slang::IComponentType** outLinkedComponentType, ISlangBlob** outDiagnostics)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     // TODO: It should be possible for `fillRequirements` to fail,
     // in cases where we have a dependency that can't be automatically
     // resolved.
@@ -5697,6 +6022,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::linkWithOptions(
     slang::CompilerOptionEntry* entries,
     ISlangBlob** outDiagnostics)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     SLANG_RETURN_ON_FAIL(link(outLinkedComponentType, outDiagnostics));
 
     auto linked = *outLinkedComponentType;
@@ -5715,6 +6041,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getEntryPointCompileResult
     slang::ICompileResult** outCompileResult,
     slang::IBlob** outDiagnostics)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     auto linkage = getLinkage();
     if (targetIndex < 0 || targetIndex >= linkage->targets.getCount())
         return SLANG_E_INVALID_ARG;
@@ -5741,6 +6068,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getTargetCompileResult(
     slang::ICompileResult** outCompileResult,
     slang::IBlob** outDiagnostics)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     IArtifact* artifact = getTargetArtifact(targetIndex, outDiagnostics);
     if (artifact == nullptr)
         return SLANG_E_NOT_AVAILABLE;
@@ -5917,6 +6245,7 @@ IArtifact* ComponentType::getTargetArtifact(Int targetIndex, slang::IBlob** outD
 SLANG_NO_THROW SlangResult SLANG_MCALL
 ComponentType::getTargetCode(Int targetIndex, slang::IBlob** outCode, slang::IBlob** outDiagnostics)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     IArtifact* artifact = getTargetArtifact(targetIndex, outDiagnostics);
 
     if (artifact == nullptr)
@@ -5930,6 +6259,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getTargetMetadata(
     slang::IMetadata** outMetadata,
     slang::IBlob** outDiagnostics)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     IArtifact* artifact = getTargetArtifact(targetIndex, outDiagnostics);
 
     if (artifact == nullptr)
@@ -6078,6 +6408,7 @@ ShaderParamInfo CompositeComponentType::getShaderParam(Index index)
 
 Index CompositeComponentType::getSpecializationParamCount()
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     return m_specializationParams.getCount();
 }
 
@@ -6761,7 +7092,8 @@ SlangResult Linkage::loadSerializedModuleContents(
     module->setModuleDecl(moduleDecl);
 
     RefPtr<IRModule> irModule;
-    SLANG_RETURN_ON_FAIL(decodeModuleIR(irModule, irChunk, session, sourceLocReader));
+    SLANG_RETURN_ON_FAIL(
+        decodeModuleIR(irModule, irChunk, session, sourceLocReader, getMemoryAccounting()));
     module->setIRModule(irModule);
 
     // The handling of file dependencies is complicated, because of
@@ -6929,11 +7261,13 @@ namespace Slang
 
 void EndToEndCompileRequest::setFileSystem(ISlangFileSystem* fileSystem)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     getLinkage()->setFileSystem(fileSystem);
 }
 
 void EndToEndCompileRequest::setCompileFlags(SlangCompileFlags flags)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     if (flags & SLANG_COMPILE_FLAG_NO_MANGLING)
         getOptionSet().set(CompilerOptionName::NoMangle, true);
     if (flags & SLANG_COMPILE_FLAG_NO_CODEGEN)
@@ -6944,6 +7278,7 @@ void EndToEndCompileRequest::setCompileFlags(SlangCompileFlags flags)
 
 SlangCompileFlags EndToEndCompileRequest::getCompileFlags()
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     SlangCompileFlags result = 0;
     if (getOptionSet().getBoolOption(CompilerOptionName::NoMangle))
         result |= SLANG_COMPILE_FLAG_NO_MANGLING;
@@ -6956,6 +7291,7 @@ SlangCompileFlags EndToEndCompileRequest::getCompileFlags()
 
 void EndToEndCompileRequest::setDumpIntermediates(int enable)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     getOptionSet().set(CompilerOptionName::DumpIntermediates, enable);
 }
 
@@ -6966,16 +7302,19 @@ void EndToEndCompileRequest::setTrackLiveness(bool v)
 
 void EndToEndCompileRequest::setDumpIntermediatePrefix(const char* prefix)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     getOptionSet().set(CompilerOptionName::DumpIntermediatePrefix, String(prefix));
 }
 
 void EndToEndCompileRequest::setLineDirectiveMode(SlangLineDirectiveMode mode)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     getOptionSet().set(CompilerOptionName::LineDirectiveMode, mode);
 }
 
 void EndToEndCompileRequest::setCommandLineCompilerMode()
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     m_isCommandLineCompile = true;
 
     // legacy slangc tool defaults to column major layout.
@@ -6995,6 +7334,7 @@ void EndToEndCompileRequest::_completeTargetRequest(UInt targetIndex)
 
 void EndToEndCompileRequest::setCodeGenTarget(SlangCompileTarget target)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     auto linkage = getLinkage();
     linkage->targets.clear();
     const auto targetIndex = linkage->addTarget(CodeGenTarget(target));
@@ -7004,6 +7344,7 @@ void EndToEndCompileRequest::setCodeGenTarget(SlangCompileTarget target)
 
 int EndToEndCompileRequest::addCodeGenTarget(SlangCompileTarget target)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     const auto targetIndex = getLinkage()->addTarget(CodeGenTarget(target));
     _completeTargetRequest(targetIndex);
     return int(targetIndex);
@@ -7011,21 +7352,25 @@ int EndToEndCompileRequest::addCodeGenTarget(SlangCompileTarget target)
 
 void EndToEndCompileRequest::setTargetProfile(int targetIndex, SlangProfileID profile)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     getTargetOptionSet(targetIndex).setProfile(Profile(profile));
 }
 
 void EndToEndCompileRequest::setTargetFlags(int targetIndex, SlangTargetFlags flags)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     getTargetOptionSet(targetIndex).setTargetFlags(flags);
 }
 
 void EndToEndCompileRequest::setTargetForceGLSLScalarBufferLayout(int targetIndex, bool value)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     getTargetOptionSet(targetIndex).set(CompilerOptionName::GLSLForceScalarLayout, value);
 }
 
 void EndToEndCompileRequest::setTargetForceDXLayout(int targetIndex, bool value)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     getTargetOptionSet(targetIndex).set(CompilerOptionName::ForceDXLayout, value);
 }
 
@@ -7033,27 +7378,32 @@ void EndToEndCompileRequest::setTargetFloatingPointMode(
     int targetIndex,
     SlangFloatingPointMode mode)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     getTargetOptionSet(targetIndex)
         .set(CompilerOptionName::FloatingPointMode, FloatingPointMode(mode));
 }
 
 void EndToEndCompileRequest::setMatrixLayoutMode(SlangMatrixLayoutMode mode)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     getOptionSet().setMatrixLayoutMode((MatrixLayoutMode)mode);
 }
 
 void EndToEndCompileRequest::setTargetMatrixLayoutMode(int targetIndex, SlangMatrixLayoutMode mode)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     getTargetOptionSet(targetIndex).setMatrixLayoutMode(MatrixLayoutMode(mode));
 }
 
 void EndToEndCompileRequest::setTargetGenerateWholeProgram(int targetIndex, bool value)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     getTargetOptionSet(targetIndex).set(CompilerOptionName::GenerateWholeProgram, value);
 }
 
 void EndToEndCompileRequest::setTargetEmbedDownstreamIR(int targetIndex, bool value)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     getTargetOptionSet(targetIndex).set(CompilerOptionName::EmbedDownstreamIR, value);
 }
 
@@ -7061,6 +7411,7 @@ void EndToEndCompileRequest::setTargetLineDirectiveMode(
     SlangInt targetIndex,
     SlangLineDirectiveMode mode)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     getTargetOptionSet(targetIndex)
         .set(CompilerOptionName::LineDirectiveMode, LineDirectiveMode(mode));
 }
@@ -7069,11 +7420,13 @@ void EndToEndCompileRequest::overrideDiagnosticSeverity(
     SlangInt messageID,
     SlangSeverity overrideSeverity)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     getSink()->overrideDiagnosticSeverity(int(messageID), Severity(overrideSeverity));
 }
 
 SlangDiagnosticFlags EndToEndCompileRequest::getDiagnosticFlags()
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     DiagnosticSink::Flags sinkFlags = getSink()->getFlags();
 
     SlangDiagnosticFlags flags = 0;
@@ -7089,6 +7442,7 @@ SlangDiagnosticFlags EndToEndCompileRequest::getDiagnosticFlags()
 
 void EndToEndCompileRequest::setDiagnosticFlags(SlangDiagnosticFlags flags)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     DiagnosticSink::Flags sinkFlags = getSink()->getFlags();
 
     if (flags & SLANG_DIAGNOSTIC_FLAG_VERBOSE_PATHS)
@@ -7108,6 +7462,7 @@ SlangResult EndToEndCompileRequest::addTargetCapability(
     SlangInt targetIndex,
     SlangCapabilityID capability)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     auto& targets = getLinkage()->targets;
     if (targetIndex < 0 || targetIndex >= targets.getCount())
         return SLANG_E_INVALID_ARG;
@@ -7117,51 +7472,61 @@ SlangResult EndToEndCompileRequest::addTargetCapability(
 
 void EndToEndCompileRequest::setDebugInfoLevel(SlangDebugInfoLevel level)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     getOptionSet().set(CompilerOptionName::DebugInformation, DebugInfoLevel(level));
 }
 
 void EndToEndCompileRequest::setDebugInfoFormat(SlangDebugInfoFormat format)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     getOptionSet().set(CompilerOptionName::DebugInformationFormat, DebugInfoFormat(format));
 }
 
 void EndToEndCompileRequest::setOptimizationLevel(SlangOptimizationLevel level)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     getOptionSet().set(CompilerOptionName::Optimization, OptimizationLevel(level));
 }
 
 void EndToEndCompileRequest::setOutputContainerFormat(SlangContainerFormat format)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     m_containerFormat = ContainerFormat(format);
 }
 
 void EndToEndCompileRequest::setPassThrough(SlangPassThrough inPassThrough)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     m_passThrough = PassThroughMode(inPassThrough);
 }
 
 void EndToEndCompileRequest::setReportDownstreamTime(bool value)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     getOptionSet().set(CompilerOptionName::ReportDownstreamTime, value);
 }
 
 void EndToEndCompileRequest::setReportPerfBenchmark(bool value)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     getOptionSet().set(CompilerOptionName::ReportPerfBenchmark, value);
 }
 
 void EndToEndCompileRequest::setSkipSPIRVValidation(bool value)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     getOptionSet().set(CompilerOptionName::SkipSPIRVValidation, value);
 }
 
 void EndToEndCompileRequest::setTargetUseMinimumSlangOptimization(int targetIndex, bool value)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     getTargetOptionSet(targetIndex).set(CompilerOptionName::MinimumSlangOptimization, value);
 }
 
 void EndToEndCompileRequest::setIgnoreCapabilityCheck(bool value)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     getOptionSet().set(CompilerOptionName::IgnoreCapabilities, value);
 }
 
@@ -7169,42 +7534,50 @@ void EndToEndCompileRequest::setDiagnosticCallback(
     SlangDiagnosticCallback callback,
     void const* userData)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     ComPtr<ISlangWriter> writer(new CallbackWriter(callback, userData, WriterFlag::IsConsole));
     setWriter(WriterChannel::Diagnostic, writer);
 }
 
 void EndToEndCompileRequest::setWriter(SlangWriterChannel chan, ISlangWriter* writer)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     setWriter(WriterChannel(chan), writer);
 }
 
 ISlangWriter* EndToEndCompileRequest::getWriter(SlangWriterChannel chan)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     return getWriter(WriterChannel(chan));
 }
 
 void EndToEndCompileRequest::addSearchPath(const char* path)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     getOptionSet().addSearchPath(path);
 }
 
 void EndToEndCompileRequest::addPreprocessorDefine(const char* key, const char* value)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     getOptionSet().addPreprocessorDefine(key, value);
 }
 
 void EndToEndCompileRequest::setEnableEffectAnnotations(bool value)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     getOptionSet().set(CompilerOptionName::EnableEffectAnnotations, value);
 }
 
 char const* EndToEndCompileRequest::getDiagnosticOutput()
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     return m_diagnosticOutput.begin();
 }
 
 SlangResult EndToEndCompileRequest::getDiagnosticOutputBlob(ISlangBlob** outBlob)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     if (!outBlob)
         return SLANG_E_INVALID_ARG;
 
@@ -7220,6 +7593,7 @@ SlangResult EndToEndCompileRequest::getDiagnosticOutputBlob(ISlangBlob** outBlob
 
 int EndToEndCompileRequest::addTranslationUnit(SlangSourceLanguage language, char const* inName)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     auto frontEndReq = getFrontEndReq();
     NamePool* namePool = frontEndReq->getNamePool();
 
@@ -7232,6 +7606,7 @@ int EndToEndCompileRequest::addTranslationUnit(SlangSourceLanguage language, cha
 
 void EndToEndCompileRequest::setDefaultModuleName(const char* defaultModuleName)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     auto frontEndReq = getFrontEndReq();
     NamePool* namePool = frontEndReq->getNamePool();
     frontEndReq->m_defaultModuleName = namePool->getName(defaultModuleName);
@@ -7396,6 +7771,7 @@ SlangResult EndToEndCompileRequest::addLibraryReference(
     const void* libData,
     size_t libDataSize)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     // We need to deserialize and add the modules
     ComPtr<IModuleLibrary> library;
 
@@ -7415,6 +7791,7 @@ void EndToEndCompileRequest::addTranslationUnitPreprocessorDefine(
     const char* key,
     const char* value)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     getFrontEndReq()->translationUnits[translationUnitIndex]->preprocessorDefinitions[key] = value;
 }
 
@@ -7422,6 +7799,7 @@ void EndToEndCompileRequest::addTranslationUnitSourceFile(
     int translationUnitIndex,
     char const* path)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     auto frontEndReq = getFrontEndReq();
     if (!path)
         return;
@@ -7438,6 +7816,7 @@ void EndToEndCompileRequest::addTranslationUnitSourceString(
     char const* path,
     char const* source)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     if (!source)
         return;
     addTranslationUnitSourceStringSpan(translationUnitIndex, path, source, source + strlen(source));
@@ -7449,6 +7828,7 @@ void EndToEndCompileRequest::addTranslationUnitSourceStringSpan(
     char const* sourceBegin,
     char const* sourceEnd)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     auto frontEndReq = getFrontEndReq();
     if (!sourceBegin)
         return;
@@ -7472,6 +7852,7 @@ void EndToEndCompileRequest::addTranslationUnitSourceBlob(
     char const* path,
     ISlangBlob* sourceBlob)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     auto frontEndReq = getFrontEndReq();
     if (!sourceBlob)
         return;
@@ -7492,6 +7873,7 @@ int EndToEndCompileRequest::addEntryPoint(
     char const* name,
     SlangStage stage)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     return addEntryPointEx(translationUnitIndex, name, stage, 0, nullptr);
 }
 
@@ -7502,6 +7884,7 @@ int EndToEndCompileRequest::addEntryPointEx(
     int genericParamTypeNameCount,
     char const** genericParamTypeNames)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     auto frontEndReq = getFrontEndReq();
     if (!name)
         return -1;
@@ -7521,6 +7904,7 @@ SlangResult EndToEndCompileRequest::setGlobalGenericArgs(
     int genericArgCount,
     char const** genericArgs)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     auto& argStrings = m_globalSpecializationArgStrings;
     argStrings.clear();
     for (int i = 0; i < genericArgCount; i++)
@@ -7533,6 +7917,7 @@ SlangResult EndToEndCompileRequest::setTypeNameForGlobalExistentialTypeParam(
     int slotIndex,
     char const* typeName)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     if (slotIndex < 0)
         return SLANG_FAIL;
     if (!typeName)
@@ -7550,6 +7935,7 @@ SlangResult EndToEndCompileRequest::setTypeNameForEntryPointExistentialTypeParam
     int slotIndex,
     char const* typeName)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     if (entryPointIndex < 0)
         return SLANG_FAIL;
     if (slotIndex < 0)
@@ -7570,11 +7956,13 @@ SlangResult EndToEndCompileRequest::setTypeNameForEntryPointExistentialTypeParam
 
 void EndToEndCompileRequest::setAllowGLSLInput(bool value)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     getOptionSet().set(CompilerOptionName::AllowGLSL, value);
 }
 
 SlangResult EndToEndCompileRequest::compile()
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     SlangResult res = SLANG_FAIL;
     double downstreamStartTime = 0.0;
     double totalStartTime = 0.0;
@@ -7660,6 +8048,37 @@ SlangResult EndToEndCompileRequest::compile()
         StringBuilder perfResult;
         PerformanceProfiler::getProfiler()->getResult(perfResult);
         perfResult << "\nType Dictionary Size: " << getSession()->m_typeDictionarySize << "\n";
+
+        const auto& overloadStats = getLinkage()->m_overloadResolutionStats;
+        perfResult << "Overloaded Calls: " << overloadStats.callCount << "\n";
+        perfResult << "Overload Candidates Checked: " << overloadStats.checkedCandidateCount
+                   << " (max per call: " << overloadStats.maxCandidatesPerCall << ")\n";
+        perfResult << "Overload Candidates Filtered: " << overloadStats.filteredCandidateCount
+                   << " (calls resolved again unfiltered: " << overloadStats.unfilteredCallCount
+                   << ")\n";
+
+        auto memoryAccounting = getLinkage()->getMemoryAccounting();
+        perfResult << "Memory In Use (KB):";
+        for (Index i = 0; i < Index(MemoryAccounting::Category::CountOf); ++i)
+        {
+            const auto category = MemoryAccounting::Category(i);
+            perfResult << (i ? ", " : " ") << MemoryAccounting::getCategoryName(category) << " "
+                       << UInt64(memoryAccounting->getUsed(category) / 1024);
+        }
+        const ptrdiff_t containersAllocated = ContainerMemory::getAllocatedOnThread();
+        perfResult << ", containers on this thread "
+                   << UInt64(containersAllocated > 0 ? containersAllocated / 1024 : 0);
+        perfResult << " (peak total: " << UInt64(memoryAccounting->getPeakTotalUsed() / 1024)
+                   << ")\n";
+
+        const auto& poolStats = getLinkage()->m_containerPoolStats;
+        perfResult << "IR Pass Containers Taken From Pools: " << poolStats.takenCount
+                   << " (allocations saved by reuse: " << poolStats.reusedCount << ", "
+                   << UInt64(poolStats.reusedByteCount / 1024) << " KB)\n";
+
+        const auto& analysisStats = getLinkage()->m_irAnalysisStats;
+        perfResult << "IR Dominator Trees Computed: " << analysisStats.dominatorTreeComputedCount
+                   << " (reused: " << analysisStats.dominatorTreeReusedCount << ")\n";
         getSink()->diagnose(
             SourceLoc(),
             Diagnostics::performanceBenchmarkResult,
@@ -7717,11 +8136,29 @@ SlangResult EndToEndCompileRequest::compile()
         }
     }
 
+    auto reflectionBinaryPath =
+        getOptionSet().getStringOption(CompilerOptionName::EmitReflectionBinary);
+    if (reflectionBinaryPath.getLength() != 0)
+    {
+        ComPtr<ISlangBlob> reflectionBlob;
+        if (SLANG_FAILED(writeReflectionBinary(
+                (slang::ShaderReflection*)this->getReflection(),
+                reflectionBlob)) ||
+            SLANG_FAILED(File::writeAllBytes(
+                reflectionBinaryPath,
+                reflectionBlob->getBufferPointer(),
+                reflectionBlob->getBufferSize())))
+        {
+            getSink()->diagnose(SourceLoc(), Diagnostics::unableToWriteFile, reflectionBinaryPath);
+        }
+    }
+
     return res;
 }
 
 int EndToEndCompileRequest::getDependencyFileCount()
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     auto frontEndReq = getFrontEndReq();
     auto program = frontEndReq->getGlobalAndEntryPointsComponentType();
     return (int)program->getFileDependencies().getCount();
@@ -7729,6 +8166,7 @@ int EndToEndCompileRequest::getDependencyFileCount()
 
 char const* EndToEndCompileRequest::getDependencyFilePath(int index)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     auto frontEndReq = getFrontEndReq();
     auto program = frontEndReq->getGlobalAndEntryPointsComponentType();
     SourceFile* sourceFile = program->getFileDependencies()[index];
@@ -7739,11 +8177,13 @@ char const* EndToEndCompileRequest::getDependencyFilePath(int index)
 
 int EndToEndCompileRequest::getTranslationUnitCount()
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     return (int)getFrontEndReq()->translationUnits.getCount();
 }
 
 void const* EndToEndCompileRequest::getEntryPointCode(int entryPointIndex, size_t* outSize)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     // Zero the size initially, in case need to return nullptr for error.
     if (outSize)
     {
@@ -7791,6 +8231,7 @@ SlangResult EndToEndCompileRequest::getCompileTimeProfile(
     ISlangProfiler** compileTimeProfile,
     bool shouldClear)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     if (compileTimeProfile == nullptr)
     {
         return SLANG_E_INVALID_ARG;
@@ -7876,6 +8317,7 @@ SlangResult EndToEndCompileRequest::getEntryPointCodeBlob(
     int targetIndex,
     ISlangBlob** outBlob)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     if (!outBlob)
         return SLANG_E_INVALID_ARG;
     ComPtr<IArtifact> artifact;
@@ -7890,6 +8332,7 @@ SlangResult EndToEndCompileRequest::getEntryPointHostCallable(
     int targetIndex,
     ISlangSharedLibrary** outSharedLibrary)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     if (!outSharedLibrary)
         return SLANG_E_INVALID_ARG;
     ComPtr<IArtifact> artifact;
@@ -7900,6 +8343,7 @@ SlangResult EndToEndCompileRequest::getEntryPointHostCallable(
 
 SlangResult EndToEndCompileRequest::getTargetCodeBlob(int targetIndex, ISlangBlob** outBlob)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     if (!outBlob)
         return SLANG_E_INVALID_ARG;
 
@@ -7913,6 +8357,7 @@ SlangResult EndToEndCompileRequest::getTargetHostCallable(
     int targetIndex,
     ISlangSharedLibrary** outSharedLibrary)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     if (!outSharedLibrary)
         return SLANG_E_INVALID_ARG;
 
@@ -7924,11 +8369,13 @@ SlangResult EndToEndCompileRequest::getTargetHostCallable(
 
 char const* EndToEndCompileRequest::getEntryPointSource(int entryPointIndex)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     return (char const*)getEntryPointCode(entryPointIndex, nullptr);
 }
 
 ISlangMutableFileSystem* EndToEndCompileRequest::getCompileRequestResultAsFileSystem()
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     if (!m_containerFileSystem)
     {
         if (m_containerArtifact)
@@ -7955,6 +8402,7 @@ ISlangMutableFileSystem* EndToEndCompileRequest::getCompileRequestResultAsFileSy
 
 void const* EndToEndCompileRequest::getCompileRequestCode(size_t* outSize)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     if (m_containerArtifact)
     {
         ComPtr<ISlangBlob> containerBlob;
@@ -7973,6 +8421,7 @@ void const* EndToEndCompileRequest::getCompileRequestCode(size_t* outSize)
 
 SlangResult EndToEndCompileRequest::getContainerCode(ISlangBlob** outBlob)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     if (m_containerArtifact)
     {
         ComPtr<ISlangBlob> containerBlob;
@@ -7991,6 +8440,7 @@ SlangResult EndToEndCompileRequest::loadRepro(
     const void* data,
     size_t size)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     List<uint8_t> buffer;
     SLANG_RETURN_ON_FAIL(ReproUtil::loadState((const uint8_t*)data, size, getSink(), buffer));
 
@@ -8005,6 +8455,7 @@ SlangResult EndToEndCompileRequest::loadRepro(
 
 SlangResult EndToEndCompileRequest::saveRepro(ISlangBlob** outBlob)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     OwnedMemoryStream stream(FileAccess::Write);
 
     SLANG_RETURN_ON_FAIL(ReproUtil::saveState(this, &stream));
@@ -8020,6 +8471,7 @@ SlangResult EndToEndCompileRequest::saveRepro(ISlangBlob** outBlob)
 
 SlangResult EndToEndCompileRequest::enableReproCapture()
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     getLinkage()->setRequireCacheFileSystem(true);
     return SLANG_OK;
 }
@@ -8028,11 +8480,13 @@ SlangResult EndToEndCompileRequest::processCommandLineArguments(
     char const* const* args,
     int argCount)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     return parseOptions(this, argCount, args);
 }
 
 SlangReflection* EndToEndCompileRequest::getReflection()
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     auto linkage = getLinkage();
     auto program = getSpecializedGlobalAndEntryPointsComponentType();
 
@@ -8061,6 +8515,7 @@ SlangReflection* EndToEndCompileRequest::getReflection()
 
 SlangResult EndToEndCompileRequest::getProgram(slang::IComponentType** outProgram)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     auto program = getSpecializedGlobalComponentType();
     *outProgram = Slang::ComPtr<slang::IComponentType>(program).detach();
     return SLANG_OK;
@@ -8068,6 +8523,7 @@ SlangResult EndToEndCompileRequest::getProgram(slang::IComponentType** outProgra
 
 SlangResult EndToEndCompileRequest::getProgramWithEntryPoints(slang::IComponentType** outProgram)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     auto program = getSpecializedGlobalAndEntryPointsComponentType();
     *outProgram = Slang::ComPtr<slang::IComponentType>(program).detach();
     return SLANG_OK;
@@ -8077,6 +8533,7 @@ SlangResult EndToEndCompileRequest::getModule(
     SlangInt translationUnitIndex,
     slang::IModule** outModule)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     auto module = getFrontEndReq()->getTranslationUnit(translationUnitIndex)->getModule();
 
     *outModule = Slang::ComPtr<slang::IModule>(module).detach();
@@ -8085,6 +8542,7 @@ SlangResult EndToEndCompileRequest::getModule(
 
 SlangResult EndToEndCompileRequest::getSession(slang::ISession** outSession)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     auto session = getLinkage();
     *outSession = Slang::ComPtr<slang::ISession>(session).detach();
     return SLANG_OK;
@@ -8094,6 +8552,7 @@ SlangResult EndToEndCompileRequest::getEntryPoint(
     SlangInt entryPointIndex,
     slang::IComponentType** outEntryPoint)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     auto entryPoint = getSpecializedEntryPointComponentType(entryPointIndex);
     *outEntryPoint = Slang::ComPtr<slang::IComponentType>(entryPoint).detach();
     return SLANG_OK;
@@ -8107,6 +8566,7 @@ SlangResult EndToEndCompileRequest::isParameterLocationUsed(
     UInt registerIndex,
     bool& outUsed)
 {
+    SessionAccessLock sessionAccessLock(getSessionAccessMutex());
     if (!ShaderBindingRange::isUsageTracked((slang::ParameterCategory)category))
         return SLANG_E_NOT_AVAILABLE;
 
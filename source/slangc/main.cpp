@@ -4,14 +4,23 @@
 
 SLANG_API void spSetCommandLineCompilerMode(SlangCompileRequest* request);
 
+#include "../compiler-core/slang-json-rpc-connection.h"
 #include "../core/slang-io.h"
+#include "../core/slang-local-socket.h"
 #include "../core/slang-test-tool-util.h"
+#include "../core/slang-writer.h"
 #include "../slang/slang-internal.h"
 
 using namespace Slang;
 
 #include <assert.h>
 
+#if !SLANG_WINDOWS_FAMILY
+#include <errno.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
 #ifdef _WIN32
 #define MAIN slangc_main
 #else
@@ -78,14 +87,14 @@ bool shouldEmbedPrelude(const char* const* argv, int argc)
     return false;
 }
 
-SLANG_TEST_TOOL_API SlangResult innerMain(
-    StdWriters* stdWriters,
+/// Get the global session to compile with. Uses `sharedSession` unless the command line requires
+/// a session of its own.
+static SlangResult _getGlobalSession(
     slang::IGlobalSession* sharedSession,
     int argc,
-    const char* const* argv)
+    const char* const* argv,
+    ComPtr<slang::IGlobalSession>& outSession)
 {
-    StdWriters::setSingleton(stdWriters);
-
     // Assume we will used the shared session
     ComPtr<slang::IGlobalSession> session(sharedSession);
 
@@ -114,7 +123,32 @@ SLANG_TEST_TOOL_API SlangResult innerMain(
     if (!shouldEmbedPrelude(argv, argc))
         TestToolUtil::setSessionDefaultPreludeFromExePath(argv[0], session);
 
+    outSession = session;
+    return SLANG_OK;
+}
+
+/// Compile the command line with `session`. If `requestWriters` is set all output of the
+/// compile request is sent to it, otherwise the request uses the default writers.
+static SlangResult _compileWithSession(
+    slang::IGlobalSession* session,
+    StdWriters* requestWriters,
+    int argc,
+    const char* const* argv)
+{
     SlangCompileRequest* compileRequest = spCreateCompileRequest(session);
+    if (requestWriters)
+    {
+        for (int i = 0; i < int{SLANG_WRITER_CHANNEL_COUNT_OF}; ++i)
+        {
+            const auto channel = SlangWriterChannel(i);
+            spSetWriter(compileRequest, channel, requestWriters->getWriter(channel));
+        }
+        // As for the command line, diagnostics are output to stderr
+        spSetWriter(
+            compileRequest,
+            SLANG_WRITER_CHANNEL_DIAGNOSTIC,
+            requestWriters->getWriter(SLANG_WRITER_CHANNEL_STD_ERROR));
+    }
     compileRequest->addSearchPath(Path::getParentDirectory(Path::getExecutablePath()).getBuffer());
     SlangResult res = _compile(compileRequest, argc, argv);
     // Now that we are done, clean up after ourselves
@@ -123,10 +157,494 @@ SLANG_TEST_TOOL_API SlangResult innerMain(
     return res;
 }
 
+SLANG_TEST_TOOL_API SlangResult innerMain(
+    StdWriters* stdWriters,
+    slang::IGlobalSession* sharedSession,
+    int argc,
+    const char* const* argv)
+{
+    StdWriters::setSingleton(stdWriters);
+
+    ComPtr<slang::IGlobalSession> session;
+    SLANG_RETURN_ON_FAIL(_getGlobalSession(sharedSession, argc, argv, session));
+
+    return _compileWithSession(session, nullptr, argc, argv);
+}
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!! Daemon !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+// `slangc -daemon <socket-path>` runs a long lived compile server listening on a local socket.
+// The server keeps its global session (and so the loaded core module) alive between compiles.
+//
+// `slangc -connect <socket-path> <args...>` has the server compile `<args...>`, as if
+// `slangc <args...>` had been run in the current directory, and outputs the results locally.
+// If no server is listening, the client compiles in process instead.
+//
+// `slangc -daemon-stop <socket-path>` asks the server to exit.
+
+namespace
+{ // anonymous
+
+struct DaemonCompileArgs
+{
+    String workingDirectory; ///< The working directory of the client
+    List<String> args;       ///< Command line arguments, without the executable name
+    bool isConsole = false;  ///< True if the client's stdout is a console
+
+    static const UnownedStringSlice g_methodName;
+    static const StructRttiInfo g_rttiInfo;
+};
+
+static const StructRttiInfo _makeDaemonCompileArgsRtti()
+{
+    DaemonCompileArgs obj;
+    StructRttiBuilder builder(&obj, "DaemonCompileArgs", nullptr);
+    builder.addField("workingDirectory", &obj.workingDirectory);
+    builder.addField("args", &obj.args);
+    builder.addField("isConsole", &obj.isConsole);
+    return builder.make();
+}
+/* static */ const UnownedStringSlice DaemonCompileArgs::g_methodName =
+    UnownedStringSlice::fromLiteral("compile");
+/* static */ const StructRttiInfo DaemonCompileArgs::g_rttiInfo = _makeDaemonCompileArgsRtti();
+
+/// The result of a daemon compile. Standard output may hold binary data (such as SPIR-V written
+/// with `-o -`), so it is base64 encoded to survive being sent as a JSON string.
+struct DaemonCompileResult
+{
+    String stdOutBase64;
+    String stdError;
+    int32_t result = SLANG_OK;
+
+    static const StructRttiInfo g_rttiInfo;
+};
+
+static const StructRttiInfo _makeDaemonCompileResultRtti()
+{
+    DaemonCompileResult obj;
+    StructRttiBuilder builder(&obj, "DaemonCompileResult", nullptr);
+    builder.addField("stdOutBase64", &obj.stdOutBase64);
+    builder.addField("stdError", &obj.stdError);
+    builder.addField("result", &obj.result);
+    return builder.make();
+}
+/* static */ const StructRttiInfo DaemonCompileResult::g_rttiInfo = _makeDaemonCompileResultRtti();
+
+static const char g_base64Chars[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+static void _encodeBase64(const void* data, size_t size, StringBuilder& out)
+{
+    const uint8_t* cur = (const uint8_t*)data;
+    for (; size >= 3; size -= 3, cur += 3)
+    {
+        const uint32_t v = (uint32_t(cur[0]) << 16) | (uint32_t(cur[1]) << 8) | cur[2];
+        out << g_base64Chars[(v >> 18) & 0x3f] << g_base64Chars[(v >> 12) & 0x3f]
+            << g_base64Chars[(v >> 6) & 0x3f] << g_base64Chars[v & 0x3f];
+    }
+    if (size > 0)
+    {
+        const uint32_t v = (uint32_t(cur[0]) << 16) | ((size > 1) ? (uint32_t(cur[1]) << 8) : 0);
+        out << g_base64Chars[(v >> 18) & 0x3f] << g_base64Chars[(v >> 12) & 0x3f]
+            << ((size > 1) ? g_base64Chars[(v >> 6) & 0x3f] : '=') << '=';
+    }
+}
+
+static SlangResult _decodeBase64(const UnownedStringSlice& text, List<uint8_t>& out)
+{
+    if (text.getLength() % 4)
+    {
+        return SLANG_FAIL;
+    }
+
+    int8_t decodeTable[256];
+    ::memset(decodeTable, -1, sizeof(decodeTable));
+    for (int i = 0; i < 64; ++i)
+    {
+        decodeTable[uint8_t(g_base64Chars[i])] = int8_t(i);
+    }
+
+    out.clear();
+    out.reserve(text.getLength() / 4 * 3);
+
+    const char* cur = text.begin();
+    for (const char* end = text.end(); cur < end; cur += 4)
+    {
+        // Padding can only appear at the end
+        const Index padCount = (cur[3] == '=') ? ((cur[2] == '=') ? 2 : 1) : 0;
+        if (padCount && cur + 4 != end)
+        {
+            return SLANG_FAIL;
+        }
+
+        uint32_t v = 0;
+        for (Index i = 0; i < 4 - padCount; ++i)
+        {
+            const int8_t digit = decodeTable[uint8_t(cur[i])];
+            if (digit < 0)
+            {
+                return SLANG_FAIL;
+            }
+            v |= uint32_t(digit) << (18 - 6 * i);
+        }
+
+        out.add(uint8_t(v >> 16));
+        if (padCount < 2)
+            out.add(uint8_t(v >> 8));
+        if (padCount < 1)
+            out.add(uint8_t(v));
+    }
+    return SLANG_OK;
+}
+
+class Daemon
+{
+public:
+    /// Listen on `socketPath`, and compile requests until asked to quit
+    SlangResult execute(const char* exePath, const String& socketPath);
+
+protected:
+    /// Handle a call from a client. Compiles are done in a child process, which owns the
+    /// connection from then on.
+    SlangResult _executeConnection(Stream* stream);
+    void _compile(const DaemonCompileArgs& args, DaemonCompileResult& outResult);
+
+    /// Reap child processes that have finished. If `wait` is set, waits for all of them.
+    void _reapChildren(bool wait);
+
+    ComPtr<slang::IGlobalSession> m_session;
+    String m_exePath;
+    bool m_quit = false;
+};
+
+SlangResult Daemon::execute(const char* exePath, const String& socketPath)
+{
+    m_exePath = exePath;
+
+    // Create the session up front, so the first compile doesn't pay for it
+    const char* const argv[] = {exePath};
+    SLANG_RETURN_ON_FAIL(_getGlobalSession(nullptr, 1, argv, m_session));
+
+    RefPtr<LocalSocketServer> server(new LocalSocketServer);
+    SLANG_RETURN_ON_FAIL(server->listen(socketPath));
+
+    while (!m_quit)
+    {
+        RefPtr<Stream> stream;
+        SLANG_RETURN_ON_FAIL(server->accept(stream));
+
+        // A failure only ends this connection, not the daemon
+        _executeConnection(stream);
+
+        // Any child has its own copy of the connection
+        stream->close();
+
+        _reapChildren(false);
+    }
+
+    _reapChildren(true);
+    return SLANG_OK;
+}
+
+void Daemon::_reapChildren(bool wait)
+{
+#if !SLANG_WINDOWS_FAMILY
+    for (;;)
+    {
+        int status = 0;
+        const pid_t pid = ::waitpid(-1, &status, wait ? 0 : WNOHANG);
+        if (pid > 0 || (pid < 0 && errno == EINTR))
+        {
+            continue;
+        }
+        // No children left, or none have finished
+        break;
+    }
+#else
+    SLANG_UNUSED(wait);
+#endif
+}
+
+SlangResult Daemon::_executeConnection(Stream* stream)
+{
+    RefPtr<BufferedReadStream> readStream(new BufferedReadStream(stream));
+    RefPtr<HTTPPacketConnection> packetConnection =
+        new HTTPPacketConnection(readStream, stream);
+
+    RefPtr<JSONRPCConnection> connection(new JSONRPCConnection);
+    SLANG_RETURN_ON_FAIL(connection->init(packetConnection));
+
+    // Clients make a single call per connection
+    SLANG_RETURN_ON_FAIL(connection->waitForResult());
+    if (!connection->hasMessage())
+    {
+        return SLANG_OK;
+    }
+
+    if (connection->getMessageType() != JSONRPCMessageType::Call)
+    {
+        return connection->sendError(
+            JSONRPC::ErrorCode::InvalidRequest,
+            connection->getCurrentMessageId());
+    }
+
+    JSONRPCCall call;
+    SLANG_RETURN_ON_FAIL(connection->getRPCOrSendError(&call));
+
+    if (call.method == TestServerProtocol::QuitArgs::g_methodName)
+    {
+        m_quit = true;
+        return SLANG_OK;
+    }
+    if (call.method != DaemonCompileArgs::g_methodName)
+    {
+        return connection->sendError(JSONRPC::ErrorCode::MethodNotFound, call.id);
+    }
+
+    auto id = connection->getPersistentValue(call.id);
+
+    DaemonCompileArgs args;
+    SLANG_RETURN_ON_FAIL(connection->toNativeArgsOrSendError(call.params, &args, id));
+
+#if !SLANG_WINDOWS_FAMILY
+    // Each compile runs in a forked child. The child starts with the daemon's warm global session,
+    // but any changes the compile makes to it (such as from `-dxc-path`, `-spirv-core-grammar` or
+    // `-default-downstream-compiler`), and the change to the working directory, stay in the child.
+    // Compiles from different clients can also run at the same time.
+    const pid_t pid = ::fork();
+    if (pid < 0)
+    {
+        return connection->sendError(JSONRPC::ErrorCode::InternalError, id);
+    }
+    if (pid > 0)
+    {
+        return SLANG_OK;
+    }
+
+    DaemonCompileResult result;
+    _compile(args, result);
+    const SlangResult res = connection->sendResult(&result, id);
+
+    // Skip destructors and exit handlers, which would otherwise tear down state (such as the
+    // listening socket) that belongs to the daemon.
+    ::_exit(SLANG_SUCCEEDED(res) ? 0 : 1);
+#else
+    return connection->sendError(JSONRPC::ErrorCode::InternalError, id);
+#endif
+}
+
+void Daemon::_compile(const DaemonCompileArgs& args, DaemonCompileResult& outResult)
+{
+    List<const char*> argv;
+    argv.add(m_exePath.getBuffer());
+    for (const auto& arg : args.args)
+    {
+        argv.add(arg.getBuffer());
+    }
+    const int argc = int(argv.getCount());
+
+    StringBuilder stdOut;
+    StringBuilder stdError;
+
+    // Relative paths are relative to the working directory of the client. This is only called in
+    // a child process, so changing the directory doesn't affect the daemon or other compiles.
+    SlangResult res = SLANG_E_NOT_AVAILABLE;
+#if !SLANG_WINDOWS_FAMILY
+    res = (::chdir(args.workingDirectory.getBuffer()) == 0) ? SLANG_OK : SLANG_E_NOT_FOUND;
+#endif
+    if (SLANG_FAILED(res))
+    {
+        stdError << "error: unable to use working directory '" << args.workingDirectory << "'\n";
+    }
+    else
+    {
+        // Binary output to stdout is only hex dumped if the client is writing to a console.
+        RefPtr<StringWriter> stdOutWriter(
+            new StringWriter(&stdOut, args.isConsole ? WriterFlags(WriterFlag::IsConsole) : 0));
+        RefPtr<StringWriter> stdErrorWriter(new StringWriter(&stdError, WriterFlag::IsConsole));
+
+        StdWriters stdWriters;
+        stdWriters.setWriter(SLANG_WRITER_CHANNEL_STD_OUTPUT, stdOutWriter);
+        stdWriters.setWriter(SLANG_WRITER_CHANNEL_STD_ERROR, stdErrorWriter);
+
+        StdWriters* prevWriters = StdWriters::getSingleton();
+        StdWriters::setSingleton(&stdWriters);
+
+        // `-embed-prelude` changes the prelude of the session it's used with, so it can't
+        // share the daemon's session.
+        slang::IGlobalSession* sharedSession =
+            shouldEmbedPrelude(argv.getBuffer(), argc) ? nullptr : m_session.get();
+
+        ComPtr<slang::IGlobalSession> session;
+        res = _getGlobalSession(sharedSession, argc, argv.getBuffer(), session);
+        if (SLANG_SUCCEEDED(res))
+        {
+            res = _compileWithSession(session, &stdWriters, argc, argv.getBuffer());
+        }
+
+        StdWriters::setSingleton(prevWriters);
+    }
+
+    StringBuilder stdOutBase64;
+    _encodeBase64(stdOut.getBuffer(), size_t(stdOut.getLength()), stdOutBase64);
+
+    outResult.result = res;
+    outResult.stdOutBase64 = stdOutBase64;
+    outResult.stdError = stdError;
+}
+
+/// Send `args` to the daemon at `socketPath` to compile. Fails with SLANG_E_NOT_FOUND if there is
+/// no daemon to connect to.
+static SlangResult _compileWithDaemon(
+    const String& socketPath,
+    int argc,
+    const char* const* argv,
+    SlangResult& outResult)
+{
+    RefPtr<Stream> stream;
+    SLANG_RETURN_ON_FAIL(LocalSocketServer::connect(socketPath, stream));
+
+    RefPtr<BufferedReadStream> readStream(new BufferedReadStream(stream));
+    RefPtr<HTTPPacketConnection> packetConnection =
+        new HTTPPacketConnection(readStream, stream);
+    RefPtr<JSONRPCConnection> connection(new JSONRPCConnection);
+    SLANG_RETURN_ON_FAIL(connection->init(packetConnection));
+
+    DaemonCompileArgs args;
+    args.workingDirectory = Path::getCurrentPath();
+    args.isConsole = FileWriter::isFileConsole(stdout);
+    for (int i = 0; i < argc; ++i)
+    {
+        args.args.add(argv[i]);
+    }
+
+    SLANG_RETURN_ON_FAIL(connection->sendCall(DaemonCompileArgs::g_methodName, &args));
+    SLANG_RETURN_ON_FAIL(connection->waitForResult());
+    if (!connection->hasMessage() ||
+        connection->getMessageType() != JSONRPCMessageType::Result)
+    {
+        return SLANG_FAIL;
+    }
+
+    DaemonCompileResult result;
+    SLANG_RETURN_ON_FAIL(connection->getMessage(&result));
+
+    List<uint8_t> stdOut;
+    SLANG_RETURN_ON_FAIL(_decodeBase64(result.stdOutBase64.getUnownedSlice(), stdOut));
+
+    StdWriters::getOut().write((const char*)stdOut.getBuffer(), size_t(stdOut.getCount()));
+    StdWriters::getError().write(result.stdError.getBuffer(), result.stdError.getLength());
+
+    outResult = result.result;
+    return SLANG_OK;
+}
+
+static SlangResult _stopDaemon(const String& socketPath)
+{
+    RefPtr<Stream> stream;
+    SLANG_RETURN_ON_FAIL(LocalSocketServer::connect(socketPath, stream));
+
+    RefPtr<BufferedReadStream> readStream(new BufferedReadStream(stream));
+    RefPtr<HTTPPacketConnection> packetConnection =
+        new HTTPPacketConnection(readStream, stream);
+    RefPtr<JSONRPCConnection> connection(new JSONRPCConnection);
+    SLANG_RETURN_ON_FAIL(connection->init(packetConnection));
+
+    return connection->sendCall(TestServerProtocol::QuitArgs::g_methodName);
+}
+
+/// True if `arg` is the option `name`. Allows a `--` prefix, as well as the usual `-`.
+static bool _isDaemonOption(const char* arg, const char* name)
+{
+    UnownedStringSlice slice(arg);
+    if (slice.startsWith(toSlice("--")))
+    {
+        slice = slice.tail(1);
+    }
+    return slice.startsWith(toSlice("-")) && slice.tail(1) == UnownedStringSlice(name);
+}
+
+} // namespace
+
+/// Handles the daemon related options, which must come first on the command line. Returns
+/// false if the command line doesn't use them.
+static bool _executeDaemonCommandLine(
+    StdWriters* stdWriters,
+    int argc,
+    const char* const* argv,
+    SlangResult& outResult)
+{
+    if (argc < 2 || !(_isDaemonOption(argv[1], "daemon") || _isDaemonOption(argv[1], "connect") ||
+                      _isDaemonOption(argv[1], "daemon-stop")))
+    {
+        return false;
+    }
+
+    if (argc < 3)
+    {
+        StdWriters::getError().print("error: expected a socket path after '%s'\n", argv[1]);
+        outResult = SLANG_E_INVALID_ARG;
+        return true;
+    }
+    if (!LocalSocketServer::isAvailable())
+    {
+        StdWriters::getError().print("error: '%s' is not available on this platform\n", argv[1]);
+        outResult = SLANG_E_NOT_AVAILABLE;
+        return true;
+    }
+
+    const String socketPath(argv[2]);
+
+    if (_isDaemonOption(argv[1], "daemon"))
+    {
+        Daemon daemon;
+        outResult = daemon.execute(argv[0], socketPath);
+        if (SLANG_FAILED(outResult))
+        {
+            StdWriters::getError().print(
+                "error: unable to run compile daemon on '%s'\n",
+                socketPath.getBuffer());
+        }
+    }
+    else if (_isDaemonOption(argv[1], "daemon-stop"))
+    {
+        outResult = _stopDaemon(socketPath);
+    }
+    else
+    {
+        // The compile args follow the socket path
+        List<const char*> compileArgv;
+        compileArgv.add(argv[0]);
+        compileArgv.addRange(argv + 3, argc - 3);
+
+        outResult = SLANG_OK;
+        const SlangResult connectRes = _compileWithDaemon(
+            socketPath,
+            int(compileArgv.getCount() - 1),
+            compileArgv.getBuffer() + 1,
+            outResult);
+
+        // If there isn't a daemon, compile in process so builds still work without one
+        if (SLANG_FAILED(connectRes))
+        {
+            outResult = innerMain(
+                stdWriters,
+                nullptr,
+                int(compileArgv.getCount()),
+                compileArgv.getBuffer());
+        }
+    }
+    return true;
+}
+
 int MAIN(int argc, char** argv)
 {
     auto stdWriters = StdWriters::initDefaultSingleton();
-    SlangResult res = innerMain(stdWriters, nullptr, argc, argv);
+    SlangResult res = SLANG_OK;
+    if (!_executeDaemonCommandLine(stdWriters, argc, argv, res))
+    {
+        res = innerMain(stdWriters, nullptr, argc, argv);
+    }
     slang::shutdown();
     return (int)TestToolUtil::getReturnCode(res);
 }
@@ -0,0 +1,17 @@
+// include-guard-a.h
+
+// Used by the `include-guard.slang` and `include-guard-output-includes.slang` tests
+
+#ifndef INCLUDE_GUARD_A_H
+#define INCLUDE_GUARD_A_H
+
+#define GUARD_A_VALUE 1
+
+#ifndef INCLUDE_GUARD_A_SKIP_FUNCTION
+float foo(float x)
+{
+    return x;
+}
+#endif
+
+#endif
@@ -0,0 +1,9 @@
+// include-guard-b.h
+
+// Used by the `include-guard.slang` test
+
+#ifndef INCLUDE_GUARD_B_H
+#define INCLUDE_GUARD_B_H
+#endif
+
+#define GUARD_B_VALUE 2
@@ -0,0 +1,169 @@
+#include "core/slang-basic.h"
+#include "gfx-test-util.h"
+#include "gfx-util/shader-cursor.h"
+#include "slang-gfx.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace gfx;
+
+namespace gfx_test
+{
+static ComPtr<ISamplerState> createSampler(
+    IDevice* device,
+    TextureFilteringMode filter,
+    TextureAddressingMode addressMode)
+{
+    ISamplerState::Desc desc = {};
+    desc.minFilter = filter;
+    desc.magFilter = filter;
+    desc.mipFilter = TextureFilteringMode::Point;
+    desc.addressU = addressMode;
+    desc.addressV = addressMode;
+    desc.addressW = addressMode;
+    for (auto& component : desc.borderColor)
+        component = 10.0f;
+
+    ComPtr<ISamplerState> sampler;
+    GFX_CHECK_CALL_ABORT(device->createSamplerState(desc, sampler.writeRef()));
+    return sampler;
+}
+
+void samplerStateTestImpl(IDevice* device, UnitTestContext* context)
+{
+    Slang::ComPtr<ITransientResourceHeap> transientHeap;
+    ITransientResourceHeap::Desc transientHeapDesc = {};
+    transientHeapDesc.constantBufferSize = 4096;
+    GFX_CHECK_CALL_ABORT(
+        device->createTransientResourceHeap(transientHeapDesc, transientHeap.writeRef()));
+
+    ComPtr<IShaderProgram> shaderProgram;
+    slang::ProgramLayout* slangReflection;
+    GFX_CHECK_CALL_ABORT(loadComputeProgram(
+        device,
+        shaderProgram,
+        "sampler-state-cpu",
+        "computeMain",
+        slangReflection));
+
+    ComputePipelineStateDesc pipelineDesc = {};
+    pipelineDesc.program = shaderProgram.get();
+    ComPtr<gfx::IPipelineState> pipelineState;
+    GFX_CHECK_CALL_ABORT(
+        device->createComputePipelineState(pipelineDesc, pipelineState.writeRef()));
+
+    // A single row of 4 texels, holding 1 to 4
+    ComPtr<IResourceView> srv;
+    {
+        ITextureResource::Desc textureDesc = {};
+        textureDesc.type = IResource::Type::Texture2D;
+        textureDesc.format = Format::R32_FLOAT;
+        textureDesc.size.width = 4;
+        textureDesc.size.height = 1;
+        textureDesc.size.depth = 1;
+        textureDesc.numMipLevels = 1;
+        textureDesc.memoryType = MemoryType::DeviceLocal;
+        textureDesc.defaultState = ResourceState::ShaderResource;
+        textureDesc.allowedStates.add(ResourceState::CopyDestination);
+        float data[] = {1.0f, 2.0f, 3.0f, 4.0f};
+        ITextureResource::SubresourceData subResourceData = {data, 16, 16};
+        ComPtr<ITextureResource> texture;
+        GFX_CHECK_CALL_ABORT(
+            device->createTextureResource(textureDesc, &subResourceData, texture.writeRef()));
+
+        IResourceView::Desc viewDesc = {};
+        viewDesc.type = IResourceView::Type::ShaderResource;
+        viewDesc.format = Format::R32_FLOAT;
+        viewDesc.subresourceRange.layerCount = 1;
+        viewDesc.subresourceRange.mipLevelCount = 1;
+        GFX_CHECK_CALL_ABORT(device->createTextureView(texture, viewDesc, srv.writeRef()));
+    }
+
+    const int resultCount = 9;
+    ComPtr<IBufferResource> buffer;
+    ComPtr<IResourceView> uav;
+    {
+        float initialData[resultCount] = {};
+        IBufferResource::Desc bufferDesc = {};
+        bufferDesc.sizeInBytes = sizeof(initialData);
+        bufferDesc.format = gfx::Format::Unknown;
+        bufferDesc.elementSize = sizeof(float);
+        bufferDesc.allowedStates = ResourceStateSet(
+            ResourceState::ShaderResource,
+            ResourceState::UnorderedAccess,
+            ResourceState::CopyDestination,
+            ResourceState::CopySource);
+        bufferDesc.defaultState = ResourceState::UnorderedAccess;
+        bufferDesc.memoryType = MemoryType::DeviceLocal;
+        GFX_CHECK_CALL_ABORT(
+            device->createBufferResource(bufferDesc, (void*)initialData, buffer.writeRef()));
+
+        IResourceView::Desc viewDesc = {};
+        viewDesc.type = IResourceView::Type::UnorderedAccess;
+        viewDesc.format = Format::Unknown;
+        GFX_CHECK_CALL_ABORT(device->createBufferView(buffer, nullptr, viewDesc, uav.writeRef()));
+    }
+
+    struct SamplerEntry
+    {
+        const char* name;
+        TextureFilteringMode filter;
+        TextureAddressingMode addressMode;
+    };
+    const SamplerEntry samplerEntries[] = {
+        {"pointWrap", TextureFilteringMode::Point, TextureAddressingMode::Wrap},
+        {"pointClamp", TextureFilteringMode::Point, TextureAddressingMode::ClampToEdge},
+        {"pointMirror", TextureFilteringMode::Point, TextureAddressingMode::MirrorRepeat},
+        {"pointBorder", TextureFilteringMode::Point, TextureAddressingMode::ClampToBorder},
+        {"linearWrap", TextureFilteringMode::Linear, TextureAddressingMode::Wrap},
+        {"linearClamp", TextureFilteringMode::Linear, TextureAddressingMode::ClampToEdge},
+        {"linearMirror", TextureFilteringMode::Linear, TextureAddressingMode::MirrorRepeat},
+        {"linearBorder", TextureFilteringMode::Linear, TextureAddressingMode::ClampToBorder},
+    };
+    Slang::List<ComPtr<ISamplerState>> samplers;
+    for (const auto& entry : samplerEntries)
+        samplers.add(createSampler(device, entry.filter, entry.addressMode));
+
+    {
+        ICommandQueue::Desc queueDesc = {ICommandQueue::QueueType::Graphics};
+        auto queue = device->createCommandQueue(queueDesc);
+
+        auto commandBuffer = transientHeap->createCommandBuffer();
+        auto encoder = commandBuffer->encodeComputeCommands();
+
+        auto rootObject = encoder->bindPipeline(pipelineState);
+        ShaderCursor cursor(rootObject);
+        cursor["tex"].setResource(srv);
+        for (Slang::Index i = 0; i < samplers.getCount(); ++i)
+            cursor[samplerEntries[i].name].setSampler(samplers[i]);
+        cursor["buffer"].setResource(uav);
+
+        encoder->dispatchCompute(1, 1, 1);
+        encoder->endEncoding();
+        commandBuffer->close();
+        queue->executeCommandBuffer(commandBuffer);
+        queue->waitOnHost();
+    }
+
+    compareComputeResult(
+        device,
+        buffer,
+        Slang::makeArray<float>(
+            // Point sampling the 6th texel, counting from the left edge
+            2.0f,  // Wrap: the 2nd texel
+            4.0f,  // Clamp: the last texel
+            3.0f,  // Mirror: the 3rd texel
+            10.0f, // Border: the border color
+            // Linear filtering between the 2nd and 1st texels to the left of the left edge
+            3.5f,  // Wrap: the 3rd and 4th texels
+            1.0f,  // Clamp: the 1st texel
+            1.5f,  // Mirror: the 2nd and 1st texels
+            10.0f, // Border: the border color
+            // Linear filtering between the 1st and 2nd texels
+            1.5f));
+}
+
+SLANG_UNIT_TEST(samplerStateCPU)
+{
+    runTestImpl(samplerStateTestImpl, unitTestContext, Slang::RenderApiFlag::CPU);
+}
+} // namespace gfx_test
@@ -34,6 +34,7 @@ class RootShaderObjectImpl;
 class ShaderProgramImpl;
 class PipelineStateImpl;
 class QueryPoolImpl;
+class SamplerStateImpl;
 class DeviceImpl;
 } // namespace cpu
 } // namespace gfx
@@ -5,6 +5,7 @@
 #include "cpu-pipeline-state.h"
 #include "cpu-query.h"
 #include "cpu-resource-views.h"
+#include "cpu-sampler.h"
 #include "cpu-shader-object.h"
 #include "cpu-shader-program.h"
 #include "cpu-texture.h"
@@ -216,8 +217,8 @@ SLANG_NO_THROW const DeviceInfo& SLANG_MCALL DeviceImpl::getDeviceInfo() const
 SLANG_NO_THROW Result SLANG_MCALL
 DeviceImpl::createSamplerState(ISamplerState::Desc const& desc, ISamplerState** outSampler)
 {
-    SLANG_UNUSED(desc);
-    *outSampler = nullptr;
+    RefPtr<SamplerStateImpl> samplerImpl = new SamplerStateImpl(desc);
+    returnComPtr(outSampler, samplerImpl);
     return SLANG_OK;
 }
 
@@ -260,22 +261,26 @@ void DeviceImpl::dispatchCompute(int x, int y, int z)
 
     auto entryPointObject = m_currentRootObject->getEntryPoint(entryPointIndex);
 
-    ComPtr<ISlangSharedLibrary> sharedLibrary;
-    ComPtr<ISlangBlob> diagnostics;
-    auto compileResult = program->slangGlobalScope->getEntryPointHostCallable(
-        entryPointIndex,
-        targetIndex,
-        sharedLibrary.writeRef(),
-        diagnostics.writeRef());
-    if (diagnostics)
+    if (!program->hostCallable)
     {
-        getDebugCallback()->handleMessage(
-            compileResult == SLANG_OK ? DebugMessageType::Warning : DebugMessageType::Error,
-            DebugMessageSource::Slang,
-            (char*)diagnostics->getBufferPointer());
+        ComPtr<ISlangBlob> diagnostics;
+        auto compileResult = getEntryPointHostCallableFromShaderCache(
+            program->slangGlobalScope,
+            entryPointIndex,
+            targetIndex,
+            program->hostCallable.writeRef(),
+            diagnostics.writeRef());
+        if (diagnostics)
+        {
+            getDebugCallback()->handleMessage(
+                compileResult == SLANG_OK ? DebugMessageType::Warning : DebugMessageType::Error,
+                DebugMessageSource::Slang,
+                (char*)diagnostics->getBufferPointer());
+        }
+        if (SLANG_FAILED(compileResult))
+            return;
     }
-    if (SLANG_FAILED(compileResult))
-        return;
+    auto sharedLibrary = program->hostCallable;
 
     auto func = (slang_prelude::ComputeFunc)sharedLibrary->findSymbolAddressByName(entryPointName);
 
@@ -1,6 +1,8 @@
 // cpu-resource-views.cpp
 #include "cpu-resource-views.h"
 
+#include <math.h>
+
 namespace gfx
 {
 using namespace Slang;
@@ -69,12 +71,259 @@ void TextureResourceViewImpl::SampleLevel(
     float level,
     void* outData,
     size_t dataSize)
+{
+    _sampleLevel(
+        SamplerStateImpl::fromPreludeSamplerState(samplerState),
+        coords,
+        level,
+        outData,
+        dataSize);
+}
+
+int32_t TextureResourceViewImpl::_getSampleArrayElementIndex(const float* coords)
+{
+    TextureResourceImpl* texture = m_texture;
+    auto& desc = texture->_getDesc();
+
+    bool isArray = (desc.arraySize != 0) || (desc.type == ITextureResource::Type::TextureCube);
+    int32_t elementIndex = 0;
+    if (isArray)
+    {
+        elementIndex = int32_t(coords[texture->m_baseShape->baseCoordCount] + 0.5f);
+    }
+    return Math::Clamp(elementIndex, 0, texture->m_effectiveArrayElementCount - 1);
+}
+
+void TextureResourceViewImpl::_sampleLevel(
+    SamplerStateImpl* sampler,
+    const float* coords,
+    float level,
+    void* outData,
+    size_t dataSize)
+{
+    if (!sampler)
+    {
+        _sampleLevelNoSampler(coords, level, outData, dataSize);
+        return;
+    }
+
+    TextureResourceImpl* texture = m_texture;
+    auto& desc = texture->_getDesc();
+    auto& samplerDesc = sampler->m_desc;
+
+    const int32_t elementIndex = _getSampleArrayElementIndex(coords);
+
+    // A level of detail at or below zero means the texture is magnified.
+    float lod = level + samplerDesc.mipLODBias;
+    const TextureFilteringMode filter =
+        lod <= 0.0f ? samplerDesc.magFilter : samplerDesc.minFilter;
+
+    lod = Math::Clamp(lod, samplerDesc.minLOD, samplerDesc.maxLOD);
+    lod = Math::Clamp(lod, 0.0f, float(desc.numMipLevels - 1));
+
+    // Integer formats can't be filtered, so they always use point sampling.
+    if (!texture->m_formatInfo->isFilterable)
+    {
+        _sampleMipLevel(
+            samplerDesc,
+            TextureFilteringMode::Point,
+            coords,
+            elementIndex,
+            int32_t(lod + 0.5f),
+            outData,
+            dataSize);
+        return;
+    }
+
+    const int32_t baseMipLevel = int32_t(lod);
+    const float mipFraction = lod - float(baseMipLevel);
+    if (samplerDesc.mipFilter == TextureFilteringMode::Point || mipFraction == 0.0f)
+    {
+        const int32_t mipLevel = samplerDesc.mipFilter == TextureFilteringMode::Point
+                                     ? int32_t(lod + 0.5f)
+                                     : baseMipLevel;
+        _sampleMipLevel(samplerDesc, filter, coords, elementIndex, mipLevel, outData, dataSize);
+        return;
+    }
+
+    // Trilinear filtering, blend between the two nearest mip levels.
+    float texels[2][4];
+    _sampleMipLevel(
+        samplerDesc,
+        filter,
+        coords,
+        elementIndex,
+        baseMipLevel,
+        texels[0],
+        sizeof(texels[0]));
+    _sampleMipLevel(
+        samplerDesc,
+        filter,
+        coords,
+        elementIndex,
+        baseMipLevel + 1,
+        texels[1],
+        sizeof(texels[1]));
+
+    float result[4];
+    for (int i = 0; i < 4; ++i)
+        result[i] = texels[0][i] + (texels[1][i] - texels[0][i]) * mipFraction;
+
+    memcpy(outData, result, Math::Min(dataSize, sizeof(result)));
+}
+
+/// Apply the address mode `mode` to the integer texel coordinate `ioCoord` along an axis
+/// of size `extent`. Returns false if the coordinate should read the border color.
+static bool _applyAddressingMode(TextureAddressingMode mode, int32_t extent, int32_t& ioCoord)
+{
+    int32_t coord = ioCoord;
+    switch (mode)
+    {
+    case TextureAddressingMode::Wrap:
+        coord %= extent;
+        if (coord < 0)
+            coord += extent;
+        break;
+
+    case TextureAddressingMode::MirrorRepeat:
+        {
+            const int32_t period = 2 * extent;
+            coord %= period;
+            if (coord < 0)
+                coord += period;
+            if (coord >= extent)
+                coord = period - 1 - coord;
+        }
+        break;
+
+    case TextureAddressingMode::MirrorOnce:
+        if (coord < 0)
+            coord = -1 - coord;
+        coord = Math::Clamp(coord, 0, extent - 1);
+        break;
+
+    case TextureAddressingMode::ClampToBorder:
+        if (coord < 0 || coord >= extent)
+            return false;
+        break;
+
+    case TextureAddressingMode::ClampToEdge:
+    default:
+        coord = Math::Clamp(coord, 0, extent - 1);
+        break;
+    }
+    ioCoord = coord;
+    return true;
+}
+
+void TextureResourceViewImpl::_sampleMipLevel(
+    ISamplerState::Desc const& samplerDesc,
+    TextureFilteringMode filter,
+    const float* coords,
+    int32_t elementIndex,
+    int32_t mipLevel,
+    void* outData,
+    size_t dataSize)
+{
+    TextureResourceImpl* texture = m_texture;
+    const int32_t rank = texture->m_baseShape->rank;
+    auto& mipLevelInfo = texture->m_mipLevels[mipLevel];
+    const TextureAddressingMode addressingModes[] = {
+        samplerDesc.addressU,
+        samplerDesc.addressV,
+        samplerDesc.addressW};
+
+    const int64_t baseOffset = mipLevelInfo.offset + elementIndex * mipLevelInfo.strides[3];
+
+    if (filter == TextureFilteringMode::Point)
+    {
+        int64_t texelOffset = baseOffset;
+        for (int32_t axis = 0; axis < rank; ++axis)
+        {
+            const int32_t extent = mipLevelInfo.extents[axis];
+            int32_t integerCoord = int32_t(floorf(coords[axis] * extent));
+            if (!_applyAddressingMode(addressingModes[axis], extent, integerCoord))
+            {
+                memcpy(
+                    outData,
+                    samplerDesc.borderColor,
+                    Math::Min(dataSize, sizeof(samplerDesc.borderColor)));
+                return;
+            }
+            texelOffset += integerCoord * mipLevelInfo.strides[axis];
+        }
+        auto texelPtr = (char const*)texture->m_data + texelOffset;
+        texture->m_formatInfo->unpackFunc(texelPtr, outData, dataSize);
+        return;
+    }
+
+    // Linear filtering. Along each axis find the two texels surrounding the sample
+    // position and their weights, then blend all the 2^rank corner texels.
+    int32_t cornerCoords[3][2];
+    float cornerWeights[3][2];
+    bool cornerInside[3][2];
+    for (int32_t axis = 0; axis < rank; ++axis)
+    {
+        const int32_t extent = mipLevelInfo.extents[axis];
+        const float texelCoord = coords[axis] * extent - 0.5f;
+        const float texelFloor = floorf(texelCoord);
+        const float fraction = texelCoord - texelFloor;
+
+        for (int i = 0; i < 2; ++i)
+        {
+            cornerCoords[axis][i] = int32_t(texelFloor) + i;
+            cornerInside[axis][i] =
+                _applyAddressingMode(addressingModes[axis], extent, cornerCoords[axis][i]);
+        }
+        cornerWeights[axis][0] = 1.0f - fraction;
+        cornerWeights[axis][1] = fraction;
+    }
+
+    float result[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    const int32_t cornerCount = 1 << rank;
+    for (int32_t corner = 0; corner < cornerCount; ++corner)
+    {
+        float weight = 1.0f;
+        bool isInside = true;
+        int64_t texelOffset = baseOffset;
+        for (int32_t axis = 0; axis < rank; ++axis)
+        {
+            const int i = (corner >> axis) & 1;
+            weight *= cornerWeights[axis][i];
+            isInside = isInside && cornerInside[axis][i];
+            texelOffset += cornerCoords[axis][i] * mipLevelInfo.strides[axis];
+        }
+        if (weight == 0.0f)
+            continue;
+
+        float texel[4];
+        if (isInside)
+        {
+            auto texelPtr = (char const*)texture->m_data + texelOffset;
+            texture->m_formatInfo->unpackFunc(texelPtr, texel, sizeof(texel));
+        }
+        else
+        {
+            memcpy(texel, samplerDesc.borderColor, sizeof(texel));
+        }
+
+        for (int i = 0; i < 4; ++i)
+            result[i] += texel[i] * weight;
+    }
+
+    memcpy(outData, result, Math::Min(dataSize, sizeof(result)));
+}
+
+void TextureResourceViewImpl::_sampleLevelNoSampler(
+    const float* coords,
+    float level,
+    void* outData,
+    size_t dataSize)
 {
     TextureResourceImpl* texture = m_texture;
     auto baseShape = texture->m_baseShape;
     auto& desc = texture->_getDesc();
     int32_t rank = baseShape->rank;
-    int32_t baseCoordCount = baseShape->baseCoordCount;
 
     int32_t integerMipLevel = int32_t(level + 0.5f);
     if (integerMipLevel >= desc.numMipLevels)
@@ -84,20 +333,9 @@ void TextureResourceViewImpl::SampleLevel(
 
     auto& mipLevelInfo = texture->m_mipLevels[integerMipLevel];
 
-    bool isArray = (desc.arraySize != 0) || (desc.type == ITextureResource::Type::TextureCube);
-    int32_t effectiveArrayElementCount = texture->m_effectiveArrayElementCount;
-    int32_t coordIndex = baseCoordCount;
-    int32_t elementIndex = 0;
-    if (isArray)
-    {
-        elementIndex = int32_t(coords[coordIndex++] + 0.5f);
-    }
-    if (elementIndex >= effectiveArrayElementCount)
-        elementIndex = effectiveArrayElementCount - 1;
-    if (elementIndex < 0)
-        elementIndex = 0;
+    int32_t elementIndex = _getSampleArrayElementIndex(coords);
 
-    // Note: for now we are just going to do nearest-neighbor sampling
+    // Without a sampler state we keep to simple nearest-neighbor sampling.
     //
     int64_t texelOffset = mipLevelInfo.offset;
     texelOffset += elementIndex * mipLevelInfo.strides[3];
@@ -106,9 +344,6 @@ void TextureResourceViewImpl::SampleLevel(
         int32_t extent = mipLevelInfo.extents[axis];
 
         float coord = coords[axis];
-
-        // TODO: deal with wrap/clamp/repeat if `coord < 0` or `coord > 1`
-
         int32_t integerCoord = int32_t(coord * (extent - 1) + 0.5f);
 
         if (integerCoord >= extent)
@@ -2,6 +2,7 @@
 #pragma once
 #include "cpu-base.h"
 #include "cpu-buffer.h"
+#include "cpu-sampler.h"
 #include "cpu-texture.h"
 
 namespace gfx
@@ -84,6 +85,28 @@ private:
     RefPtr<TextureResourceImpl> m_texture;
 
     void* _getTexelPtr(int32_t const* texelCoords);
+
+    int32_t _getSampleArrayElementIndex(const float* coords);
+
+    void _sampleLevel(
+        SamplerStateImpl* sampler,
+        const float* coords,
+        float level,
+        void* outData,
+        size_t dataSize);
+
+    // Sample without a sampler state, using nearest-neighbor filtering and clamping.
+    void _sampleLevelNoSampler(const float* coords, float level, void* outData, size_t dataSize);
+
+    // Sample a single mip level with the given filter, applying the sampler address modes.
+    void _sampleMipLevel(
+        ISamplerState::Desc const& samplerDesc,
+        TextureFilteringMode filter,
+        const float* coords,
+        int32_t elementIndex,
+        int32_t mipLevel,
+        void* outData,
+        size_t dataSize);
 };
 
 } // namespace cpu
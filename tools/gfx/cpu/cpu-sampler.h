@@ -0,0 +1,38 @@
+// cpu-sampler.h
+#pragma once
+#include "cpu-base.h"
+
+namespace gfx
+{
+using namespace Slang;
+
+namespace cpu
+{
+
+class SamplerStateImpl : public SamplerStateBase
+{
+public:
+    ISamplerState::Desc m_desc;
+
+    SamplerStateImpl(ISamplerState::Desc const& desc)
+        : m_desc(desc)
+    {
+    }
+
+    // The emitted C++ code only sees `slang_prelude::SamplerState`, which holds an opaque
+    // `ISamplerState` pointer. On the CPU target that pointer is the `SamplerStateImpl`.
+    slang_prelude::SamplerState getPreludeSamplerState()
+    {
+        slang_prelude::SamplerState samplerState;
+        samplerState.state = reinterpret_cast<slang_prelude::ISamplerState*>(this);
+        return samplerState;
+    }
+
+    static SamplerStateImpl* fromPreludeSamplerState(slang_prelude::SamplerState samplerState)
+    {
+        return reinterpret_cast<SamplerStateImpl*>(samplerState.state);
+    }
+};
+
+} // namespace cpu
+} // namespace gfx
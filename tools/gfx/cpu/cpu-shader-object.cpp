@@ -84,6 +84,7 @@ Result ShaderObjectImpl::init(IDevice* device, ShaderObjectLayoutImpl* typeLayou
     // and not just the number of resource/sub-object ranges.
     //
     m_resources.setCount(typeLayout->getResourceCount());
+    m_samplers.setCount(typeLayout->getResourceCount());
     m_objects.setCount(typeLayout->getSubObjectCount());
 
     for (auto subObjectRange : getLayout()->subObjectRanges)
@@ -232,9 +233,22 @@ ShaderObjectImpl::setObject(ShaderOffset const& offset, IShaderObject* object)
 SLANG_NO_THROW Result SLANG_MCALL
 ShaderObjectImpl::setSampler(ShaderOffset const& offset, ISamplerState* sampler)
 {
-    SLANG_UNUSED(sampler);
-    SLANG_UNUSED(offset);
-    return SLANG_OK;
+    auto layout = getLayout();
+
+    auto bindingRangeIndex = offset.bindingRangeIndex;
+    SLANG_ASSERT(bindingRangeIndex >= 0);
+    SLANG_ASSERT(bindingRangeIndex < layout->m_bindingRanges.getCount());
+
+    auto& bindingRange = layout->m_bindingRanges[bindingRangeIndex];
+    auto samplerIndex = bindingRange.baseIndex + offset.bindingArrayIndex;
+
+    auto samplerImpl = static_cast<SamplerStateImpl*>(sampler);
+    m_samplers[samplerIndex] = samplerImpl;
+
+    slang_prelude::SamplerState samplerObj = {};
+    if (samplerImpl)
+        samplerObj = samplerImpl->getPreludeSamplerState();
+    return setData(offset, &samplerObj, sizeof(samplerObj));
 }
 
 SLANG_NO_THROW Result SLANG_MCALL ShaderObjectImpl::setCombinedTextureSampler(
@@ -1,6 +1,7 @@
 // cpu-shader-object.h
 #pragma once
 #include "cpu-base.h"
+#include "cpu-sampler.h"
 #include "cpu-shader-object-layout.h"
 
 namespace gfx
@@ -40,6 +41,8 @@ class ShaderObjectImpl
 
 public:
     List<RefPtr<ResourceViewImpl>> m_resources;
+    // Samplers share the resource slot numbering with `m_resources`.
+    List<RefPtr<SamplerStateImpl>> m_samplers;
 
     virtual SLANG_NO_THROW Result SLANG_MCALL
     init(IDevice* device, ShaderObjectLayoutImpl* typeLayout);
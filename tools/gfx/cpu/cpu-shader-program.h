@@ -15,6 +15,10 @@ class ShaderProgramImpl : public ShaderProgramBase
 public:
     RefPtr<RootShaderObjectLayoutImpl> layout;
 
+    // The compiled host callable for the program's entry point, cached so that repeated
+    // dispatches with the same program don't need to query the compiler.
+    ComPtr<ISlangSharedLibrary> hostCallable;
+
     ~ShaderProgramImpl() {}
 };
 
@@ -33,6 +33,8 @@ typedef void (*CPUTextureUnpackFunc)(void const* texelData, void* outData, size_
 struct CPUTextureFormatInfo
 {
     CPUTextureUnpackFunc unpackFunc;
+    // True if the format unpacks to floats, and so can be linearly filtered.
+    bool isFilterable;
 };
 
 template<int N>
@@ -72,15 +74,16 @@ struct CPUFormatInfoMap
 
         set(Format::R8G8B8A8_UNORM, &_unpackUnorm8Texel<4>);
         set(Format::B8G8R8A8_UNORM, &_unpackUnormBGRA8Texel);
-        set(Format::R16_UINT, &_unpackUInt16Texel<1>);
-        set(Format::R32_UINT, &_unpackUInt32Texel<1>);
+        set(Format::R16_UINT, &_unpackUInt16Texel<1>, false);
+        set(Format::R32_UINT, &_unpackUInt32Texel<1>, false);
         set(Format::D32_FLOAT, &_unpackFloatTexel<1>);
     }
 
-    void set(Format format, CPUTextureUnpackFunc func)
+    void set(Format format, CPUTextureUnpackFunc func, bool isFilterable = true)
     {
         auto& info = m_infos[Index(format)];
         info.unpackFunc = func;
+        info.isFilterable = isFilterable;
     }
     SLANG_FORCE_INLINE const CPUTextureFormatInfo& get(Format format) const
     {
@@ -1,12 +1,16 @@
 #include "renderer-shared.h"
 
 #include "../../source/core/slang-file-system.h"
+#include "../../source/core/slang-process.h"
+#include "../../source/core/slang-shared-library.h"
 #include "../../source/core/slang-stable-hash.h"
 #include "core/slang-io.h"
 #include "core/slang-token-reader.h"
 #include "mutable-shader-object.h"
 #include "slang.h"
 
+#include <atomic>
+
 using namespace Slang;
 
 namespace gfx
@@ -395,6 +399,93 @@ Result RendererBase::getEntryPointCodeFromShaderCache(
     return SLANG_OK;
 }
 
+// Write `blob` to the file at `path`. The data is written to a file of its own first, and then
+// renamed, so that other threads and processes never load a partially written file.
+static Result _writeFileByRename(const String& path, ISlangBlob* blob)
+{
+    static std::atomic<uint32_t> tempFileCounter;
+
+    StringBuilder tempPath;
+    tempPath << path << "." << Process::getId() << "-" << tempFileCounter++ << ".tmp";
+
+    Result result = File::writeAllBytes(tempPath, blob->getBufferPointer(), blob->getBufferSize());
+    if (SLANG_SUCCEEDED(result))
+        result = File::rename(tempPath, path);
+    if (SLANG_FAILED(result))
+        File::remove(tempPath);
+    return result;
+}
+
+Result RendererBase::getEntryPointHostCallableFromShaderCache(
+    slang::IComponentType* program,
+    SlangInt entryPointIndex,
+    SlangInt targetIndex,
+    ISlangSharedLibrary** outSharedLibrary,
+    slang::IBlob** outDiagnostics)
+{
+    // Immediately call getEntryPointHostCallable if no shader cache has been initialized
+    if (!persistentShaderCache)
+    {
+        return program->getEntryPointHostCallable(
+            (int)entryPointIndex,
+            (int)targetIndex,
+            outSharedLibrary,
+            outDiagnostics);
+    }
+
+    ComPtr<ISlangBlob> hashBlob;
+    program->getEntryPointHash(entryPointIndex, targetIndex, hashBlob.writeRef());
+    PersistentCache::Key cacheKey(hashBlob);
+
+    // The shared library has to exist as a file to be loaded, so we materialize the
+    // cached binary in the directory the cache keeps for files derived from the entry.
+    // That directory is removed along with the entry when the entry is evicted.
+    const String libraryDirectory = persistentShaderCache->getEntryFilesDirectory(cacheKey);
+    const String libraryPath = SharedLibrary::calcPlatformPath(
+        Path::combine(libraryDirectory, "host-callable").getUnownedSlice());
+
+    auto loader = DefaultSharedLibraryLoader::getSingleton();
+
+    ComPtr<ISlangBlob> libraryBlob;
+    if (persistentShaderCache->readEntry(cacheKey, libraryBlob.writeRef()) == SLANG_OK)
+    {
+        if (File::exists(libraryPath) &&
+            SLANG_SUCCEEDED(
+                loader->loadPlatformSharedLibrary(libraryPath.getBuffer(), outSharedLibrary)))
+        {
+            return SLANG_OK;
+        }
+
+        // The file is missing, or couldn't be loaded (e.g. it was left incomplete by an
+        // older version), so write it again from the cached binary.
+        Path::createDirectory(libraryDirectory);
+        if (SLANG_SUCCEEDED(_writeFileByRename(libraryPath, libraryBlob)) &&
+            SLANG_SUCCEEDED(
+                loader->loadPlatformSharedLibrary(libraryPath.getBuffer(), outSharedLibrary)))
+        {
+            return SLANG_OK;
+        }
+
+        // The cached binary itself can't be loaded (e.g. it is corrupt, or was built for a
+        // different platform), so fall through and compile it again.
+    }
+
+    // No usable cached entry. Compile the library, and add its binary to the cache.
+    // The component type caches the compiled artifact, so asking for both the code
+    // and the host callable only invokes the downstream compiler once.
+    SLANG_RETURN_ON_FAIL(program->getEntryPointHostCallable(
+        (int)entryPointIndex,
+        (int)targetIndex,
+        outSharedLibrary,
+        outDiagnostics));
+    if (SLANG_SUCCEEDED(
+            program->getEntryPointCode(entryPointIndex, targetIndex, libraryBlob.writeRef())))
+    {
+        persistentShaderCache->writeEntry(cacheKey, libraryBlob);
+    }
+    return SLANG_OK;
+}
+
 SlangResult RendererBase::queryInterface(SlangUUID const& uuid, void** outObject)
 {
     // Only return the shader cache interface if it is enabled.
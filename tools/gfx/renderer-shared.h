@@ -1350,6 +1350,17 @@ public:
         slang::IBlob** outCode,
         slang::IBlob** outDiagnostics = nullptr);
 
+    /// Get a host callable shared library for an entry point, going through the
+    /// persistent shader cache (if enabled). On a cache hit the cached library is
+    /// written next to the cache entries and loaded directly, without invoking the
+    /// downstream compiler.
+    Result getEntryPointHostCallableFromShaderCache(
+        slang::IComponentType* program,
+        SlangInt entryPointIndex,
+        SlangInt targetIndex,
+        ISlangSharedLibrary** outSharedLibrary,
+        slang::IBlob** outDiagnostics = nullptr);
+
     Result getShaderObjectLayout(
         slang::ISession* session,
         slang::TypeReflection* type,
@@ -0,0 +1,119 @@
+// unit-test-concurrent-session.cpp
+
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <thread>
+
+using namespace Slang;
+
+// Test compiling permutations of one loaded module from several threads, using a session
+// created with `EnableConcurrentSessionAccess`.
+
+static SlangResult _compilePermutation(slang::ISession* session, slang::IModule* module, int index)
+{
+    StringBuilder entryPointName;
+    entryPointName << "computeMain<X" << index << ">";
+
+    ComPtr<slang::IBlob> diagnostics;
+    ComPtr<slang::IEntryPoint> entryPoint;
+    SLANG_RETURN_ON_FAIL(module->findAndCheckEntryPoint(
+        entryPointName.getBuffer(),
+        SLANG_STAGE_COMPUTE,
+        entryPoint.writeRef(),
+        diagnostics.writeRef()));
+
+    slang::IComponentType* components[] = {module, entryPoint.get()};
+    ComPtr<slang::IComponentType> composite;
+    SLANG_RETURN_ON_FAIL(session->createCompositeComponentType(
+        components,
+        SLANG_COUNT_OF(components),
+        composite.writeRef(),
+        diagnostics.writeRef()));
+
+    ComPtr<slang::IComponentType> linked;
+    SLANG_RETURN_ON_FAIL(composite->link(linked.writeRef(), diagnostics.writeRef()));
+
+    ComPtr<slang::IBlob> code;
+    SLANG_RETURN_ON_FAIL(linked->getEntryPointCode(0, 0, code.writeRef(), diagnostics.writeRef()));
+
+    // Each permutation writes its own value
+    StringBuilder value;
+    value << (index + 100);
+    const UnownedStringSlice text((const char*)code->getBufferPointer(), code->getBufferSize());
+    return text.indexOf(value.getUnownedSlice()) >= 0 ? SLANG_OK : SLANG_FAIL;
+}
+
+SLANG_UNIT_TEST(concurrentSession)
+{
+    const char* source = R"(
+        interface I { int getValue(); }
+        struct X0 : I { int getValue() { return 100; } }
+        struct X1 : I { int getValue() { return 101; } }
+        struct X2 : I { int getValue() { return 102; } }
+        struct X3 : I { int getValue() { return 103; } }
+
+        RWStructuredBuffer<int> outputBuffer;
+
+        [numthreads(4, 1, 1)]
+        void computeMain<T : I>(uint3 tid : SV_DispatchThreadID)
+        {
+            T t;
+            outputBuffer[tid.x] = t.getValue();
+        })";
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(
+        slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+
+    slang::CompilerOptionEntry concurrentEntry;
+    concurrentEntry.name = slang::CompilerOptionName::EnableConcurrentSessionAccess;
+    concurrentEntry.value.kind = slang::CompilerOptionValueKind::Int;
+    concurrentEntry.value.intValue0 = 1;
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.compilerOptionEntries = &concurrentEntry;
+    sessionDesc.compilerOptionEntryCount = 1;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> diagnostics;
+    ComPtr<slang::IModule> module(
+        session->loadModuleFromSourceString("m", "m.slang", source, diagnostics.writeRef()));
+    SLANG_CHECK_ABORT(module);
+
+    const int threadCount = 4;
+    const int iterationCount = 4;
+
+    SlangResult results[threadCount];
+    std::thread threads[threadCount];
+    for (int i = 0; i < threadCount; ++i)
+    {
+        threads[i] = std::thread(
+            [&, i]()
+            {
+                SlangResult result = SLANG_OK;
+                for (int j = 0; j < iterationCount && SLANG_SUCCEEDED(result); ++j)
+                {
+                    result = _compilePermutation(session, module, (i + j) % threadCount);
+                }
+                results[i] = result;
+            });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (auto result : results)
+    {
+        SLANG_CHECK(SLANG_SUCCEEDED(result));
+    }
+}
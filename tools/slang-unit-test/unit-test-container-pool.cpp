@@ -0,0 +1,112 @@
+// unit-test-container-pool.cpp
+
+#include "../../source/slang/slang-container-pool.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+SLANG_UNIT_TEST(containerPool)
+{
+    ContainerPool pool;
+
+    int values[4] = {0, 1, 2, 3};
+
+    // A list handed back to the pool is cleared, and is the next one handed out
+    List<int*>* firstList = nullptr;
+    {
+        PooledList<int> list(pool);
+        for (auto& value : values)
+            list->add(&value);
+        SLANG_CHECK(list->getCount() == 4);
+        firstList = list.m_list;
+    }
+    {
+        PooledList<int> list(pool);
+        SLANG_CHECK(list.m_list == firstList);
+        SLANG_CHECK(list->getCount() == 0);
+
+        // Taking another while the first is in use creates a new one
+        PooledList<int> otherList(pool);
+        SLANG_CHECK(otherList.m_list != firstList);
+    }
+
+    {
+        PooledHashSet<int> set(pool);
+        set->add(&values[0]);
+        SLANG_CHECK(set->contains(&values[0]));
+    }
+    {
+        PooledHashSet<int> set(pool);
+        SLANG_CHECK(set->getCount() == 0);
+    }
+
+    // A UIntSet handed back is cleared, but keeps its buffer
+    {
+        PooledUIntSet set(pool);
+        set->add(100);
+        SLANG_CHECK(set->contains(100));
+    }
+    {
+        PooledUIntSet set(pool);
+        SLANG_CHECK(set->isEmpty());
+        SLANG_CHECK(set->getCount() > 100);
+    }
+
+    {
+        const auto stats = pool.getStats();
+        SLANG_CHECK(stats.takenCount == 7);
+        SLANG_CHECK(stats.reusedCount == 3);
+        // The reused list kept room for at least its 4 elements, the hash set for its 1, and the
+        // UIntSet for the value 100
+        SLANG_CHECK(stats.reusedByteCount >= 5 * sizeof(int*) + 100 / 8);
+    }
+
+    // A list that grew too large has its memory freed when it is handed back
+    {
+        {
+            PooledList<int> list(pool);
+            list->setCount(ContainerPool::kMaxRetainedElementCount + 1);
+        }
+        PooledList<int> list(pool);
+        SLANG_CHECK(list->getCapacity() == 0);
+    }
+
+    // A UIntSet that grew too large has its memory freed when it is handed back
+    {
+        {
+            PooledUIntSet set(pool);
+            set->add(UInt(ContainerPool::kMaxRetainedElementCount) * 64);
+        }
+        PooledUIntSet set(pool);
+        SLANG_CHECK(set->getCount() == 0);
+    }
+
+    // Only a limited number of free containers are kept
+    {
+        const Index maxFreeCount = ObjectPool<List<void*>>::kMaxFreeObjectCount;
+        List<List<int*>*> lists;
+        for (Index i = 0; i < maxFreeCount + 8; ++i)
+            lists.add(pool.getList<int>());
+        for (auto list : lists)
+            pool.free(list);
+        SLANG_CHECK(pool.m_listPool.m_freeObjects.getCount() == maxFreeCount);
+        // The ones that weren't kept were deleted
+        SLANG_CHECK(pool.m_listPool.m_objects.getCount() == maxFreeCount);
+    }
+
+    // Memory from the scratch arena is given back at the end of the scope that allocated it
+    {
+        const void* cursor = pool.m_scratchArena.getCursor();
+        {
+            ScratchArenaScope scope(pool);
+            auto indices = scope.getArena().allocateAndZeroArray<Index>(64);
+            SLANG_CHECK(indices[63] == 0);
+            {
+                ScratchArenaScope innerScope(pool);
+                innerScope.getArena().allocateArray<Index>(ContainerPool::kScratchArenaBlockSize);
+            }
+            SLANG_CHECK(pool.m_scratchArena.isValid(indices, sizeof(Index) * 64));
+        }
+        SLANG_CHECK(pool.m_scratchArena.getCursor() == cursor);
+    }
+}
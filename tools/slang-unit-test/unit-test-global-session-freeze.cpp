@@ -0,0 +1,93 @@
+// unit-test-global-session-freeze.cpp
+
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+static SlangResult _compileWithSession(slang::IGlobalSession* globalSession, const char* source)
+{
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+
+    ComPtr<slang::ISession> session;
+    SLANG_RETURN_ON_FAIL(globalSession->createSession(sessionDesc, session.writeRef()));
+
+    ComPtr<slang::IBlob> diagnostics;
+    auto module =
+        session->loadModuleFromSourceString("m", "m.slang", source, diagnostics.writeRef());
+    if (!module)
+        return SLANG_FAIL;
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    SLANG_RETURN_ON_FAIL(module->findEntryPointByName("computeMain", entryPoint.writeRef()));
+
+    slang::IComponentType* components[] = {module, entryPoint.get()};
+    ComPtr<slang::IComponentType> composite;
+    SLANG_RETURN_ON_FAIL(session->createCompositeComponentType(
+        components,
+        SLANG_COUNT_OF(components),
+        composite.writeRef()));
+
+    ComPtr<slang::IComponentType> linked;
+    SLANG_RETURN_ON_FAIL(composite->link(linked.writeRef()));
+
+    ComPtr<slang::IBlob> code;
+    SLANG_RETURN_ON_FAIL(linked->getEntryPointCode(0, 0, code.writeRef(), diagnostics.writeRef()));
+    return (code && code->getBufferSize()) ? SLANG_OK : SLANG_FAIL;
+}
+
+SLANG_UNIT_TEST(globalSessionFreeze)
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(
+        slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    SLANG_CHECK(slang_freezeGlobalSession(globalSession) == SLANG_OK);
+    // Freezing again is allowed
+    SLANG_CHECK(slang_freezeGlobalSession(globalSession) == SLANG_OK);
+
+    // Each compile creates names that aren't in the frozen pool
+    const char* sources[] = {
+        R"(
+        [shader("compute")]
+        [numthreads(4,1,1)]
+        void computeMain(
+            uint3 tid : SV_DispatchThreadID,
+            uniform RWStructuredBuffer<int> frozenA)
+        {
+            frozenA[tid.x] = int(tid.x);
+        })",
+        R"(
+        struct FrozenStruct { int frozenField; }
+        [shader("compute")]
+        [numthreads(4,1,1)]
+        void computeMain(
+            uint3 tid : SV_DispatchThreadID,
+            uniform RWStructuredBuffer<FrozenStruct> frozenB)
+        {
+            frozenB[tid.x].frozenField = int(tid.x);
+        })",
+    };
+    for (auto source : sources)
+    {
+        SLANG_CHECK(SLANG_SUCCEEDED(_compileWithSession(globalSession, source)));
+    }
+
+    // The builtin modules can no longer be changed
+    SLANG_CHECK(
+        globalSession->compileBuiltinModule(slang::BuiltinModuleName::GLSL, 0) ==
+        SLANG_E_NOT_AVAILABLE);
+
+    // A session without a core module can't be frozen
+    ComPtr<slang::IGlobalSession> emptyGlobalSession;
+    SLANG_CHECK_ABORT(
+        slang_createGlobalSessionWithoutCoreModule(
+            SLANG_API_VERSION,
+            emptyGlobalSession.writeRef()) == SLANG_OK);
+    SLANG_CHECK(slang_freezeGlobalSession(emptyGlobalSession) == SLANG_E_NOT_AVAILABLE);
+}
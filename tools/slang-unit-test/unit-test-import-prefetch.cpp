@@ -0,0 +1,121 @@
+// unit-test-import-prefetch.cpp
+
+#include "../../source/core/slang-io.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test that a module graph with shared imports compiles as expected, both with and without
+// `-prefetch-imports` reading the imported modules ahead of checking.
+static void _compileWithPrefetch(
+    UnitTestContext* unitTestContext,
+    const String& searchPath,
+    bool prefetchImports)
+{
+    String userSource = R"(
+        import prefetchA;
+        import prefetchB;
+
+        [shader("compute")]
+        [numthreads(4,1,1)]
+        void computeMain(
+            uint3 sv_dispatchThreadID : SV_DispatchThreadID,
+            uniform RWStructuredBuffer<int> buffer)
+        {
+            buffer[sv_dispatchThreadID.x] = a() + b();
+        })";
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+
+    slang::CompilerOptionEntry prefetchEntry;
+    prefetchEntry.name = slang::CompilerOptionName::PrefetchImports;
+    prefetchEntry.value.kind = slang::CompilerOptionValueKind::Int;
+    prefetchEntry.value.intValue0 = prefetchImports ? 1 : 0;
+
+    const char* searchPaths[] = {searchPath.getBuffer()};
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.searchPaths = searchPaths;
+    sessionDesc.searchPathCount = 1;
+    sessionDesc.compilerOptionEntries = &prefetchEntry;
+    sessionDesc.compilerOptionEntryCount = 1;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(
+        unitTestContext->slangGlobalSession->createSession(sessionDesc, session.writeRef()) ==
+        SLANG_OK);
+
+    ComPtr<slang::IBlob> diagnostics;
+    auto module = session->loadModuleFromSourceString(
+        "user",
+        "user.slang",
+        userSource.getBuffer(),
+        diagnostics.writeRef());
+    SLANG_CHECK_ABORT(module);
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    module->findEntryPointByName("computeMain", entryPoint.writeRef());
+    SLANG_CHECK_ABORT(entryPoint);
+
+    slang::IComponentType* components[] = {module, entryPoint.get()};
+    ComPtr<slang::IComponentType> composite;
+    SLANG_CHECK_ABORT(
+        session->createCompositeComponentType(
+            components,
+            SLANG_COUNT_OF(components),
+            composite.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IComponentType> linked;
+    SLANG_CHECK_ABORT(composite->link(linked.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> code;
+    SLANG_CHECK(
+        linked->getEntryPointCode(0, 0, code.writeRef(), diagnostics.writeRef()) == SLANG_OK);
+    SLANG_CHECK(code && code->getBufferSize() != 0);
+
+    // `C` must only have been loaded once, even though it was imported (and prefetched) twice.
+    Index loadedCount = 0;
+    for (SlangInt i = 0; i < session->getLoadedModuleCount(); ++i)
+    {
+        auto name = session->getLoadedModule(i)->getName();
+        if (name && UnownedStringSlice(name) == toSlice("prefetchC"))
+            loadedCount++;
+    }
+    SLANG_CHECK(loadedCount == 1);
+}
+
+SLANG_UNIT_TEST(importPrefetch)
+{
+    // Write the modules into a directory of their own, named after a unique temporary file
+    String tempPath;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(File::generateTemporary(toSlice("slang-import-prefetch"), tempPath)));
+    const String dirPath = tempPath + "-modules";
+    SLANG_CHECK_ABORT(Path::createDirectory(dirPath));
+
+    const String pathA = Path::combine(dirPath, "prefetchA.slang");
+    const String pathB = Path::combine(dirPath, "prefetchB.slang");
+    const String pathC = Path::combine(dirPath, "prefetchC.slang");
+
+    // `A` and `B` both import `C`. `B` also has an import in a comment, that the prefetcher
+    // may find but must not affect compilation.
+    File::writeAllText(pathA, "import prefetchC;\npublic int a() { return c() + 1; }\n");
+    File::writeAllText(
+        pathB,
+        "// import missingModule;\nimport prefetchC;\npublic int b() { return c() + 2; }\n");
+    File::writeAllText(pathC, "public int c() { return 3; }\n");
+
+    _compileWithPrefetch(unitTestContext, dirPath, false);
+    _compileWithPrefetch(unitTestContext, dirPath, true);
+
+    File::remove(pathA);
+    File::remove(pathB);
+    File::remove(pathC);
+    Path::remove(dirPath);
+    File::remove(tempPath);
+}
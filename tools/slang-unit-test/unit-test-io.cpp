@@ -1,8 +1,17 @@
 // unit-test-io.cpp
 
+#include "../../source/core/slang-file-system.h"
 #include "../../source/core/slang-io.h"
 #include "unit-test/slang-unit-test.h"
 
+#if defined(__linux__) || defined(__CYGWIN__) || SLANG_APPLE_FAMILY
+#include <sys/stat.h>
+#include <unistd.h>
+#define SLANG_CHECK_POSIX_FILES 1
+#else
+#define SLANG_CHECK_POSIX_FILES 0
+#endif
+
 using namespace Slang;
 
 static SlangResult _checkGenerateTemporary()
@@ -57,7 +66,69 @@ static SlangResult _checkGenerateTemporary()
     return SLANG_OK;
 }
 
+static SlangResult _checkLoadLargeFile()
+{
+    /// Large files may be loaded by mapping them, which shouldn't be observable
+
+    String path;
+    SLANG_RETURN_ON_FAIL(File::generateTemporary(toSlice("slang-check"), path));
+
+    StringBuilder contents;
+    while (size_t(contents.getLength()) < OSFileSystem::kMinMappedFileSize * 2)
+    {
+        contents << "line " << contents.getLength() << "\n";
+    }
+    // Only sizes that aren't a multiple of the page size can be mapped
+#if SLANG_CHECK_POSIX_FILES
+    const Index pageSize = Index(::sysconf(_SC_PAGESIZE));
+    if (pageSize > 0 && contents.getLength() % pageSize == 0)
+    {
+        contents << "\n";
+    }
+#endif
+
+    ISlangMutableFileSystem* fileSystem = OSFileSystem::getMutableSingleton();
+    SLANG_RETURN_ON_FAIL(
+        fileSystem->saveFile(path.getBuffer(), contents.getBuffer(), contents.getLength()));
+
+    ComPtr<ISlangBlob> blob;
+    SLANG_RETURN_ON_FAIL(fileSystem->loadFile(path.getBuffer(), blob.writeRef()));
+    SLANG_CHECK(StringUtil::getSlice(blob) == contents.getUnownedSlice());
+
+    // The contents are zero terminated, however they were loaded
+    ComPtr<ICastable> castable;
+    SLANG_RETURN_ON_FAIL(blob->queryInterface(SLANG_IID_PPV_ARGS(castable.writeRef())));
+    SLANG_CHECK(castable->castAs(SlangTerminatedChars::getTypeGuid()) != nullptr);
+
+#if SLANG_CHECK_POSIX_FILES
+    SLANG_CHECK(::chmod(path.getBuffer(), 0640) == 0);
+#endif
+
+    // Saving over the file doesn't change what was loaded
+    SLANG_RETURN_ON_FAIL(fileSystem->saveFile(path.getBuffer(), "replaced", 8));
+    SLANG_CHECK(StringUtil::getSlice(blob) == contents.getUnownedSlice());
+
+    {
+        String replaced;
+        SLANG_RETURN_ON_FAIL(File::readAllText(path, replaced));
+        SLANG_CHECK(replaced == "replaced");
+    }
+
+#if SLANG_CHECK_POSIX_FILES
+    // The replaced file keeps its permissions
+    struct stat fileStat;
+    SLANG_CHECK(::stat(path.getBuffer(), &fileStat) == 0 && (fileStat.st_mode & 0777) == 0640);
+#endif
+
+    castable.setNull();
+    blob.setNull();
+    SLANG_CHECK(SLANG_SUCCEEDED(File::remove(path)));
+
+    return SLANG_OK;
+}
+
 SLANG_UNIT_TEST(io)
 {
     SLANG_CHECK(SLANG_SUCCEEDED(_checkGenerateTemporary()));
+    SLANG_CHECK(SLANG_SUCCEEDED(_checkLoadLargeFile()));
 }
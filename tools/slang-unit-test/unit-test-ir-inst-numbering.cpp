@@ -0,0 +1,111 @@
+// unit-test-ir-inst-numbering.cpp
+
+#include "../../source/slang/slang-ir-inst-numbering.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test that the numbers given by IRInstNumbering are only trusted for the blocks and instructions
+// they were given to, so that instructions created after the numbering was built, or whose
+// `scratchData` was written by other code, have no number.
+//
+// IR can't be built from outside of the compiler, so the instructions here are only stand-ins,
+// and are numbered the way `IRInstNumbering::build` numbers the blocks and instructions it visits.
+
+namespace
+{ // anonymous
+
+struct TestInstNumbering : IRInstNumbering
+{
+    void numberBlock(IRBlock* block) { _numberBlock(block); }
+    void numberInst(IRInst* inst) { _numberInst(inst); }
+};
+
+} // namespace
+
+SLANG_UNIT_TEST(irInstNumbering)
+{
+    IRBlock blocks[2] = {};
+    IRInst insts[4] = {};
+
+    TestInstNumbering numbering;
+    for (auto& block : blocks)
+        numbering.numberBlock(&block);
+    for (auto& inst : insts)
+        numbering.numberInst(&inst);
+
+    SLANG_CHECK(numbering.getBlockCount() == 2);
+    SLANG_CHECK(numbering.getInstCount() == 4);
+
+    // Numbers are dense, in the order given, and map back to what they number
+    for (Index i = 0; i < 2; ++i)
+    {
+        SLANG_CHECK(numbering.getBlockIndex(&blocks[i]) == i);
+        SLANG_CHECK(numbering.getBlock(i) == &blocks[i]);
+    }
+    for (Index i = 0; i < 4; ++i)
+    {
+        SLANG_CHECK(numbering.getInstIndex(&insts[i]) == i);
+        SLANG_CHECK(numbering.getInst(i) == &insts[i]);
+    }
+
+    SLANG_CHECK(numbering.getBlockIndex(nullptr) == IRInstNumbering::kInvalidIndex);
+
+    // A block has no instruction number, even though its scratchData holds a number that is in
+    // range for instructions
+    SLANG_CHECK(numbering.getInstIndex(&blocks[0]) == IRInstNumbering::kInvalidIndex);
+
+    // An instruction created after the numbering was built has no number
+    {
+        IRInst newInst = {};
+        SLANG_CHECK(numbering.getInstIndex(&newInst) == IRInstNumbering::kInvalidIndex);
+
+        IRBlock newBlock = {};
+        SLANG_CHECK(numbering.getBlockIndex(&newBlock) == IRInstNumbering::kInvalidIndex);
+
+        // Even if its scratchData happens to hold the number of another instruction
+        newInst.scratchData = insts[2].scratchData;
+        SLANG_CHECK(numbering.getInstIndex(&newInst) == IRInstNumbering::kInvalidIndex);
+        SLANG_CHECK(numbering.getInstIndex(&insts[2]) == 2);
+    }
+
+    // Other code writing scratchData invalidates the numbers of only what it writes to
+    {
+        insts[1].scratchData = 0;
+        insts[3].scratchData = 0x1000;
+        blocks[1].scratchData = 1;
+
+        SLANG_CHECK(numbering.getInstIndex(&insts[0]) == 0);
+        SLANG_CHECK(numbering.getInstIndex(&insts[1]) == IRInstNumbering::kInvalidIndex);
+        SLANG_CHECK(numbering.getInstIndex(&insts[2]) == 2);
+        SLANG_CHECK(numbering.getInstIndex(&insts[3]) == IRInstNumbering::kInvalidIndex);
+
+        SLANG_CHECK(numbering.getBlockIndex(&blocks[0]) == 0);
+        SLANG_CHECK(numbering.getBlockIndex(&blocks[1]) == IRInstNumbering::kInvalidIndex);
+    }
+
+    // Sets of instructions only hold instructions with numbers
+    {
+        UIntSet set;
+        SLANG_CHECK(numbering.addInst(set, &insts[0]));
+        SLANG_CHECK(!numbering.addInst(set, &insts[1]));
+        SLANG_CHECK(numbering.addInst(set, &insts[2]));
+
+        SLANG_CHECK(numbering.containsInst(set, &insts[0]));
+        SLANG_CHECK(!numbering.containsInst(set, &insts[1]));
+        SLANG_CHECK(numbering.containsInst(set, &insts[2]));
+        SLANG_CHECK(!numbering.containsInst(set, &insts[3]));
+    }
+
+    // Clearing the numbering invalidates every number
+    numbering.clear();
+    SLANG_CHECK(numbering.getInstIndex(&insts[0]) == IRInstNumbering::kInvalidIndex);
+    SLANG_CHECK(numbering.getBlockIndex(&blocks[0]) == IRInstNumbering::kInvalidIndex);
+
+    // Numbering again gives numbers back, from 0
+    numbering.numberBlock(&blocks[1]);
+    numbering.numberInst(&insts[3]);
+    SLANG_CHECK(numbering.getBlockIndex(&blocks[1]) == 0);
+    SLANG_CHECK(numbering.getInstIndex(&insts[3]) == 0);
+    SLANG_CHECK(numbering.getInstIndex(&insts[0]) == IRInstNumbering::kInvalidIndex);
+}
@@ -0,0 +1,223 @@
+// unit-test-json-native-decoder-benchmark.cpp
+
+#include "../../source/compiler-core/slang-json-lexer.h"
+#include "../../source/compiler-core/slang-json-native-decoder.h"
+#include "../../source/compiler-core/slang-json-native.h"
+#include "../../source/compiler-core/slang-json-rpc.h"
+#include "../../source/core/slang-blob.h"
+#include "../../source/core/slang-rtti-info.h"
+#include "../../tools/platform/performance-counter.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Compare the time taken to turn a large `textDocument/didChange`-like message into native
+// types, by parsing into a JSONContainer and converting with JSONToNativeConverter, and by
+// decoding directly with JSONToNativeDecoder from the text in place (as JSONRPCConnection does).
+
+namespace
+{ // anonymous
+
+struct BenchPosition
+{
+    int line = 0;
+    int character = 0;
+
+    bool operator==(const BenchPosition& rhs) const
+    {
+        return line == rhs.line && character == rhs.character;
+    }
+
+    static const StructRttiInfo g_rttiInfo;
+};
+
+static const StructRttiInfo _makeBenchPositionRtti()
+{
+    BenchPosition obj;
+    StructRttiBuilder builder(&obj, "BenchPosition", nullptr);
+    builder.addField("line", &obj.line);
+    builder.addField("character", &obj.character);
+    return builder.make();
+}
+/* static */ const StructRttiInfo BenchPosition::g_rttiInfo = _makeBenchPositionRtti();
+
+struct BenchRange
+{
+    BenchPosition start;
+    BenchPosition end;
+
+    bool operator==(const BenchRange& rhs) const { return start == rhs.start && end == rhs.end; }
+
+    static const StructRttiInfo g_rttiInfo;
+};
+
+static const StructRttiInfo _makeBenchRangeRtti()
+{
+    BenchRange obj;
+    StructRttiBuilder builder(&obj, "BenchRange", nullptr);
+    builder.addField("start", &obj.start);
+    builder.addField("end", &obj.end);
+    return builder.make();
+}
+/* static */ const StructRttiInfo BenchRange::g_rttiInfo = _makeBenchRangeRtti();
+
+struct BenchContentChange
+{
+    BenchRange range;
+    String text;
+
+    bool operator==(const BenchContentChange& rhs) const
+    {
+        return range == rhs.range && text == rhs.text;
+    }
+    bool operator!=(const BenchContentChange& rhs) const { return !(*this == rhs); }
+
+    static const StructRttiInfo g_rttiInfo;
+};
+
+static const StructRttiInfo _makeBenchContentChangeRtti()
+{
+    BenchContentChange obj;
+    StructRttiBuilder builder(&obj, "BenchContentChange", nullptr);
+    builder.addField("range", &obj.range, StructRttiInfo::Flag::Optional);
+    builder.addField("text", &obj.text);
+    builder.ignoreUnknownFields();
+    return builder.make();
+}
+/* static */ const StructRttiInfo BenchContentChange::g_rttiInfo = _makeBenchContentChangeRtti();
+
+struct BenchDocument
+{
+    String uri;
+    int version = 0;
+
+    bool operator==(const BenchDocument& rhs) const
+    {
+        return uri == rhs.uri && version == rhs.version;
+    }
+
+    static const StructRttiInfo g_rttiInfo;
+};
+
+static const StructRttiInfo _makeBenchDocumentRtti()
+{
+    BenchDocument obj;
+    StructRttiBuilder builder(&obj, "BenchDocument", nullptr);
+    builder.addField("uri", &obj.uri);
+    builder.addField("version", &obj.version);
+    return builder.make();
+}
+/* static */ const StructRttiInfo BenchDocument::g_rttiInfo = _makeBenchDocumentRtti();
+
+struct BenchDidChangeParams
+{
+    BenchDocument textDocument;
+    List<BenchContentChange> contentChanges;
+
+    bool operator==(const BenchDidChangeParams& rhs) const
+    {
+        return textDocument == rhs.textDocument && contentChanges == rhs.contentChanges;
+    }
+
+    static const StructRttiInfo g_rttiInfo;
+};
+
+static const StructRttiInfo _makeBenchDidChangeParamsRtti()
+{
+    BenchDidChangeParams obj;
+    StructRttiBuilder builder(&obj, "BenchDidChangeParams", nullptr);
+    builder.addField("textDocument", &obj.textDocument);
+    builder.addField("contentChanges", &obj.contentChanges);
+    return builder.make();
+}
+/* static */ const StructRttiInfo BenchDidChangeParams::g_rttiInfo =
+    _makeBenchDidChangeParamsRtti();
+
+} // namespace
+
+SLANG_UNIT_TEST(jsonNativeDecoderBenchmark)
+{
+    // Many small edits, followed by a change that replaces the whole document
+    StringBuilder json;
+    json << "{ \"textDocument\" : { \"uri\" : \"file:///bench.slang\", \"version\" : 42 },\n"
+         << "  \"contentChanges\" : [\n";
+    for (int i = 0; i < 500; ++i)
+    {
+        json << "    { \"range\" : { \"start\" : { \"line\" : " << i << ", \"character\" : 4 }, "
+             << "\"end\" : { \"line\" : " << i << ", \"character\" : 12 } }, "
+             << "\"rangeLength\" : 8, \"text\" : \"float value" << i << " = 1.0;\" },\n";
+    }
+    json << "    { \"text\" : \"";
+    for (int i = 0; i < 2000; ++i)
+    {
+        json << "float4 shade" << i << "(float4 c) { return c * \\\"scale\\\"; }\\n";
+    }
+    json << "\" }\n  ]\n}\n";
+
+    const UnownedStringSlice slice = json.getUnownedSlice();
+
+    auto typeMap = JSONNativeUtil::getTypeFuncsMap();
+
+    SourceManager sourceManager;
+    sourceManager.initialize(nullptr, nullptr);
+    DiagnosticSink sink(&sourceManager, &JSONLexer::calcLexemeLocation);
+
+    RefPtr<JSONContainer> container(new JSONContainer(&sourceManager));
+
+    const int passCount = 20;
+
+    BenchDidChangeParams converted;
+    auto start = platform::PerformanceCounter::now();
+    for (int pass = 0; pass < passCount; ++pass)
+    {
+        // As JSONRPCConnection does for each message
+        sourceManager.reset();
+        container->reset();
+
+        JSONValue root;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(JSONRPCUtil::parseJSON(slice, container, &sink, root)));
+
+        JSONToNativeConverter converter(container, &typeMap, &sink);
+        converted = BenchDidChangeParams();
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(converter.convert(root, &converted)));
+    }
+    const double convertTime = platform::PerformanceCounter::getElapsedTimeInSeconds(start);
+
+    BenchDidChangeParams decoded;
+    start = platform::PerformanceCounter::now();
+    for (int pass = 0; pass < passCount; ++pass)
+    {
+        sourceManager.reset();
+        container->reset();
+
+        // The StringBuilder's text is zero terminated, so it can be used without a copy
+        ComPtr<ISlangBlob> blob =
+            UnownedRawBlob::createTerminated(slice.begin(), slice.getLength());
+        SourceFile* sourceFile =
+            sourceManager.createSourceFileWithBlob(PathInfo::makeUnknown(), blob);
+        SourceView* sourceView = sourceManager.createSourceView(sourceFile, nullptr, SourceLoc());
+
+        JSONToNativeDecoder decoder(container, &typeMap, &sink);
+        decoded = BenchDidChangeParams();
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(decoder.decode(sourceView, &decoded)));
+    }
+    const double decodeTime = platform::PerformanceCounter::getElapsedTimeInSeconds(start);
+
+    getTestReporter()->addExecutionTime(convertTime + decodeTime);
+
+    // Both paths produce the same result
+    SLANG_CHECK(decoded == converted);
+    SLANG_CHECK(decoded.textDocument.version == 42);
+    SLANG_CHECK(decoded.contentChanges.getCount() == 501);
+    SLANG_CHECK(decoded.contentChanges[10].range.end.character == 12);
+    const auto lastText = decoded.contentChanges.getLast().text.getUnownedSlice();
+    SLANG_CHECK(lastText.indexOf(toSlice("\"scale\";")) >= 0);
+
+    const double megabytes = double(slice.getLength() * passCount) / (1024.0 * 1024.0);
+
+    StringBuilder message;
+    message << "parse and convert: " << Int64(megabytes / (convertTime > 0 ? convertTime : 1e-9))
+            << " MB/s, decode: " << Int64(megabytes / (decodeTime > 0 ? decodeTime : 1e-9))
+            << " MB/s\n";
+    getTestReporter()->message(TestMessageType::Info, message.getBuffer());
+}
@@ -1,5 +1,6 @@
 // unit-test-json-native.cpp
 
+#include "../../source/compiler-core/slang-json-native-decoder.h"
 #include "../../source/compiler-core/slang-json-native.h"
 #include "../../source/compiler-core/slang-json-parser.h"
 #include "../../source/core/slang-rtti-info.h"
@@ -153,6 +154,48 @@ static SlangResult _check()
         }
     }
 
+    // Decode directly from the text, without the JSON hierarchy
+    {
+        // The decoder reads from a source view, so the decoded JSONValues can refer to the text
+        auto makeSourceView = [&](const UnownedStringSlice& text) -> SourceView*
+        {
+            SourceFile* sourceFile =
+                sourceManager.createSourceFileWithString(PathInfo::makeUnknown(), String(text));
+            return sourceManager.createSourceView(sourceFile, nullptr, SourceLoc());
+        };
+
+        JSONToNativeDecoder decoder(container, &typeMap, &sink);
+
+        SomeStruct readS;
+        SLANG_RETURN_ON_FAIL(decoder.decode(makeSourceView(json.getUnownedSlice()), &readS));
+        SLANG_CHECK(readS == s);
+
+        OtherStruct readO;
+        SLANG_RETURN_ON_FAIL(decoder.decodeArrayToStruct(
+            makeSourceView(toSlice("[27.5, \"This works!\"]")),
+            &readO));
+        SLANG_CHECK(readO == o);
+
+        // Escapes are decoded
+        SLANG_RETURN_ON_FAIL(decoder.decode(
+            makeSourceView(toSlice("{ \"f\" : 1, \"value\" : \"a\\\"b\\n\" }")),
+            &readO));
+        SLANG_CHECK(readO.f == 1.0f && readO.value == "a\"b\n");
+
+        // Fields that aren't on the type, missing fields and trailing text are errors
+        SLANG_CHECK(SLANG_FAILED(decoder.decode(
+            makeSourceView(toSlice("{ \"f\" : 1, \"value\" : \"\", \"g\" : 2 }")),
+            &readO)));
+        SLANG_CHECK(
+            SLANG_FAILED(decoder.decode(makeSourceView(toSlice("{ \"f\" : 1 }")), &readO)));
+        SLANG_CHECK(SLANG_FAILED(decoder.decode(
+            makeSourceView(toSlice("{ \"f\" : 1, \"value\" : \"\" } 1")),
+            &readO)));
+        // Text that isn't valid JSON is an error
+        SLANG_CHECK(SLANG_FAILED(
+            decoder.decode(makeSourceView(toSlice("{ \"f\" : 1, \"value\" : @ }")), &readO)));
+    }
+
     return SLANG_OK;
 }
 
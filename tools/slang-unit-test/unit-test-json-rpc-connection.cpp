@@ -0,0 +1,326 @@
+// unit-test-json-rpc-connection.cpp
+
+#include "../../source/compiler-core/slang-json-native.h"
+#include "../../source/compiler-core/slang-json-rpc-connection.h"
+#include "../../source/compiler-core/slang-json-rpc.h"
+#include "../../source/core/slang-http.h"
+#include "../../source/core/slang-rtti-info.h"
+#include "../../source/core/slang-stream.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Send a large `textDocument/didChange`-like call, and its result, through JSONRPCConnection,
+// which decodes the messages it reads directly from their text.
+
+namespace
+{ // anonymous
+
+struct BenchPosition
+{
+    int line = 0;
+    int character = 0;
+
+    bool operator==(const BenchPosition& rhs) const
+    {
+        return line == rhs.line && character == rhs.character;
+    }
+
+    static const StructRttiInfo g_rttiInfo;
+};
+
+static const StructRttiInfo _makeBenchPositionRtti()
+{
+    BenchPosition obj;
+    StructRttiBuilder builder(&obj, "BenchPosition", nullptr);
+    builder.addField("line", &obj.line);
+    builder.addField("character", &obj.character);
+    return builder.make();
+}
+/* static */ const StructRttiInfo BenchPosition::g_rttiInfo = _makeBenchPositionRtti();
+
+struct BenchRange
+{
+    BenchPosition start;
+    BenchPosition end;
+
+    bool operator==(const BenchRange& rhs) const { return start == rhs.start && end == rhs.end; }
+
+    static const StructRttiInfo g_rttiInfo;
+};
+
+static const StructRttiInfo _makeBenchRangeRtti()
+{
+    BenchRange obj;
+    StructRttiBuilder builder(&obj, "BenchRange", nullptr);
+    builder.addField("start", &obj.start);
+    builder.addField("end", &obj.end);
+    return builder.make();
+}
+/* static */ const StructRttiInfo BenchRange::g_rttiInfo = _makeBenchRangeRtti();
+
+struct BenchContentChange
+{
+    BenchRange range;
+    String text;
+
+    bool operator==(const BenchContentChange& rhs) const
+    {
+        return range == rhs.range && text == rhs.text;
+    }
+    bool operator!=(const BenchContentChange& rhs) const { return !(*this == rhs); }
+
+    static const StructRttiInfo g_rttiInfo;
+};
+
+static const StructRttiInfo _makeBenchContentChangeRtti()
+{
+    BenchContentChange obj;
+    StructRttiBuilder builder(&obj, "BenchContentChange", nullptr);
+    builder.addField("range", &obj.range, StructRttiInfo::Flag::Optional);
+    builder.addField("text", &obj.text);
+    builder.ignoreUnknownFields();
+    return builder.make();
+}
+/* static */ const StructRttiInfo BenchContentChange::g_rttiInfo = _makeBenchContentChangeRtti();
+
+struct BenchDocument
+{
+    String uri;
+    int version = 0;
+
+    bool operator==(const BenchDocument& rhs) const
+    {
+        return uri == rhs.uri && version == rhs.version;
+    }
+
+    static const StructRttiInfo g_rttiInfo;
+};
+
+static const StructRttiInfo _makeBenchDocumentRtti()
+{
+    BenchDocument obj;
+    StructRttiBuilder builder(&obj, "BenchDocument", nullptr);
+    builder.addField("uri", &obj.uri);
+    builder.addField("version", &obj.version);
+    return builder.make();
+}
+/* static */ const StructRttiInfo BenchDocument::g_rttiInfo = _makeBenchDocumentRtti();
+
+struct BenchDidChangeParams
+{
+    BenchDocument textDocument;
+    List<BenchContentChange> contentChanges;
+
+    bool operator==(const BenchDidChangeParams& rhs) const
+    {
+        return textDocument == rhs.textDocument && contentChanges == rhs.contentChanges;
+    }
+
+    static const StructRttiInfo g_rttiInfo;
+};
+
+static const StructRttiInfo _makeBenchDidChangeParamsRtti()
+{
+    BenchDidChangeParams obj;
+    StructRttiBuilder builder(&obj, "BenchDidChangeParams", nullptr);
+    builder.addField("textDocument", &obj.textDocument);
+    builder.addField("contentChanges", &obj.contentChanges);
+    return builder.make();
+}
+/* static */ const StructRttiInfo BenchDidChangeParams::g_rttiInfo =
+    _makeBenchDidChangeParamsRtti();
+
+/// A call with typed params, read with getRPC
+struct BenchDidChangeCall
+{
+    UnownedStringSlice jsonrpc;
+    UnownedStringSlice method;
+    BenchDidChangeParams params;
+    JSONValue id;
+
+    static const StructRttiInfo g_rttiInfo;
+};
+
+static const StructRttiInfo _makeBenchDidChangeCallRtti()
+{
+    BenchDidChangeCall obj;
+    StructRttiBuilder builder(&obj, "BenchDidChangeCall", nullptr);
+    builder.addField("jsonrpc", &obj.jsonrpc);
+    builder.addField("method", &obj.method);
+    builder.addField("params", &obj.params);
+    builder.addField("id", &obj.id, StructRttiInfo::Flag::Optional);
+    return builder.make();
+}
+/* static */ const StructRttiInfo BenchDidChangeCall::g_rttiInfo = _makeBenchDidChangeCallRtti();
+
+/// Makes a connection that reads the packets in input, and writes to outOutput
+static RefPtr<JSONRPCConnection> _makeConnection(
+    const ConstArrayView<uint8_t>& input,
+    RefPtr<OwnedMemoryStream>& outOutput)
+{
+    RefPtr<OwnedMemoryStream> readStream(new OwnedMemoryStream(FileAccess::Read));
+    readStream->setContent(input.getBuffer(), input.getCount());
+
+    outOutput = new OwnedMemoryStream(FileAccess::ReadWrite);
+
+    RefPtr<HTTPPacketConnection> packetConnection(
+        new HTTPPacketConnection(new BufferedReadStream(readStream), outOutput));
+
+    RefPtr<JSONRPCConnection> connection(new JSONRPCConnection);
+    if (SLANG_FAILED(connection->init(packetConnection, JSONRPCConnection::CallStyle::Object)))
+    {
+        return nullptr;
+    }
+    return connection;
+}
+
+} // namespace
+
+SLANG_UNIT_TEST(jsonRPCConnection)
+{
+    // Many small edits, followed by a change that replaces the whole document
+    BenchDidChangeParams args;
+    args.textDocument.uri = "file:///bench.slang";
+    args.textDocument.version = 42;
+    for (int i = 0; i < 500; ++i)
+    {
+        BenchContentChange change;
+        change.range.start.line = i;
+        change.range.start.character = 4;
+        change.range.end.line = i;
+        change.range.end.character = 12;
+        change.text = String("float value") + String(i) + " = 1.0;";
+        args.contentChanges.add(change);
+    }
+    {
+        StringBuilder text;
+        for (int i = 0; i < 2000; ++i)
+        {
+            text << "float4 shade" << i << "(float4 c) { return c * \"scale\"; }\n";
+        }
+        BenchContentChange change;
+        change.text = text;
+        args.contentChanges.add(change);
+    }
+
+    // Send the call
+    RefPtr<OwnedMemoryStream> callStream;
+    RefPtr<JSONRPCConnection> client = _makeConnection(ConstArrayView<uint8_t>(), callStream);
+    SLANG_CHECK_ABORT(client);
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+        client->sendCall(toSlice("textDocument/didChange"), &args, JSONValue::makeInt(7))));
+
+    // Read it on the other side
+    RefPtr<OwnedMemoryStream> resultStream;
+    RefPtr<JSONRPCConnection> server = _makeConnection(callStream->getContents(), resultStream);
+    SLANG_CHECK_ABORT(server);
+    // The packet is larger than a single read, so wait for all of it
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(server->waitForResult()));
+    SLANG_CHECK_ABORT(server->hasMessage());
+    SLANG_CHECK(server->getMessageType() == JSONRPCMessageType::Call);
+
+    const JSONValue id = server->getCurrentMessageId();
+    SLANG_CHECK(id.isValid() && server->getContainer()->asInteger(id) == 7);
+
+    // The untyped call
+    {
+        JSONRPCCall call;
+        SLANG_CHECK(SLANG_SUCCEEDED(server->getRPC(&call)));
+        SLANG_CHECK(call.isValid());
+        SLANG_CHECK(call.method == toSlice("textDocument/didChange"));
+        SLANG_CHECK(call.params.getKind() == JSONValue::Kind::Object);
+    }
+
+    // The typed call
+    {
+        BenchDidChangeCall call;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(server->getRPC(&call)));
+        SLANG_CHECK(call.method == toSlice("textDocument/didChange"));
+        SLANG_CHECK(call.params == args);
+        SLANG_CHECK(call.params.contentChanges.getCount() == 501);
+        const auto lastText = call.params.contentChanges.getLast().text.getUnownedSlice();
+        SLANG_CHECK(lastText.indexOf(toSlice("\"scale\";")) >= 0);
+    }
+
+    // Send the params back as the result, and read it on the client
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(server->sendResult(&args, id)));
+    {
+        RefPtr<OwnedMemoryStream> unusedStream;
+        RefPtr<JSONRPCConnection> resultReader =
+            _makeConnection(resultStream->getContents(), unusedStream);
+        SLANG_CHECK_ABORT(resultReader);
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(resultReader->waitForResult()));
+        SLANG_CHECK_ABORT(resultReader->hasMessage());
+        SLANG_CHECK(resultReader->getMessageType() == JSONRPCMessageType::Result);
+
+        BenchDidChangeParams result;
+        SLANG_CHECK(SLANG_SUCCEEDED(resultReader->getMessage(&result)));
+        SLANG_CHECK(result == args);
+    }
+
+    // Packets that are read into the buffer together are each decoded in place
+    {
+        StringBuilder packets;
+        for (int i = 0; i < 3; ++i)
+        {
+            StringBuilder json;
+            json << "{ \"jsonrpc\" : \"2.0\", \"method\" : \"test" << i << "\", \"id\" : " << i
+                 << " }";
+            packets << "Content-Length: " << json.getLength() << "\r\n\r\n" << json;
+        }
+
+        RefPtr<OwnedMemoryStream> outputStream;
+        RefPtr<JSONRPCConnection> connection = _makeConnection(
+            ConstArrayView<uint8_t>((const uint8_t*)packets.getBuffer(), packets.getLength()),
+            outputStream);
+        SLANG_CHECK_ABORT(connection);
+        for (int i = 0; i < 3; ++i)
+        {
+            SLANG_CHECK_ABORT(SLANG_SUCCEEDED(connection->tryReadMessage()));
+            SLANG_CHECK_ABORT(connection->hasMessage());
+
+            JSONRPCCall call;
+            SLANG_CHECK(SLANG_SUCCEEDED(connection->getRPC(&call)));
+            SLANG_CHECK(call.method == (String("test") + String(i)).getUnownedSlice());
+            SLANG_CHECK(connection->getContainer()->asInteger(call.id) == i);
+        }
+        SLANG_CHECK(SLANG_SUCCEEDED(connection->tryReadMessage()));
+        SLANG_CHECK(!connection->hasMessage());
+    }
+
+    // Valid JSON that isn't a JSON-RPC message is read, but is of an invalid type
+    {
+        const char json[] = "[1, 2, 3]";
+        StringBuilder packet;
+        packet << "Content-Length: " << Index(sizeof(json) - 1) << "\r\n\r\n" << json;
+
+        RefPtr<OwnedMemoryStream> outputStream;
+        RefPtr<JSONRPCConnection> connection = _makeConnection(
+            ConstArrayView<uint8_t>((const uint8_t*)packet.getBuffer(), packet.getLength()),
+            outputStream);
+        SLANG_CHECK_ABORT(connection);
+        SLANG_CHECK(SLANG_SUCCEEDED(connection->tryReadMessage()));
+        SLANG_CHECK(connection->hasMessage());
+        SLANG_CHECK(connection->getMessageType() == JSONRPCMessageType::Invalid);
+    }
+
+    // Text that isn't JSON isn't a message, and a parse error is sent back
+    {
+        const char json[] = "{ \"method\" : \"test\", ";
+        StringBuilder packet;
+        packet << "Content-Length: " << Index(sizeof(json) - 1) << "\r\n\r\n" << json;
+
+        RefPtr<OwnedMemoryStream> outputStream;
+        RefPtr<JSONRPCConnection> connection = _makeConnection(
+            ConstArrayView<uint8_t>((const uint8_t*)packet.getBuffer(), packet.getLength()),
+            outputStream);
+        SLANG_CHECK_ABORT(connection);
+        connection->tryReadMessage();
+        SLANG_CHECK(!connection->hasMessage());
+
+        const auto output = outputStream->getContents();
+        UnownedStringSlice outputText((const char*)output.getBuffer(), output.getCount());
+        SLANG_CHECK(outputText.indexOf(toSlice("-32700")) >= 0);
+    }
+}
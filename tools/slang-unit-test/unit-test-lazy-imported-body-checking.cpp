@@ -0,0 +1,108 @@
+// unit-test-lazy-imported-body-checking.cpp
+
+#include "core/slang-memory-file-system.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test that a module imported by a compile with `-lazy-imported-body-checking`, which only has
+// the function bodies that compile used checked and lowered, isn't reused by later compiles in
+// the same session that need its other functions.
+
+SLANG_UNIT_TEST(lazyImportedBodyChecking)
+{
+    const char* libSource = R"(
+        module lib;
+
+        public int usedFirst(int x) { return x + 1; }
+
+        public int usedLater(int x) { return x * 3; }
+    )";
+
+    const char* firstSource = R"(
+        import lib;
+
+        RWStructuredBuffer<int> outputBuffer;
+
+        [shader("compute")]
+        [numthreads(1,1,1)]
+        void computeMain()
+        {
+            outputBuffer[0] = usedFirst(outputBuffer[0]);
+        }
+    )";
+
+    const char* laterSource = R"(
+        import lib;
+
+        RWStructuredBuffer<int> outputBuffer;
+
+        [shader("compute")]
+        [numthreads(1,1,1)]
+        void computeMain()
+        {
+            outputBuffer[0] = usedLater(outputBuffer[0]);
+        }
+    )";
+
+    ComPtr<ISlangMutableFileSystem> memoryFileSystem =
+        ComPtr<ISlangMutableFileSystem>(new Slang::MemoryFileSystem());
+    memoryFileSystem->saveFile("lib.slang", libSource, strlen(libSource));
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(
+        slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.fileSystem = memoryFileSystem;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    // Compile with `lib` imported lazily, so only `usedFirst` is checked and lowered.
+    {
+        ComPtr<slang::ICompileRequest> request;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(session->createCompileRequest(request.writeRef())));
+
+        const char* args[] = {"-lazy-imported-body-checking"};
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(request->processCommandLineArguments(args, 1)));
+
+        const int translationUnitIndex =
+            request->addTranslationUnit(SLANG_SOURCE_LANGUAGE_SLANG, "first");
+        request->addTranslationUnitSourceString(translationUnitIndex, "first.slang", firstSource);
+        request->addEntryPoint(translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(request->compile()));
+
+        ComPtr<ISlangBlob> code;
+        request->getEntryPointCodeBlob(0, 0, code.writeRef());
+        SLANG_CHECK(code && code->getBufferSize() != 0);
+    }
+
+    // A later compile in the same session uses the other function of `lib`.
+    {
+        ComPtr<slang::IBlob> diagnosticBlob;
+        auto module = session->loadModuleFromSourceString(
+            "later",
+            "later.slang",
+            laterSource,
+            diagnosticBlob.writeRef());
+        SLANG_CHECK_ABORT(module != nullptr);
+
+        ComPtr<slang::IComponentType> linkedProgram;
+        SLANG_CHECK_ABORT(
+            module->link(linkedProgram.writeRef(), diagnosticBlob.writeRef()) == SLANG_OK);
+
+        ComPtr<slang::IBlob> code;
+        SLANG_CHECK(SLANG_SUCCEEDED(
+            linkedProgram->getTargetCode(0, code.writeRef(), diagnosticBlob.writeRef())));
+        SLANG_CHECK(code && code->getBufferSize() != 0);
+    }
+}
@@ -0,0 +1,88 @@
+// unit-test-local-socket.cpp
+
+#include "../../source/core/slang-http.h"
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-local-socket.h"
+#include "../../source/core/slang-process.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <thread>
+
+using namespace Slang;
+
+SLANG_UNIT_TEST(localSocket)
+{
+    if (!LocalSocketServer::isAvailable())
+    {
+        return;
+    }
+
+    String socketPath;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(File::generateTemporary(toSlice("slang-local-socket"), socketPath)));
+
+    RefPtr<LocalSocketServer> server(new LocalSocketServer);
+
+    // A regular file at the path must not be replaced
+    SLANG_CHECK(server->listen(socketPath) == SLANG_E_INVALID_ARG);
+    SLANG_CHECK(File::exists(socketPath));
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::remove(socketPath)));
+
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(server->listen(socketPath)));
+
+    // Another server can't take over a socket that is being listened on
+    {
+        RefPtr<LocalSocketServer> otherServer(new LocalSocketServer);
+        SLANG_CHECK(otherServer->listen(socketPath) == SLANG_E_NOT_AVAILABLE);
+    }
+
+    // Echo packets back to the client until it disconnects
+    std::thread serverThread(
+        [&]()
+        {
+            RefPtr<Stream> stream;
+            if (SLANG_FAILED(server->accept(stream)))
+            {
+                return;
+            }
+            RefPtr<HTTPPacketConnection> connection =
+                new HTTPPacketConnection(new BufferedReadStream(stream), stream);
+            while (SLANG_SUCCEEDED(connection->waitForResult()) && connection->hasContent())
+            {
+                auto content = connection->getContent();
+                connection->write(content.getBuffer(), content.getCount());
+                connection->consumeContent();
+            }
+        });
+
+    {
+        RefPtr<Stream> stream;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(LocalSocketServer::connect(socketPath, stream)));
+
+        RefPtr<HTTPPacketConnection> connection =
+            new HTTPPacketConnection(new BufferedReadStream(stream), stream);
+
+        for (const char* text : {"Hello", "World!"})
+        {
+            const UnownedStringSlice slice(text);
+            SLANG_CHECK(SLANG_SUCCEEDED(connection->write(slice.begin(), slice.getLength())));
+            SLANG_CHECK(SLANG_SUCCEEDED(connection->waitForResult()));
+            SLANG_CHECK_ABORT(connection->hasContent());
+
+            auto content = connection->getContent();
+            SLANG_CHECK(
+                UnownedStringSlice((const char*)content.getBuffer(), content.getCount()) == slice);
+            connection->consumeContent();
+        }
+
+        // Closing the client ends the server loop
+        stream->close();
+    }
+
+    serverThread.join();
+    server->close();
+
+    // Nothing should be listening anymore
+    RefPtr<Stream> stream;
+    SLANG_CHECK(SLANG_FAILED(LocalSocketServer::connect(socketPath, stream)));
+}
@@ -1,5 +1,6 @@
 // unit-test-free-list.cpp
 
+#include "../../source/core/slang-dictionary.h"
 #include "../../source/core/slang-list.h"
 #include "../../source/core/slang-memory-arena.h"
 #include "../../source/core/slang-random-generator.h"
@@ -21,6 +22,40 @@ struct Block
     uint8_t m_value;
 };
 
+/// Counts the blocks allocated through it, and checks they are freed with the size they were
+/// allocated with
+class CountingAllocator : public MemoryAllocator
+{
+public:
+    void* allocate(size_t sizeInBytes) SLANG_OVERRIDE
+    {
+        m_allocatedCount++;
+        m_sizes.add(sizeInBytes);
+        void* ptr = MemoryAllocator::allocate(sizeInBytes);
+        m_ptrs.add(ptr);
+        return ptr;
+    }
+    void deallocate(void* ptr, size_t sizeInBytes) SLANG_OVERRIDE
+    {
+        const Index index = m_ptrs.indexOf(ptr);
+        if (index < 0 || m_sizes[index] != sizeInBytes)
+        {
+            m_mismatchCount++;
+        }
+        else
+        {
+            m_ptrs.fastRemoveAt(index);
+            m_sizes.fastRemoveAt(index);
+        }
+        MemoryAllocator::deallocate(ptr, sizeInBytes);
+    }
+
+    Index m_allocatedCount = 0;
+    Index m_mismatchCount = 0;
+    List<void*> m_ptrs;
+    List<size_t> m_sizes;
+};
+
 enum class TestMode
 {
     eUnaligned,
@@ -264,3 +299,80 @@ SLANG_UNIT_TEST(memoryArena)
         // Do lots of allocations and test out rewind
     }
 }
+
+SLANG_UNIT_TEST(memoryArenaAccounting)
+{
+    RefPtr<CountingAllocator> allocator = new CountingAllocator;
+    MemoryAccounting accounting(allocator);
+
+    const size_t blockSize = 1024;
+    {
+        MemoryArena arena(blockSize);
+        arena.setAccounting(&accounting, MemoryAccounting::Category::IRArena);
+
+        arena.allocate(100);
+        SLANG_CHECK(allocator->m_allocatedCount == 1);
+        SLANG_CHECK(accounting.getUsed(MemoryAccounting::Category::IRArena) == blockSize);
+        SLANG_CHECK(accounting.getUsed(MemoryAccounting::Category::ASTArena) == 0);
+
+        // An odd sized block is counted with its whole size
+        arena.allocate(blockSize * 2);
+        SLANG_CHECK(accounting.getTotalUsed() == blockSize * 3);
+
+        // Odd blocks are freed by deallocateAll, normal ones are kept for reuse
+        arena.deallocateAll();
+        SLANG_CHECK(accounting.getTotalUsed() == blockSize);
+        SLANG_CHECK(accounting.getPeakTotalUsed() == blockSize * 3);
+
+        arena.allocate(100);
+        SLANG_CHECK(allocator->m_allocatedCount == 2);
+
+        // Only what is taken after a snapshot counts as used since it
+        const auto snapshot = accounting.getSnapshot();
+        SLANG_CHECK(accounting.getTotalUsedSince(snapshot) == 0);
+        arena.allocate(blockSize - 50);
+        SLANG_CHECK(accounting.getTotalUsedSince(snapshot) == blockSize);
+        SLANG_CHECK(
+            accounting.getUsedSince(snapshot, MemoryAccounting::Category::IRArena) == blockSize);
+        SLANG_CHECK(
+            accounting.getUsedSince(snapshot, MemoryAccounting::Category::ASTArena) == 0);
+
+        // Less in use than at the snapshot counts as nothing used
+        arena.reset();
+        SLANG_CHECK(accounting.getTotalUsedSince(snapshot) == 0);
+    }
+
+    // Everything is returned when the arena is destroyed
+    SLANG_CHECK(accounting.getTotalUsed() == 0);
+    SLANG_CHECK(allocator->m_ptrs.getCount() == 0);
+    SLANG_CHECK(allocator->m_mismatchCount == 0);
+}
+
+SLANG_UNIT_TEST(memoryAccountingContainers)
+{
+    MemoryAccounting accounting;
+
+    const ptrdiff_t allocatedAtStart = ContainerMemory::getAllocatedOnThread();
+    const auto snapshot = accounting.getSnapshot();
+    {
+        List<int> list;
+        list.setCount(1000);
+        SLANG_CHECK(MemoryAccounting::getContainersUsedSince(snapshot) >= 1000 * sizeof(int));
+
+        const auto afterList = accounting.getSnapshot();
+        Dictionary<int, int> dict;
+        for (int i = 0; i < 1000; ++i)
+        {
+            dict.add(i, i);
+        }
+        SLANG_CHECK(
+            MemoryAccounting::getContainersUsedSince(afterList) >= 1000 * 2 * sizeof(int));
+
+        // Container memory isn't counted as arena memory
+        SLANG_CHECK(accounting.getTotalUsedSince(snapshot) == 0);
+    }
+
+    // Everything is returned when the containers are destroyed
+    SLANG_CHECK(ContainerMemory::getAllocatedOnThread() == allocatedAtStart);
+    SLANG_CHECK(MemoryAccounting::getContainersUsedSince(snapshot) == 0);
+}
@@ -272,9 +272,15 @@ struct EvictionTest : public PersistentCacheTest
         SLANG_CHECK(readEntry(entries[1]) == true);
         SLANG_CHECK(readEntry(entries[2]) == true);
 
-        // Evict LRU entry 0.
+        // Add a file derived from entry 0.
+        String filesDirectory = cache->getEntryFilesDirectory(entries[0].key);
+        SLANG_CHECK(Path::createDirectory(filesDirectory));
+        File::writeAllText(Path::combine(filesDirectory, "derived"), "derived");
+
+        // Evict LRU entry 0, along with the files derived from it.
         writeEntry(entries[3]);
         SLANG_CHECK(readEntry(entries[0]) == false);
+        SLANG_CHECK(!File::exists(filesDirectory));
         SLANG_CHECK(readEntry(entries[1]) == true);
         SLANG_CHECK(readEntry(entries[2]) == true);
         SLANG_CHECK(readEntry(entries[3]) == true);
@@ -0,0 +1,153 @@
+// unit-test-precompiled-derivatives.cpp
+
+#include "core/slang-memory-file-system.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test that a module precompiled with `PrecompileForwardDerivatives` carries the derivatives of
+// its functions when it is serialized and loaded again, and can be differentiated from another
+// module.
+
+SLANG_UNIT_TEST(precompiledDerivatives)
+{
+    const char* diffModuleSource = R"(
+        module diff_module;
+
+        [Differentiable]
+        float cube(float x) { return x * x * x; }
+
+        [Differentiable]
+        public float polynomial(float x) { return cube(x) + 2.0 * x; }
+    )";
+
+    const char* testSource = R"(
+        import "diff_module";
+
+        RWStructuredBuffer<float> outputBuffer;
+
+        [shader("compute")]
+        [numthreads(1,1,1)]
+        void computeMain()
+        {
+            let result = fwd_diff(polynomial)(diffPair(outputBuffer[0], 1.0));
+            outputBuffer[1] = result.d;
+        }
+    )";
+
+    ComPtr<ISlangMutableFileSystem> memoryFileSystem =
+        ComPtr<ISlangMutableFileSystem>(new Slang::MemoryFileSystem());
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(
+        slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.fileSystem = memoryFileSystem;
+
+    // Precompile diff_module, with or without its derivatives, and serialize it.
+    auto precompileModule = [&](bool precompileDerivatives)
+    {
+        slang::CompilerOptionEntry precompileEntry;
+        precompileEntry.name = slang::CompilerOptionName::PrecompileForwardDerivatives;
+        precompileEntry.value.kind = slang::CompilerOptionValueKind::Int;
+        precompileEntry.value.intValue0 = precompileDerivatives ? 1 : 0;
+
+        slang::SessionDesc precompileSessionDesc = sessionDesc;
+        precompileSessionDesc.compilerOptionEntries = &precompileEntry;
+        precompileSessionDesc.compilerOptionEntryCount = 1;
+
+        ComPtr<slang::ISession> session;
+        SLANG_CHECK_ABORT(
+            globalSession->createSession(precompileSessionDesc, session.writeRef()) == SLANG_OK);
+
+        ComPtr<slang::IBlob> diagnosticBlob;
+        auto module = session->loadModuleFromSourceString(
+            "diff_module",
+            "diff_module.slang",
+            diffModuleSource,
+            diagnosticBlob.writeRef());
+        SLANG_CHECK_ABORT(module != nullptr);
+
+        ComPtr<slang::IModulePrecompileService_Experimental> precompileService;
+        SLANG_CHECK_ABORT(
+            module->queryInterface(
+                slang::IModulePrecompileService_Experimental::getTypeGuid(),
+                (void**)precompileService.writeRef()) == SLANG_OK);
+
+        // The derivatives are generated into the module whether or not the downstream target
+        // is available, so only the serialized module is used below.
+        precompileService->precompileForTarget(SLANG_SPIRV, diagnosticBlob.writeRef());
+
+        ComPtr<slang::IBlob> moduleBlob;
+        SLANG_CHECK_ABORT(module->serialize(moduleBlob.writeRef()) == SLANG_OK);
+        return moduleBlob;
+    };
+
+    // Load a serialized diff_module in a new session, and get the disassembly of its IR.
+    auto disassembleModule = [&](slang::IBlob* moduleBlob)
+    {
+        ComPtr<slang::ISession> session;
+        SLANG_CHECK_ABORT(
+            globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+        ComPtr<slang::IBlob> diagnosticBlob;
+        auto module = session->loadModuleFromIRBlob(
+            "diff_module",
+            "diff_module.slang-module",
+            moduleBlob,
+            diagnosticBlob.writeRef());
+        SLANG_CHECK_ABORT(module != nullptr);
+
+        ComPtr<slang::IBlob> disassembly;
+        SLANG_CHECK_ABORT(module->disassemble(disassembly.writeRef()) == SLANG_OK);
+        return String(UnownedStringSlice(
+            (const char*)disassembly->getBufferPointer(),
+            disassembly->getBufferSize()));
+    };
+
+    // Only the module precompiled with the option carries derivatives, attached to the
+    // functions they differentiate, after being serialized and loaded again.
+    {
+        auto moduleBlob = precompileModule(false);
+        SLANG_CHECK(disassembleModule(moduleBlob).indexOf("[fwdDerivative(") < 0);
+    }
+
+    auto moduleBlob = precompileModule(true);
+    SLANG_CHECK(disassembleModule(moduleBlob).indexOf("[fwdDerivative(") >= 0);
+
+    memoryFileSystem->saveFile(
+        "diff_module.slang-module",
+        moduleBlob->getBufferPointer(),
+        moduleBlob->getBufferSize());
+
+    // Use the precompiled derivative from a new session.
+    {
+        ComPtr<slang::ISession> session;
+        SLANG_CHECK_ABORT(
+            globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+        ComPtr<slang::IBlob> diagnosticBlob;
+        auto module = session->loadModuleFromSourceString(
+            "test",
+            "test.slang",
+            testSource,
+            diagnosticBlob.writeRef());
+        SLANG_CHECK_ABORT(module != nullptr);
+
+        ComPtr<slang::IComponentType> linkedProgram;
+        SLANG_CHECK_ABORT(module->link(linkedProgram.writeRef()) == SLANG_OK);
+
+        ComPtr<slang::IBlob> code;
+        linkedProgram->getTargetCode(0, code.writeRef(), diagnosticBlob.writeRef());
+        SLANG_CHECK_ABORT(code != nullptr);
+        SLANG_CHECK(code->getBufferSize() > 0);
+    }
+}
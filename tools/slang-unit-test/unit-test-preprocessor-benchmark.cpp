@@ -0,0 +1,89 @@
+// unit-test-preprocessor-benchmark.cpp
+
+#include "../../source/core/slang-writer.h"
+#include "../../tools/platform/performance-counter.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Measure how quickly macro-heavy source is preprocessed, by running the compiler with
+// preprocessor output only (`-E`) and reporting the rate in tokens per second.
+
+static const char kMacroDefinitions[] = R"(
+#define CONCAT_INNER(a, b) a##b
+#define CONCAT(a, b) CONCAT_INNER(a, b)
+#define FIELD(type, name, index) type CONCAT(name, index);
+#define FIELDS4(type, name, base) \
+    FIELD(type, name, base##0) FIELD(type, name, base##1) \
+    FIELD(type, name, base##2) FIELD(type, name, base##3)
+#define MAD(a, b, c) ((a) * (b) + (c))
+#define LERP(a, b, t) MAD(t, (b) - (a), a)
+#define BLEND(x, y, w) LERP(LERP(x, y, w), LERP(y, x, w), 0.5)
+#define MATERIAL(name, index)                            \
+    struct CONCAT(name, index)                           \
+    {                                                    \
+        FIELDS4(float4, albedo, index)                   \
+        FIELDS4(float, roughness, index)                 \
+    };                                                   \
+    float CONCAT(evaluate, CONCAT(name, index))(float x) \
+    {                                                    \
+        return BLEND(x, BLEND(x, 1.0, 0.25), __LINE__);  \
+    }
+)";
+
+SLANG_UNIT_TEST(preprocessorBenchmark)
+{
+    StringBuilder source;
+    source << kMacroDefinitions;
+    for (int i = 0; i < 200; ++i)
+    {
+        source << "MATERIAL(Material, " << i << ")\n";
+    }
+
+    ComPtr<ISlangWriter> nullWriter(new NullWriter(WriterFlag::IsConsole));
+
+    const int passCount = 20;
+    Index tokenCount = 0;
+    auto start = platform::PerformanceCounter::now();
+    for (int pass = 0; pass < passCount; ++pass)
+    {
+        ComPtr<slang::ICompileRequest> request;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+            unitTestContext->slangGlobalSession->createCompileRequest(request.writeRef())));
+
+        const char* args[] = {"-E"};
+        SLANG_CHECK_ABORT(
+            SLANG_SUCCEEDED(request->processCommandLineArguments(args, SLANG_COUNT_OF(args))));
+
+        // Every token in the output is followed by a single space
+        StringBuilder output;
+        ComPtr<ISlangWriter> outputWriter(new StringWriter(&output, 0));
+        request->setWriter(SLANG_WRITER_CHANNEL_STD_OUTPUT, outputWriter);
+        request->setWriter(SLANG_WRITER_CHANNEL_DIAGNOSTIC, nullWriter);
+
+        const int translationUnitIndex =
+            request->addTranslationUnit(SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+        request->addTranslationUnitSourceString(
+            translationUnitIndex,
+            "preprocessor-benchmark.slang",
+            source.getBuffer());
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(request->compile()));
+
+        for (auto c : output.getUnownedSlice())
+        {
+            tokenCount += Index(c == ' ');
+        }
+    }
+    auto time = platform::PerformanceCounter::getElapsedTimeInSeconds(start);
+    getTestReporter()->addExecutionTime(time);
+
+    // Each material expands to over a hundred tokens
+    SLANG_CHECK(tokenCount > passCount * 200 * 100);
+
+    StringBuilder message;
+    message << "preprocessed " << tokenCount << " tokens at "
+            << Int64(tokenCount / (time > 0 ? time : 1e-9)) << " tokens/s\n";
+    getTestReporter()->message(TestMessageType::Info, message.getBuffer());
+}
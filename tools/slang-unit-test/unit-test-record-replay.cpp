@@ -134,6 +134,12 @@ static bool disableRecordLayer()
     return retCode == 0;
 }
 
+static bool setAsyncRecording(bool enable)
+{
+    int retCode = writeEnvironmentVariable("SLANG_RECORD_ASYNC", enable ? "1" : "0");
+    return retCode == 0;
+}
+
 static bool enableLogInReplayer()
 {
     int retCode = writeEnvironmentVariable("SLANG_RECORD_LOG_LEVEL", "3");
@@ -396,11 +402,16 @@ static SlangResult cleanupRecordFiles(const String& recordDir)
     return res;
 }
 
-static SlangResult runTest(UnitTestContext* context, const char* testName)
+static SlangResult runTest(
+    UnitTestContext* context,
+    const char* testName,
+    bool asyncRecording = false)
 {
     // Create unique directory for this test to avoid conflicts
     StringBuilder recordDirBuilder;
     recordDirBuilder << "slang-record-" << testName;
+    if (asyncRecording)
+        recordDirBuilder << "-async";
     String recordDir = recordDirBuilder.toString();
 
     List<entryHashInfo> expectHashes;
@@ -408,7 +419,9 @@ static SlangResult runTest(UnitTestContext* context, const char* testName)
     SlangResult res = SLANG_OK;
 
     // Run the example to generate recording
+    setAsyncRecording(asyncRecording);
     res = runExample(context, testName, recordDir, expectHashes);
+    setAsyncRecording(false);
     if (SLANG_SUCCEEDED(res))
     {
         // Replay the recording
@@ -435,6 +448,11 @@ SLANG_UNIT_TEST(RecordReplay_cpu_hello_world)
     SLANG_CHECK(SLANG_SUCCEEDED(runTest(unitTestContext, "cpu-hello-world")));
 }
 
+SLANG_UNIT_TEST(RecordReplay_cpu_hello_world_async)
+{
+    SLANG_CHECK(SLANG_SUCCEEDED(runTest(unitTestContext, "cpu-hello-world", true)));
+}
+
 SLANG_UNIT_TEST(RecordReplay_triangle)
 {
     SLANG_CHECK(SLANG_SUCCEEDED(runTest(unitTestContext, "triangle")));
@@ -0,0 +1,111 @@
+// unit-test-reflection-binary.cpp
+
+#include "../../source/core/slang-io.h"
+#include "slang-com-ptr.h"
+#include "slang-reflection-binary.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+namespace ReflectionBinary = slang::reflection_binary;
+
+static const char kReflectionBinarySource[] = R"(
+    struct Light
+    {
+        float3 position;
+        float intensity;
+    };
+
+    ConstantBuffer<Light> keyLight;
+    ConstantBuffer<Light> fillLight;
+    RWStructuredBuffer<float> output;
+
+    [shader("compute")]
+    [numthreads(8, 4, 1)]
+    void computeMain(uint3 tid : SV_DispatchThreadID)
+    {
+        output[tid.x] = keyLight.intensity + fillLight.intensity;
+    }
+)";
+
+SLANG_UNIT_TEST(reflectionBinary)
+{
+    String reflectionPath;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+        File::generateTemporary(toSlice("slang-reflection-binary"), reflectionPath)));
+
+    ComPtr<slang::ICompileRequest> request;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+        unitTestContext->slangGlobalSession->createCompileRequest(request.writeRef())));
+
+    const char* args[] = {"-target", "hlsl", "-reflection-binary", reflectionPath.getBuffer()};
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(request->processCommandLineArguments(args, SLANG_COUNT_OF(args))));
+
+    const int translationUnitIndex =
+        request->addTranslationUnit(SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    request->addTranslationUnitSourceString(
+        translationUnitIndex,
+        "reflection-binary.slang",
+        kReflectionBinarySource);
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(request->compile()));
+
+    ScopedAllocation data;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::readAllBytes(reflectionPath, data)));
+    File::remove(reflectionPath);
+
+    ReflectionBinary::Reader reader;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(reader.init(data.getData(), data.getSizeInBytes())));
+
+    // Global parameters
+    SLANG_CHECK(reader.getHeader()->globalParams.count == 3);
+    const auto keyLightIndex = reader.findGlobalParam("keyLight");
+    const auto fillLightIndex = reader.findGlobalParam("fillLight");
+    SLANG_CHECK_ABORT(keyLightIndex != ReflectionBinary::kNullIndex);
+    SLANG_CHECK_ABORT(fillLightIndex != ReflectionBinary::kNullIndex);
+    SLANG_CHECK(reader.findGlobalParam("output") != ReflectionBinary::kNullIndex);
+    SLANG_CHECK(reader.findGlobalParam("missing") == ReflectionBinary::kNullIndex);
+
+    // Both lights share the same type, which must only be stored once.
+    auto keyLight = reader.getVariableLayout(keyLightIndex);
+    auto fillLight = reader.getVariableLayout(fillLightIndex);
+    SLANG_CHECK_ABORT(keyLight && fillLight);
+    auto keyLightTypeLayout = reader.getTypeLayout(keyLight->typeLayout);
+    auto fillLightTypeLayout = reader.getTypeLayout(fillLight->typeLayout);
+    SLANG_CHECK_ABORT(keyLightTypeLayout && fillLightTypeLayout);
+    SLANG_CHECK(keyLightTypeLayout->type == fillLightTypeLayout->type);
+
+    // The element type of the constant buffer is the `Light` struct.
+    auto elementTypeLayout = reader.getTypeLayout(keyLightTypeLayout->elementTypeLayout);
+    SLANG_CHECK_ABORT(elementTypeLayout);
+    auto lightType = reader.getType(elementTypeLayout->type);
+    SLANG_CHECK_ABORT(lightType);
+    SLANG_CHECK(lightType->kind == uint32_t(slang::TypeReflection::Kind::Struct));
+    SLANG_CHECK(strcmp(reader.getString(lightType->name), "Light") == 0);
+    SLANG_CHECK(lightType->fields.count == 2);
+    SLANG_CHECK(reader.getSize(elementTypeLayout, slang::ParameterCategory::Uniform) == 16);
+
+    // Entry point
+    SLANG_CHECK_ABORT(reader.getCount(ReflectionBinary::SectionKind::EntryPoints) == 1);
+    auto entryPoint = reader.getEntryPoint(0);
+    SLANG_CHECK(strcmp(reader.getString(entryPoint->name), "computeMain") == 0);
+    SLANG_CHECK(entryPoint->stage == SLANG_STAGE_COMPUTE);
+    SLANG_CHECK(entryPoint->threadGroupSize[0] == 8);
+    SLANG_CHECK(entryPoint->threadGroupSize[1] == 4);
+    SLANG_CHECK(entryPoint->threadGroupSize[2] == 1);
+    SLANG_CHECK(entryPoint->params.count == 1);
+
+    // Corrupt data must be rejected
+    auto header = (ReflectionBinary::Header*)data.getData();
+    {
+        // A section that isn't aligned for its elements
+        auto& section = header->sections[uint32_t(ReflectionBinary::SectionKind::Types)];
+        const uint32_t offset = section.offset;
+        section.offset = offset + 1;
+        SLANG_CHECK(SLANG_FAILED(reader.init(data.getData(), data.getSizeInBytes())));
+        section.offset = offset;
+        SLANG_CHECK(SLANG_SUCCEEDED(reader.init(data.getData(), data.getSizeInBytes())));
+    }
+    header->magic = 0;
+    SLANG_CHECK(SLANG_FAILED(reader.init(data.getData(), data.getSizeInBytes())));
+}
@@ -0,0 +1,91 @@
+// unit-test-session-allocator.cpp
+
+#include "../../source/core/slang-com-object.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace Slang;
+
+namespace
+{
+
+// Allocates from the heap, keeping count of what is outstanding
+class CountingSlangAllocator : public ComBaseObject, public ISlangAllocator
+{
+public:
+    SLANG_COM_BASE_IUNKNOWN_ALL
+
+    virtual SLANG_NO_THROW void* SLANG_MCALL allocate(size_t sizeInBytes) SLANG_OVERRIDE
+    {
+        m_allocatedCount++;
+        m_outstandingBytes += sizeInBytes;
+        return ::malloc(sizeInBytes);
+    }
+    virtual SLANG_NO_THROW void SLANG_MCALL deallocate(void* ptr, size_t sizeInBytes)
+        SLANG_OVERRIDE
+    {
+        m_outstandingBytes -= sizeInBytes;
+        ::free(ptr);
+    }
+
+    void* getInterface(const Guid& guid)
+    {
+        if (guid == ISlangUnknown::getTypeGuid() || guid == ISlangAllocator::getTypeGuid())
+            return static_cast<ISlangAllocator*>(this);
+        return nullptr;
+    }
+
+    Index m_allocatedCount = 0;
+    size_t m_outstandingBytes = 0;
+};
+
+} // namespace
+
+// Test that the AST and IR memory of a session is allocated with the allocator in its SessionDesc
+
+SLANG_UNIT_TEST(sessionAllocator)
+{
+    const char* source = R"(
+        RWStructuredBuffer<float> outputBuffer;
+
+        [numthreads(1,1,1)]
+        void computeMain(uint3 tid : SV_DispatchThreadID)
+        {
+            outputBuffer[tid.x] = float(tid.x);
+        }
+        )";
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(
+        slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    ComPtr<CountingSlangAllocator> allocator(new CountingSlangAllocator);
+    {
+        slang::TargetDesc targetDesc = {};
+        targetDesc.format = SLANG_HLSL;
+        targetDesc.profile = globalSession->findProfile("sm_5_0");
+        slang::SessionDesc sessionDesc = {};
+        sessionDesc.targetCount = 1;
+        sessionDesc.targets = &targetDesc;
+        sessionDesc.allocator = allocator;
+
+        ComPtr<slang::ISession> session;
+        SLANG_CHECK_ABORT(
+            globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+        ComPtr<slang::IBlob> diagnosticBlob;
+        auto module =
+            session->loadModuleFromSourceString("m", "m.slang", source, diagnosticBlob.writeRef());
+        SLANG_CHECK_ABORT(module != nullptr);
+
+        SLANG_CHECK(allocator->m_allocatedCount > 0);
+        SLANG_CHECK(allocator->m_outstandingBytes > 0);
+    }
+
+    // Everything is returned once the session is destroyed
+    SLANG_CHECK(allocator->m_outstandingBytes == 0);
+}
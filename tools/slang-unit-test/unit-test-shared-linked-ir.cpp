@@ -0,0 +1,110 @@
+// unit-test-shared-linked-ir.cpp
+
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test generating code for each entry point of a program with `ShareLinkedIR`, where all
+// entry points are linked from IR that has been linked once for the whole program.
+
+static Index _countOccurrences(UnownedStringSlice text, const UnownedStringSlice& find)
+{
+    Index count = 0;
+    for (Index i = text.indexOf(find); i >= 0; i = text.indexOf(find))
+    {
+        text = text.tail(i + find.getLength());
+        count++;
+    }
+    return count;
+}
+
+SLANG_UNIT_TEST(sharedLinkedIR)
+{
+    const char* source = R"(
+        RWStructuredBuffer<int> outputBuffer;
+        RWStructuredBuffer<int> secondBuffer;
+
+        int scale(int value) { return value * 3; }
+
+        [shader("compute")]
+        [numthreads(1, 1, 1)]
+        void firstMain(uint3 tid : SV_DispatchThreadID)
+        {
+            outputBuffer[tid.x] = scale(int(tid.x)) + 1234;
+        }
+
+        [shader("compute")]
+        [numthreads(1, 1, 1)]
+        void secondMain(uint3 tid : SV_DispatchThreadID)
+        {
+            outputBuffer[tid.x] = scale(int(tid.x)) + 5678;
+            secondBuffer[tid.x] = 1;
+        })";
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(
+        slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+
+    slang::CompilerOptionEntry shareEntry;
+    shareEntry.name = slang::CompilerOptionName::ShareLinkedIR;
+    shareEntry.value.kind = slang::CompilerOptionValueKind::Int;
+    shareEntry.value.intValue0 = 1;
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.compilerOptionEntries = &shareEntry;
+    sessionDesc.compilerOptionEntryCount = 1;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> diagnostics;
+    ComPtr<slang::IModule> module(
+        session->loadModuleFromSourceString("m", "m.slang", source, diagnostics.writeRef()));
+    SLANG_CHECK_ABORT(module);
+
+    ComPtr<slang::IEntryPoint> firstEntryPoint;
+    ComPtr<slang::IEntryPoint> secondEntryPoint;
+    SLANG_CHECK_ABORT(
+        module->findEntryPointByName("firstMain", firstEntryPoint.writeRef()) == SLANG_OK);
+    SLANG_CHECK_ABORT(
+        module->findEntryPointByName("secondMain", secondEntryPoint.writeRef()) == SLANG_OK);
+
+    slang::IComponentType* components[] = {module, firstEntryPoint, secondEntryPoint};
+    ComPtr<slang::IComponentType> composite;
+    SLANG_CHECK_ABORT(
+        session->createCompositeComponentType(
+            components,
+            SLANG_COUNT_OF(components),
+            composite.writeRef(),
+            diagnostics.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IComponentType> linked;
+    SLANG_CHECK_ABORT(composite->link(linked.writeRef(), diagnostics.writeRef()) == SLANG_OK);
+
+    // Each entry point only gets its own code
+    const char* values[] = {"1234", "5678"};
+    for (int i = 0; i < 2; ++i)
+    {
+        ComPtr<slang::IBlob> code;
+        SLANG_CHECK_ABORT(
+            linked->getEntryPointCode(i, 0, code.writeRef(), diagnostics.writeRef()) == SLANG_OK);
+
+        const UnownedStringSlice text(
+            (const char*)code->getBufferPointer(),
+            code->getBufferSize());
+        SLANG_CHECK(text.indexOf(UnownedStringSlice(values[i])) >= 0);
+        SLANG_CHECK(text.indexOf(UnownedStringSlice(values[1 - i])) < 0);
+
+        // Global parameters keep the bindings from the program layout, and are only declared
+        // once, even though they are in both the shared IR and the IR module for the layout.
+        SLANG_CHECK(_countOccurrences(text, toSlice("register(u0)")) == 1);
+        SLANG_CHECK(_countOccurrences(text, toSlice("register(u1)")) == i);
+    }
+}
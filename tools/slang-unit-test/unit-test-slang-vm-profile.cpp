@@ -0,0 +1,113 @@
+// unit-test-slang-vm-profile.cpp
+
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test the execution profile collected by a byte code runner created with profiling enabled.
+
+SLANG_UNIT_TEST(slangVMProfile)
+{
+    const char* testSource = R"(
+        int one() { return 1; }
+        int sum(int x)
+        {
+            int result = 0;
+            for (int i = 0; i <= x; i++)
+            {
+                result += one();
+            }
+            return result;
+        }
+        [shader("dispatch")]
+        int dispatchMain(uniform int x)
+        {
+            return sum(x);
+        }
+    )";
+
+    ComPtr<slang::IBlob> code;
+    {
+        ComPtr<slang::IGlobalSession> globalSession;
+        SLANG_CHECK_ABORT(
+            slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+        slang::TargetDesc targetDesc = {};
+        targetDesc.format = SLANG_HOST_VM;
+        slang::SessionDesc sessionDesc = {};
+        sessionDesc.targetCount = 1;
+        sessionDesc.targets = &targetDesc;
+
+        ComPtr<slang::ISession> session;
+        SLANG_CHECK_ABORT(
+            globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+        ComPtr<slang::IBlob> diagnosticBlob;
+        auto module = session->loadModuleFromSourceString(
+            "test",
+            "test.slang",
+            testSource,
+            diagnosticBlob.writeRef());
+        SLANG_CHECK_ABORT(module != nullptr);
+
+        ComPtr<slang::IComponentType> linkedProgram;
+        SLANG_CHECK_ABORT(module->link(linkedProgram.writeRef()) == SLANG_OK);
+        linkedProgram->getTargetCode(0, code.writeRef(), diagnosticBlob.writeRef());
+        SLANG_CHECK_ABORT(code && code->getBufferSize() > 0);
+    }
+
+    // A runner without profiling has no profile to give
+    {
+        ComPtr<slang::IByteCodeRunner> runner;
+        slang::ByteCodeRunnerDesc runnerDesc = {};
+        SLANG_CHECK_ABORT(slang_createByteCodeRunner(&runnerDesc, runner.writeRef()) == SLANG_OK);
+        ComPtr<slang::IBlob> profileBlob;
+        SLANG_CHECK(
+            runner->getProfile(slang::ByteCodeProfileFormat::JSON, profileBlob.writeRef()) ==
+            SLANG_E_NOT_AVAILABLE);
+    }
+
+    ComPtr<slang::IByteCodeRunner> runner;
+    slang::ByteCodeRunnerDesc runnerDesc = {};
+    runnerDesc.enableProfiling = true;
+    SLANG_CHECK_ABORT(slang_createByteCodeRunner(&runnerDesc, runner.writeRef()) == SLANG_OK);
+    SLANG_CHECK_ABORT(runner->loadModule(code) == SLANG_OK);
+
+    const int funcIndex = runner->findFunctionByName("dispatchMain");
+    SLANG_CHECK_ABORT(funcIndex >= 0);
+    SLANG_CHECK_ABORT(runner->selectFunctionByIndex((uint32_t)funcIndex) == SLANG_OK);
+
+    int x = 9;
+    SLANG_CHECK_ABORT(runner->execute(&x, sizeof(x)) == SLANG_OK);
+    size_t returnValSize = 0;
+    int* returnVal = (int*)runner->getReturnValue(&returnValSize);
+    SLANG_CHECK(returnValSize == sizeof(int) && *returnVal == 10);
+
+    ComPtr<slang::IBlob> jsonBlob;
+    SLANG_CHECK_ABORT(
+        runner->getProfile(slang::ByteCodeProfileFormat::JSON, jsonBlob.writeRef()) == SLANG_OK);
+    const UnownedStringSlice json(
+        (const char*)jsonBlob->getBufferPointer(),
+        jsonBlob->getBufferSize());
+    SLANG_CHECK(json.indexOf(toSlice("\"opcodes\"")) >= 0);
+    SLANG_CHECK(json.indexOf(toSlice("\"name\": \"dispatchMain\"")) >= 0);
+    SLANG_CHECK(json.indexOf(toSlice("\"opcode\": \"ret\"")) >= 0);
+
+    // Each call stack that executed instructions has a line, outermost function first
+    ComPtr<slang::IBlob> stacksBlob;
+    SLANG_CHECK_ABORT(
+        runner->getProfile(slang::ByteCodeProfileFormat::CollapsedStacks, stacksBlob.writeRef()) ==
+        SLANG_OK);
+    const UnownedStringSlice stacks(
+        (const char*)stacksBlob->getBufferPointer(),
+        stacksBlob->getBufferSize());
+    SLANG_CHECK(stacks.startsWith(toSlice("dispatchMain")));
+
+    // After a reset, nothing has been executed
+    runner->resetProfile();
+    SLANG_CHECK_ABORT(
+        runner->getProfile(slang::ByteCodeProfileFormat::CollapsedStacks, stacksBlob.writeRef()) ==
+        SLANG_OK);
+    SLANG_CHECK(stacksBlob->getBufferSize() == 0);
+}
@@ -18,6 +18,11 @@ void printUsage()
     printf("Options:\n");
     printf("  -entry <name>   Specify the entry point function name to run. (default: main)\n");
     printf("  -disasm         Disassemble the bytecode after compilation.\n");
+    printf("  -profile <file> Profile execution and write the profile to <file>.\n");
+    printf("  -profile-format <json|collapsed>\n");
+    printf("                  Format of the profile: JSON counters per opcode, function\n");
+    printf("                  and instruction, or collapsed stacks for flame graphs.\n");
+    printf("                  (default: json)\n");
     printf("  -help           Show this help message\n");
 }
 
@@ -30,10 +35,27 @@ void maybePrintDiagnostic(const ComPtr<slang::IBlob>& diagnosticBlob)
     }
 }
 
+struct ProfileOptions
+{
+    String path;
+    ByteCodeProfileFormat format = ByteCodeProfileFormat::JSON;
+};
+
+SlangResult writeProfile(IByteCodeRunner* runner, const ProfileOptions& profileOptions)
+{
+    ComPtr<slang::IBlob> profileBlob;
+    SLANG_RETURN_ON_FAIL(runner->getProfile(profileOptions.format, profileBlob.writeRef()));
+    return File::writeAllBytes(
+        profileOptions.path,
+        profileBlob->getBufferPointer(),
+        profileBlob->getBufferSize());
+}
+
 SlangResult compileAndInterpret(
     UnownedStringSlice fileName,
     const char* entryPointName,
     bool disasm,
+    const ProfileOptions& profileOptions,
     int argc,
     const char* const* argv)
 {
@@ -120,6 +142,7 @@ SlangResult compileAndInterpret(
     // Create a byte code runner and interpret the code.
     ComPtr<slang::IByteCodeRunner> runner;
     slang::ByteCodeRunnerDesc runnerDesc = {};
+    runnerDesc.enableProfiling = profileOptions.path.getLength() != 0;
     SLANG_RETURN_ON_FAIL(slang_createByteCodeRunner(&runnerDesc, runner.writeRef()));
     if (SLANG_FAILED(runner->loadModule(code)))
     {
@@ -168,6 +191,11 @@ SlangResult compileAndInterpret(
         maybePrintDiagnostic(diagnosticBlob);
         return SLANG_FAIL;
     }
+    if (runnerDesc.enableProfiling && SLANG_FAILED(writeProfile(runner, profileOptions)))
+    {
+        fprintf(stderr, "Failed to write profile to '%s'\n", profileOptions.path.getBuffer());
+        return SLANG_FAIL;
+    }
     size_t returnValueSize = 0;
     void* returnVal = runner->getReturnValue(&returnValueSize);
     SlangResult result = SLANG_OK;
@@ -180,6 +208,7 @@ int main(int argc, const char* const* argv)
     String entryPointName = toSlice("main");
     UnownedStringSlice fileName;
     bool disasm = false;
+    ProfileOptions profileOptions;
     int innerArgIndex = 0;
     if (argc < 2)
     {
@@ -202,6 +231,28 @@ int main(int argc, const char* const* argv)
         {
             disasm = true;
         }
+        else if (arg == "-profile" && i + 1 < argc)
+        {
+            profileOptions.path = argv[++i];
+        }
+        else if (arg == "-profile-format" && i + 1 < argc)
+        {
+            auto format = UnownedStringSlice(argv[++i]);
+            if (format == "json")
+            {
+                profileOptions.format = ByteCodeProfileFormat::JSON;
+            }
+            else if (format == "collapsed")
+            {
+                profileOptions.format = ByteCodeProfileFormat::CollapsedStacks;
+            }
+            else
+            {
+                fprintf(stderr, "Unknown profile format: %s\n", format.begin());
+                printUsage();
+                return -1;
+            }
+        }
         else if (arg.startsWith("-"))
         {
             fprintf(stderr, "Unknown option: %s\n", arg.begin());
@@ -225,6 +276,7 @@ int main(int argc, const char* const* argv)
         fileName,
         entryPointName.getBuffer(),
         disasm,
+        profileOptions,
         argc - innerArgIndex,
         argv + innerArgIndex);
     slang::shutdown();